@@ -1,12 +1,16 @@
 /*************************************************
 USAGE:
 ./model_diagnostics -m <model file location>
+./model_diagnostics -m <model file location> --profile --input_shape=1,3,224,224 [--trace=<trace.json>]
 **************************************************/
 #include <opencv2/dnn.hpp>
 #include <opencv2/core/utils/filesystem.hpp>
 #include <opencv2/dnn/utils/debug_utils.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <sstream>
 
 
 using namespace cv;
@@ -35,7 +39,94 @@ static std::string checkFileExists(const std::string& fileName)
 std::string diagnosticKeys =
         "{ model m     | | Path to the model file. }"
         "{ config c    | | Path to the model configuration file. }"
-        "{ framework f | | [Optional] Name of the model framework. }";
+        "{ framework f | | [Optional] Name of the model framework. }"
+        "{ profile p   | | [Optional] Run the model with random input and print per-layer profile. }"
+        "{ input_shape | | Comma separated shape of the network input for profiling, e.g. 1,3,224,224. }"
+        "{ iterations  | 10 | Number of profiled forward passes. }"
+        "{ trace       | | [Optional] Path to output file with the profile in Chrome trace format. }";
+
+static MatShape parseShape(const std::string& str)
+{
+    MatShape shape;
+    std::stringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        shape.push_back(std::atoi(item.c_str()));
+    CV_Assert(!shape.empty());
+    return shape;
+}
+
+struct LayerSummary
+{
+    std::string name, type;
+    double timeMs = 0;
+    int64 flops = 0, bytes = 0;
+    int count = 0;
+};
+
+// Prints average per-layer numbers sorted by time. Layers with low FLOPs per byte of
+// inputs/outputs and low GFLOP/s are likely limited by memory bandwidth.
+static void printProfileSummary(const std::vector<LayerProfile>& profile, int iterations)
+{
+    std::map<int, LayerSummary> layers;
+    double totalMs = 0;
+    for (const LayerProfile& r : profile)
+    {
+        LayerSummary& l = layers[r.layerId];
+        l.name = r.name;
+        l.type = r.type;
+        l.timeMs += r.timeMs;
+        l.flops += r.flops;
+        l.bytes += r.inputBytes + r.outputBytes;
+        l.count++;
+        totalMs += r.timeMs;
+    }
+    std::vector<LayerSummary> sorted;
+    for (const auto& it : layers)
+        sorted.push_back(it.second);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const LayerSummary& a, const LayerSummary& b) { return a.timeMs > b.timeMs; });
+
+    std::cout << cv::format("%-32s %-20s %10s %7s %10s %10s %10s %10s\n",
+                            "Layer", "Type", "Time, ms", "%", "MFLOPs", "MBytes", "FLOP/byte", "GFLOP/s");
+    for (const LayerSummary& l : sorted)
+    {
+        double timeMs = l.timeMs / l.count;
+        double mflops = l.flops * 1e-6 / l.count;
+        double mbytes = l.bytes * 1e-6 / l.count;
+        std::cout << cv::format("%-32s %-20s %10.3f %7.2f %10.2f %10.2f %10.2f %10.2f\n",
+                                l.name.substr(0, 32).c_str(), l.type.substr(0, 20).c_str(), timeMs,
+                                totalMs > 0 ? 100. * l.timeMs / totalMs : 0., mflops, mbytes,
+                                mbytes > 0 ? mflops / mbytes : 0., timeMs > 0 ? mflops / timeMs * 1e-3 : 0.);
+    }
+    std::cout << cv::format("Total: %.3f ms per forward (%d iterations)\n", totalMs / iterations, iterations);
+}
+
+static void profileModel(Net& net, const MatShape& inputShape, int iterations, const std::string& tracePath)
+{
+    CV_Assert(iterations > 0);
+    Mat input(inputShape, CV_32F);
+    randu(input, 0, 1);
+
+    // warm up: allocate blobs and pack weights
+    net.setInput(input);
+    net.forward();
+
+    net.enableProfiling(true);
+    for (int i = 0; i < iterations; ++i)
+    {
+        net.setInput(input);
+        net.forward();
+    }
+    net.enableProfiling(false);
+
+    printProfileSummary(net.getProfile(), iterations);
+    if (!tracePath.empty())
+    {
+        net.dumpProfileToFile(tracePath);
+        std::cout << "Trace is saved to " << tracePath << std::endl;
+    }
+}
 
 
 
@@ -57,6 +148,15 @@ int main( int argc, const char** argv )
 
     CV_Assert(!model.empty());
 
+    if (argParser.has("profile"))
+    {
+        CV_Assert(argParser.has("input_shape"));
+        Net net = readNet(model, config, frameworkId);
+        profileModel(net, parseShape(argParser.get<std::string>("input_shape")),
+                     argParser.get<int>("iterations"), argParser.get<std::string>("trace"));
+        return 0;
+    }
+
     enableModelDiagnostics(true);
     skipModelImport(true);
     redirectError(diagnosticsErrorCallback, NULL);
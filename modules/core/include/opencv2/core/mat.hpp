@@ -2126,6 +2126,26 @@ public:
     MatAllocator* allocator;
     //! and the standard allocator
     static MatAllocator* getStdAllocator();
+    /** @brief NUMA-aware allocator
+
+    Buffers of `OPENCV_NUMA_ALLOCATOR_THRESHOLD` bytes (1Mb by default) and larger are interleaved over the NUMA
+    nodes or placed on the node of the first-touching thread (`OPENCV_NUMA_ALLOCATOR_POLICY`: "interleave"
+    or "local"). Other buffers are allocated by the standard allocator. It's the standard allocator on non-NUMA
+    systems. See also `OPENCV_THREAD_POOL_NUMA` to pin worker threads of the builtin thread pool to the nodes.
+    */
+    static MatAllocator* getNumaAllocator();
+    /** @brief Allocator which caches released buffers for reuse
+
+    Buffers of `OPENCV_CACHING_ALLOCATOR_MIN_SIZE` bytes (64Kb by default) and larger are rounded up to the size
+    class (16 classes per power of 2) and are not returned to the system on release: the next matrix of the same class
+    reuses the buffer, so there are no page faults on the new memory. The most recently released buffers are kept
+    per thread (`OPENCV_CACHING_ALLOCATOR_THREAD_BUFFERS`, 4 by default), others go to the global pool. The amount of
+    cached memory is limited by `OPENCV_CACHING_ALLOCATOR_MAX_RESERVED` (256Mb by default), the limit can be changed
+    through getBufferPoolController(). Statistics are provided by cv::utils::getCachingAllocatorStatistics().
+
+    Use `Mat::setDefaultAllocator(Mat::getCachingAllocator())` to use it for all the matrices of the process.
+    */
+    static MatAllocator* getCachingAllocator();
     static MatAllocator* getDefaultAllocator();
     static void setDefaultAllocator(MatAllocator* allocator);
 
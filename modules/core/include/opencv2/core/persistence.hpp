@@ -100,6 +100,8 @@ JSON.
 #include "opencv2/core/types.hpp"
 #include "opencv2/core/mat.hpp"
 
+#include <functional>
+
 namespace cv {
 
 /** @addtogroup core_xml
@@ -360,6 +362,34 @@ public:
      */
     CV_WRAP virtual bool open(const String& filename, int flags, const String& encoding=String());
 
+    /** @brief Reads the file incrementally, top-level node by top-level node.
+
+     Unlike open(), which builds the node tree of the whole file in memory, the method passes every
+     element of the top-level collection (of every stream, in the case of multi-stream YAML files) to
+     the callback as soon as it has been parsed, and releases it after the callback returns. So the
+     memory consumption is determined by the largest top-level node rather than by the file size.
+     Plain (not compressed) files are memory-mapped where it is supported.
+     The storage is released when the method returns.
+     @code
+        Mat frame(480, 640, CV_8UC3);  // preallocated, read() reuses the buffer if size and type match
+        fs.parse("frames.yml.gz", FileStorage::READ, [&](const FileNode& node) {
+            node >> frame;
+            process(frame);
+            return true;  // return false to stop reading
+        });
+     @endcode
+     @param filename Name of the file to read or the text string to read the data from (with
+     FileStorage::MEMORY flag).
+     @param flags Mode of operation. FileStorage::READ, optionally combined with FileStorage::MEMORY.
+     @param callback Called for each top-level node. The node (and the nodes it contains) can only be
+     accessed during the call. Return false to stop reading the rest of the file.
+     @param encoding Encoding of the file.
+     @returns true if the file has been opened and parsed (or the reading has been stopped by the
+     callback), false otherwise.
+     */
+    bool parse(const String& filename, int flags, const std::function<bool(const FileNode&)>& callback,
+               const String& encoding=String());
+
     /** @brief Checks whether the file is opened.
 
      @returns true if the object is associated with the current file and false otherwise. It is a
@@ -57,6 +57,7 @@
 #include <ostream>
 
 #include <functional>
+#include <typeinfo>
 
 #if !defined(_M_CEE)
 #include <mutex>  // std::mutex, std::lock_guard
@@ -582,6 +583,11 @@ public:
 
 /** @brief Parallel data processor
 
+If `OPENCV_PARALLEL_ADAPTIVE_GRAIN` configuration parameter is set and `nstripes` is not specified, the number
+of stripes is learned per loop body type and range size (power of 2): the default split, one and four stripes per
+thread and serial execution are measured, then the fastest one is used. The selected value is reported by the trace
+("adaptive.nstripes" argument of the parallel_for region).
+
 @ingroup core_parallel
 */
 CV_EXPORTS void parallel_for_(const Range& range, const ParallelLoopBody& body, double nstripes=-1.);
@@ -603,6 +609,12 @@ public:
     {
         m_functor(range);
     }
+
+    /// Type of the wrapped functor (identifies the lambda)
+    inline const std::type_info& getFunctorType() const
+    {
+        return m_functor.target_type();
+    }
 };
 
 //! @ingroup core_parallel
@@ -612,6 +624,61 @@ void parallel_for_(const Range& range, std::function<void(const Range&)> functor
     parallel_for_(range, ParallelLoopBodyLambdaWrapper(functor), nstripes);
 }
 
+/** @brief Dedicated group of worker threads for parallel regions
+
+By default all the threads of the application share the global thread pool, so parallel regions started
+concurrently by different threads compete for the same workers and cores. Parallel regions started by a thread
+attached to the partition (see ParallelPartitionScope) run on the workers of the partition only: at most
+getNumThreads() threads including the calling one. Workers of the partition are pinned to the given CPUs
+(Linux only), the calling thread is not pinned. Several partitions with disjoint sets of CPUs give
+independent pipelines predictable latency.
+
+Nested parallel regions are executed by the calling worker. Partitions are supported by the builtin
+`pthreads` framework, `OpenMP` limits the number of threads only, other frameworks ignore partitions.
+
+@ingroup core_parallel
+*/
+class CV_EXPORTS ParallelPartition
+{
+public:
+    virtual ~ParallelPartition();
+
+    /** @brief Number of threads which run parallel regions of the partition, including the calling thread */
+    virtual int getNumThreads() const = 0;
+
+    /** @brief CPUs the workers are pinned to, empty if the workers are not pinned */
+    virtual std::vector<int> getCPUs() const = 0;
+
+    /** @brief Creates the partition
+
+    Worker threads are started on the first parallel region.
+    @param numThreads number of threads including the calling one. If it's not positive, it's the number of
+    @p cpus or the default number of threads if @p cpus is empty.
+    @param cpus indices of CPUs the workers are pinned to.
+    */
+    static Ptr<ParallelPartition> create(int numThreads, const std::vector<int>& cpus = std::vector<int>());
+};
+
+/** @brief Attaches the calling thread to the partition till the end of the scope
+
+Scopes may be nested, the previous partition is restored by the destructor. Empty partition keeps the current one.
+
+@ingroup core_parallel
+*/
+class CV_EXPORTS ParallelPartitionScope
+{
+public:
+    explicit ParallelPartitionScope(const Ptr<ParallelPartition>& partition);
+    ~ParallelPartitionScope();
+
+private:
+    Ptr<ParallelPartition> previous_;
+    bool attached_;
+
+    ParallelPartitionScope(const ParallelPartitionScope&); // disabled
+    ParallelPartitionScope& operator=(const ParallelPartitionScope&); // disabled
+};
+
 
 /////////////////////////////// forEach method of cv::Mat ////////////////////////////
 template<typename _Tp, typename Functor> inline
@@ -24,6 +24,23 @@ public:
     virtual void resetPeakUsage() = 0;
 };
 
+/** @brief Statistics of the caching Mat allocator (see Mat::getCachingAllocator())
+
+Usage values are sizes of the buffers held by matrices, rounded up to the size class.
+Cached buffers are reported by BufferPoolController of the allocator.
+*/
+class CachingAllocatorStatisticsInterface : public AllocatorStatisticsInterface
+{
+protected:
+    CachingAllocatorStatisticsInterface() {}
+    virtual ~CachingAllocatorStatisticsInterface() {}
+public:
+    /** number of allocations served by cached buffers */
+    virtual uint64_t getNumberOfCacheHits() const = 0;
+};
+
+CV_EXPORTS CachingAllocatorStatisticsInterface& getCachingAllocatorStatistics();
+
 }} // namespace
 
 #endif // OPENCV_CORE_ALLOCATOR_STATS_HPP
@@ -0,0 +1,314 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/tls.hpp>
+#include "opencv2/core/utils/allocator_stats.impl.hpp"
+
+#include <map>
+
+namespace cv {
+
+namespace {
+
+class CachingMatAllocator;
+
+// 16 classes per power of 2: less than 6.25% of the buffer is wasted
+static size_t getSizeClass(size_t size)
+{
+    size_t step = 64;
+    while ((step << 4) <= size)
+        step <<= 1;
+    return (size + step - 1) & ~(step - 1);
+}
+
+struct CachedBuffer
+{
+    size_t size;  // size class
+    uchar* data;
+};
+
+// Buffers released by the thread, the most recently released buffers are at the back
+struct ThreadCache
+{
+    ThreadCache(const CachingMatAllocator& owner_);
+    ~ThreadCache();  // the buffers are moved to the global pool
+
+    const CachingMatAllocator& owner;
+    std::vector<CachedBuffer> buffers;
+    unsigned epoch;  // buffers are dropped if it doesn't match the allocator's one (freeAllReservedBuffers())
+};
+
+class ThreadCacheTLS : public TLSDataContainer
+{
+public:
+    ThreadCacheTLS(const CachingMatAllocator& owner_) : owner(owner_) {}
+    ~ThreadCacheTLS() { release(); }
+    ThreadCache& getRef() const { return *(ThreadCache*)getData(); }
+protected:
+    void* createDataInstance() const CV_OVERRIDE { return new ThreadCache(owner); }
+    void deleteDataInstance(void* pData) const CV_OVERRIDE { delete (ThreadCache*)pData; }
+private:
+    const CachingMatAllocator& owner;
+};
+
+class CachingAllocatorStatistics CV_FINAL : public utils::CachingAllocatorStatisticsInterface
+{
+public:
+    CachingAllocatorStatistics() : hits(0) {}
+
+    uint64_t getCurrentUsage() const CV_OVERRIDE { return stats.getCurrentUsage(); }
+    uint64_t getTotalUsage() const CV_OVERRIDE { return stats.getTotalUsage(); }
+    uint64_t getNumberOfAllocations() const CV_OVERRIDE { return stats.getNumberOfAllocations(); }
+    uint64_t getPeakUsage() const CV_OVERRIDE { return stats.getPeakUsage(); }
+    void resetPeakUsage() CV_OVERRIDE { stats.resetPeakUsage(); }
+    uint64_t getNumberOfCacheHits() const CV_OVERRIDE { return (uint64_t)hits.load(); }
+
+    void onAllocate(size_t sz, bool hit)
+    {
+        stats.onAllocate(sz);
+        if (hit)
+            hits++;
+    }
+    void onFree(size_t sz) { stats.onFree(sz); }
+
+private:
+    utils::AllocatorStatistics stats;
+    std::atomic<long long> hits;
+};
+
+static CachingAllocatorStatistics& getStatistics()
+{
+    CV_SINGLETON_LAZY_INIT_REF(CachingAllocatorStatistics, new CachingAllocatorStatistics())
+}
+
+class CachingMatAllocator CV_FINAL : public MatAllocator, public BufferPoolController
+{
+public:
+    CachingMatAllocator() :
+        minSize(utils::getConfigurationParameterSizeT("OPENCV_CACHING_ALLOCATOR_MIN_SIZE", 64 << 10)),
+        threadBuffers(utils::getConfigurationParameterSizeT("OPENCV_CACHING_ALLOCATOR_THREAD_BUFFERS", 4)),
+        maxReserved(utils::getConfigurationParameterSizeT("OPENCV_CACHING_ALLOCATOR_MAX_RESERVED", (size_t)256 << 20)),
+        reserved(0), epoch(0), tls(*this)
+    {
+    }
+
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        if (data0)
+            return Mat::getStdAllocator()->allocate(dims, sizes, type, data0, step, flags, usageFlags);
+
+        size_t total = CV_ELEM_SIZE(type);
+        for (int i = dims - 1; i >= 0; i--)
+        {
+            if (step)
+                step[i] = total;
+            total *= sizes[i];
+        }
+        if (total < minSize)
+            return Mat::getStdAllocator()->allocate(dims, sizes, type, data0, step, flags, usageFlags);
+
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = acquire(getSizeClass(total));
+        u->size = total;
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        if (!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        CV_Assert(!(u->flags & UMatData::USER_ALLOCATED));  // user data goes to the standard allocator
+        release(u->origdata, getSizeClass(u->size));
+        u->origdata = 0;
+        delete u;
+    }
+
+    BufferPoolController* getBufferPoolController(const char* /*id*/) const CV_OVERRIDE
+    {
+        return const_cast<CachingMatAllocator*>(this);
+    }
+
+    // BufferPoolController
+    size_t getReservedSize() const CV_OVERRIDE { return reserved.load(); }
+    size_t getMaxReservedSize() const CV_OVERRIDE { return maxReserved.load(); }
+    void setMaxReservedSize(size_t size) CV_OVERRIDE
+    {
+        maxReserved = size;
+        if (reserved.load() > size)
+            freeAllReservedBuffers();
+    }
+    // buffers of other threads are released on their next allocation/release
+    void freeAllReservedBuffers() CV_OVERRIDE
+    {
+        epoch++;
+        syncThreadCache(tls.getRef());
+        std::map<size_t, std::vector<uchar*> > buffers;
+        {
+            AutoLock lock(mutex);
+            std::swap(buffers, pool);
+        }
+        for (std::map<size_t, std::vector<uchar*> >::iterator it = buffers.begin(); it != buffers.end(); ++it)
+        {
+            for (size_t i = 0; i < it->second.size(); i++)
+                freeReserved(it->second[i], it->first);
+        }
+    }
+
+    // moves the cached buffer to the global pool
+    void moveToPool(uchar* data, size_t size) const
+    {
+        AutoLock lock(mutex);
+        pool[size].push_back(data);
+    }
+
+    void freeReserved(uchar* data, size_t size) const
+    {
+        reserved -= size;
+        fastFree(data);
+    }
+
+    unsigned getEpoch() const { return epoch.load(); }
+
+private:
+    uchar* acquire(size_t size) const
+    {
+        CachingAllocatorStatistics& stats = getStatistics();
+        ThreadCache& cache = tls.getRef();
+        syncThreadCache(cache);
+        for (size_t i = cache.buffers.size(); i > 0; i--)
+        {
+            if (cache.buffers[i - 1].size == size)
+            {
+                uchar* data = cache.buffers[i - 1].data;
+                cache.buffers.erase(cache.buffers.begin() + (i - 1));
+                reserved -= size;
+                stats.onAllocate(size, true);
+                return data;
+            }
+        }
+        {
+            AutoLock lock(mutex);
+            std::map<size_t, std::vector<uchar*> >::iterator it = pool.find(size);
+            if (it != pool.end() && !it->second.empty())
+            {
+                uchar* data = it->second.back();
+                it->second.pop_back();
+                reserved -= size;
+                stats.onAllocate(size, true);
+                return data;
+            }
+        }
+        uchar* data = (uchar*)fastMalloc(size);
+        stats.onAllocate(size, false);
+        return data;
+    }
+
+    void release(uchar* data, size_t size) const
+    {
+        getStatistics().onFree(size);
+        ThreadCache& cache = tls.getRef();
+        syncThreadCache(cache);
+        if (!reserve(size))
+        {
+            fastFree(data);
+            return;
+        }
+        if (threadBuffers == 0)
+        {
+            moveToPool(data, size);
+            return;
+        }
+        CachedBuffer buf = { size, data };
+        cache.buffers.push_back(buf);
+        if (cache.buffers.size() > threadBuffers)
+        {
+            // the least recently released buffer goes to the global pool
+            CachedBuffer old = cache.buffers.front();
+            cache.buffers.erase(cache.buffers.begin());
+            moveToPool(old.data, old.size);
+        }
+    }
+
+    // accounts the buffer as cached if the limit allows
+    bool reserve(size_t size) const
+    {
+        size_t prev = reserved.fetch_add(size);
+        if (prev + size > maxReserved.load())
+        {
+            reserved -= size;
+            return false;
+        }
+        return true;
+    }
+
+    void syncThreadCache(ThreadCache& cache) const
+    {
+        const unsigned current = epoch.load();
+        if (cache.epoch == current)
+            return;
+        for (size_t i = 0; i < cache.buffers.size(); i++)
+            freeReserved(cache.buffers[i].data, cache.buffers[i].size);
+        cache.buffers.clear();
+        cache.epoch = current;
+    }
+
+    const size_t minSize;
+    const size_t threadBuffers;
+    std::atomic<size_t> maxReserved;
+    mutable std::atomic<size_t> reserved;  // cached bytes (thread caches and the global pool)
+    std::atomic<unsigned> epoch;
+
+    mutable Mutex mutex;  // guards the pool
+    mutable std::map<size_t, std::vector<uchar*> > pool;  // size class => buffers
+
+    ThreadCacheTLS tls;
+};
+
+ThreadCache::ThreadCache(const CachingMatAllocator& owner_) :
+    owner(owner_), epoch(owner_.getEpoch())
+{
+}
+
+ThreadCache::~ThreadCache()
+{
+    const bool dropped = epoch != owner.getEpoch();
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        if (dropped)
+            owner.freeReserved(buffers[i].data, buffers[i].size);
+        else
+            owner.moveToPool(buffers[i].data, buffers[i].size);
+    }
+}
+
+} // namespace
+
+MatAllocator* Mat::getCachingAllocator()
+{
+    CV_SINGLETON_LAZY_INIT(MatAllocator, new CachingMatAllocator())
+}
+
+namespace utils {
+
+CachingAllocatorStatisticsInterface& getCachingAllocatorStatistics()
+{
+    return getStatistics();
+}
+
+} // namespace utils
+
+} // namespace cv
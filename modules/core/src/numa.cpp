@@ -0,0 +1,207 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "numa.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#ifdef OPENCV_HAVE_NUMA
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cv {
+
+namespace numa {
+
+#ifdef OPENCV_HAVE_NUMA
+
+// parses lists like "0-3,8,10-11"
+static std::vector<int> parseCPUList(const std::string& s)
+{
+    std::vector<int> cpus;
+    size_t pos = 0;
+    while (pos < s.size())
+    {
+        size_t end = s.find(',', pos);
+        if (end == std::string::npos)
+            end = s.size();
+        int first = -1, last = -1;
+        const std::string item = s.substr(pos, end - pos);
+        int n = sscanf(item.c_str(), "%d-%d", &first, &last);
+        if (n == 1)
+            last = first;
+        if (n >= 1 && first >= 0 && first <= last)
+        {
+            for (int cpu = first; cpu <= last; cpu++)
+                cpus.push_back(cpu);
+        }
+        pos = end + 1;
+    }
+    return cpus;
+}
+
+static std::vector<Node> readNodes()
+{
+    std::vector<Node> nodes;
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string list;
+    if (!(online >> list))
+        return nodes;
+    std::vector<int> ids = parseCPUList(list);  // the same format
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        std::ifstream f(cv::format("/sys/devices/system/node/node%d/cpulist", ids[i]).c_str());
+        std::string cpulist;
+        if (!(f >> cpulist))
+            continue;  // memory-only node
+        Node node;
+        node.id = ids[i];
+        node.cpus = parseCPUList(cpulist);
+        if (!node.cpus.empty())
+            nodes.push_back(node);
+    }
+    if (nodes.size() < 2)
+        nodes.clear();
+    for (size_t i = 0; i < nodes.size(); i++)
+        CV_LOG_INFO(NULL, "NUMA: node " << nodes[i].id << ": " << nodes[i].cpus.size() << " CPUs");
+    return nodes;
+}
+
+const std::vector<Node>& getNodes()
+{
+    static std::vector<Node> nodes = readNodes();
+    return nodes;
+}
+
+#else
+
+const std::vector<Node>& getNodes()
+{
+    static std::vector<Node> nodes;
+    return nodes;
+}
+
+#endif // OPENCV_HAVE_NUMA
+
+} // namespace numa
+
+#ifdef OPENCV_HAVE_NUMA
+
+// Large buffers are mapped separately and bound to the NUMA nodes:
+// - "interleave" policy spreads pages over all the nodes (default),
+// - "local" policy places each page on the node of the thread which touches it first.
+// Small buffers and non-NUMA systems use fastMalloc() as the standard allocator.
+class NumaMatAllocator CV_FINAL : public MatAllocator
+{
+public:
+    enum { MAPPED_BUFFER = 1 };  // UMatData::allocatorFlags_
+
+    // mbind() modes, see <numaif.h>
+    enum { MPOL_INTERLEAVE_ = 3, MPOL_LOCAL_ = 4 };
+
+    NumaMatAllocator() :
+        nodemask(0), maxnode(0)
+    {
+        const std::string policy = utils::getConfigurationParameterString("OPENCV_NUMA_ALLOCATOR_POLICY", "interleave");
+        if (policy == "local")
+            mode = MPOL_LOCAL_;
+        else
+        {
+            if (policy != "interleave")
+                CV_LOG_WARNING(NULL, "NUMA: unknown allocation policy '" << policy << "', 'interleave' is used");
+            mode = MPOL_INTERLEAVE_;
+        }
+        threshold = utils::getConfigurationParameterSizeT("OPENCV_NUMA_ALLOCATOR_THRESHOLD", 1 << 20);
+
+        const std::vector<numa::Node>& nodes = numa::getNodes();
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            const int id = nodes[i].id;
+            if (id >= (int)(sizeof(nodemask) * 8))
+                continue;
+            nodemask |= (unsigned long)1 << id;
+            maxnode = std::max(maxnode, (unsigned long)id + 2);
+        }
+        enabled = !nodes.empty();
+    }
+
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        if (!enabled || data0)
+            return stdAllocator()->allocate(dims, sizes, type, data0, step, flags, usageFlags);
+
+        size_t total = CV_ELEM_SIZE(type);
+        for (int i = dims - 1; i >= 0; i--)
+        {
+            if (step)
+                step[i] = total;
+            total *= sizes[i];
+        }
+        if (total < threshold)
+            return stdAllocator()->allocate(dims, sizes, type, data0, step, flags, usageFlags);
+
+        void* data = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data == MAP_FAILED)
+            CV_Error_(Error::StsNoMem, ("Failed to allocate %llu bytes", (unsigned long long)total));
+        // pages are not touched yet, so the policy is applied to all of them
+        if (syscall(SYS_mbind, data, total, mode, mode == MPOL_LOCAL_ ? NULL : &nodemask,
+                    mode == MPOL_LOCAL_ ? 0 : maxnode, 0) != 0)
+        {
+            CV_LOG_ONCE_WARNING(NULL, "NUMA: mbind() failed, memory placement is not controlled: errno = " << errno);
+        }
+
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = (uchar*)data;
+        u->size = total;
+        u->allocatorFlags_ = MAPPED_BUFFER;
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        if (!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        CV_Assert(u->allocatorFlags_ & MAPPED_BUFFER);  // small buffers are owned by the standard allocator
+        munmap(u->origdata, u->size);
+        u->origdata = 0;
+        delete u;
+    }
+
+private:
+    static MatAllocator* stdAllocator() { return Mat::getStdAllocator(); }
+
+    bool enabled;
+    int mode;
+    size_t threshold;
+    unsigned long nodemask;
+    unsigned long maxnode;
+};
+
+#endif // OPENCV_HAVE_NUMA
+
+MatAllocator* Mat::getNumaAllocator()
+{
+#ifdef OPENCV_HAVE_NUMA
+    CV_SINGLETON_LAZY_INIT(MatAllocator, new NumaMatAllocator())
+#else
+    return Mat::getStdAllocator();
+#endif
+}
+
+} // namespace cv
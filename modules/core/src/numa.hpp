@@ -0,0 +1,26 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#ifndef OPENCV_CORE_NUMA_HPP
+#define OPENCV_CORE_NUMA_HPP
+
+#if defined __linux__ && !defined __ANDROID__ && !defined __EMSCRIPTEN__
+#define OPENCV_HAVE_NUMA 1
+#endif
+
+namespace cv { namespace numa {
+
+struct Node
+{
+    int id;                 // system index of the node
+    std::vector<int> cpus;  // online CPUs of the node
+};
+
+/** Returns the NUMA nodes with online CPUs.
+ * It's empty if the system is not NUMA (a single node) or the topology is not available.
+ */
+const std::vector<Node>& getNodes();
+
+}} // namespace cv::numa
+
+#endif // OPENCV_CORE_NUMA_HPP
@@ -43,10 +43,12 @@
 #include "precomp.hpp"
 
 #include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
 #include <opencv2/core/utils/trace.private.hpp>
 
 #include "opencv2/core/parallel/parallel_backend.hpp"
 #include "parallel/parallel.hpp"
+#include "parallel/grain_model.hpp"
 
 #if defined _WIN32 || defined WINCE
     #include <windows.h>
@@ -145,6 +147,7 @@
 #  define CV_PARALLEL_FRAMEWORK "ms-concurrency"
 #elif defined HAVE_PTHREADS_PF
 #  define CV_PARALLEL_FRAMEWORK "pthreads"
+#  define CV_PARALLEL_FRAMEWORK_NESTED_REGIONS 1  // the builtin pool schedules nested and concurrent regions itself
 #endif
 
 #include <atomic>
@@ -492,9 +495,25 @@ static SchedPtr pplScheduler;
 
 } // namespace anon
 
+/* ================================   adaptive grain size   ================================ */
+
+static bool isParallelAdaptiveGrainEnabled()
+{
+    static bool enabled = utils::getConfigurationParameterBool("OPENCV_PARALLEL_ADAPTIVE_GRAIN", false);
+    return enabled;
+}
+
+static parallel::GrainModel& getParallelGrainModel()
+{
+    CV_SINGLETON_LAZY_INIT_REF(parallel::GrainModel, new parallel::GrainModel())
+}
+
+
 /* ================================   parallel_for_  ================================ */
 
 static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes); // forward declaration
+static bool parallel_for_partition(const ParallelPartition& partition, const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes); // forward declaration
+static void parallel_for_global(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes); // forward declaration
 
 void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
 {
@@ -509,6 +528,67 @@ void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, dou
     if (range.empty())
         return;
 
+    // partitions don't share the global nesting flag: concurrent regions of different partitions run in parallel
+    CoreTLSData& tls = getCoreTlsData();
+    if (tls.parallelPartitionRegion)
+    {
+        body(range);
+        return;
+    }
+    if (tls.parallelPartition)
+    {
+        tls.parallelPartitionRegion = true;
+        bool done = false;
+        try
+        {
+            done = parallel_for_partition(*tls.parallelPartition, range, body, nstripes);
+            tls.parallelPartitionRegion = false;
+        }
+        catch (...)
+        {
+            tls.parallelPartitionRegion = false;
+            throw;
+        }
+        if (done)
+            return;
+    }
+
+    // nstripes specified by the caller is respected
+    if (nstripes <= 0 && isParallelAdaptiveGrainEnabled())
+    {
+        const int threads = getNumThreads();
+        if (threads > 1)
+        {
+            parallel::GrainModel& model = getParallelGrainModel();
+            parallel::GrainModel::Key key(parallel::GrainModel::bodyType(body), range, threads);
+            double selected_nstripes = nstripes;
+            int candidate = model.select(key, selected_nstripes);
+#ifdef OPENCV_TRACE
+            CV_TRACE_ARG_VALUE(adaptive_nstripes, "adaptive.nstripes", (int64)(candidate == 0 ? 1 : selected_nstripes));
+#endif
+            int64 start = getTickCount();
+            if (candidate == 0)
+                body(range);
+            else
+                parallel_for_global(range, body, selected_nstripes);
+            model.update(key, candidate, getTickCount() - start, range.size());
+            return;
+        }
+    }
+
+    parallel_for_global(range, body, nstripes);
+}
+
+static void parallel_for_global(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
+{
+#ifdef CV_PARALLEL_FRAMEWORK_NESTED_REGIONS
+    if (!getCurrentParallelForAPI())
+    {
+        parallel_for_impl(range, body, nstripes);
+        return;
+    }
+#endif
+
     static std::atomic<bool> flagNestedParallelFor(false);
     bool isNotNestedRegion = !flagNestedParallelFor.load();
     if (isNotNestedRegion)
@@ -623,8 +703,120 @@ static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody
 }
 
 
+
+namespace {
+
+class ParallelPartitionImpl CV_FINAL : public ParallelPartition
+{
+public:
+    ParallelPartitionImpl(int numThreads_, const std::vector<int>& cpus_) :
+        numThreads(numThreads_), cpus(cpus_)
+#ifdef HAVE_PTHREADS_PF
+        , pool(NULL)
+#endif
+    {
+#ifdef HAVE_PTHREADS_PF
+        pool = parallel_pthreads_create_pool((unsigned)numThreads, cpus);
+#endif
+    }
+
+    ~ParallelPartitionImpl()
+    {
+#ifdef HAVE_PTHREADS_PF
+        parallel_pthreads_release_pool(pool);
+#endif
+    }
+
+    int getNumThreads() const CV_OVERRIDE { return numThreads; }
+    std::vector<int> getCPUs() const CV_OVERRIDE { return cpus; }
+
+    const int numThreads;
+    const std::vector<int> cpus;
+#ifdef HAVE_PTHREADS_PF
+    ThreadPool* pool;
+#endif
+};
+
+}  // namespace
+
+ParallelPartition::~ParallelPartition()
+{
+    // nothing
+}
+
+Ptr<ParallelPartition> ParallelPartition::create(int numThreads, const std::vector<int>& cpus)
+{
+    for (size_t i = 0; i < cpus.size(); ++i)
+    {
+        CV_CheckGE(cpus[i], 0, "CPU index must be non-negative");
+#ifdef OPENCV_HAVE_THREAD_AFFINITY
+        CV_CheckLT(cpus[i], (int)CPU_SETSIZE, "CPU index is out of range");
+#endif
+    }
+    if (numThreads <= 0)
+        numThreads = !cpus.empty() ? (int)cpus.size() : (int)defaultNumberOfThreads();
+    return makePtr<ParallelPartitionImpl>(numThreads, cpus);
+}
+
+ParallelPartitionScope::ParallelPartitionScope(const Ptr<ParallelPartition>& partition) :
+    attached_(!partition.empty())
+{
+    if (attached_)
+    {
+        CoreTLSData& tls = getCoreTlsData();
+        previous_ = tls.parallelPartition;
+        tls.parallelPartition = partition;
+    }
+}
+
+ParallelPartitionScope::~ParallelPartitionScope()
+{
+    if (attached_)
+        getCoreTlsData().parallelPartition = previous_;
+}
+
+// Returns false if the partition is not supported by the parallel framework
+static bool parallel_for_partition(const ParallelPartition& partition_, const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
+{
+    const ParallelPartitionImpl& partition = static_cast<const ParallelPartitionImpl&>(partition_);
+    if (getCurrentParallelForAPI())
+        return false;  // custom backends have their own pools
+#if defined HAVE_TBB || defined HAVE_HPX
+    CV_UNUSED(partition); CV_UNUSED(range); CV_UNUSED(body); CV_UNUSED(nstripes);
+    return false;
+#elif defined HAVE_OPENMP || (defined HAVE_PTHREADS_PF && !defined HAVE_GCD && !defined WINRT && !defined HAVE_CONCURRENCY)
+    if (partition.numThreads > 1 && range.end - range.start > 1)
+    {
+        ParallelLoopBodyWrapperContext ctx(body, range, nstripes);
+        ParallelLoopBodyWrapper pbody(ctx);
+        cv::Range stripeRange = pbody.stripeRange();
+        if (stripeRange.end - stripeRange.start > 1)
+        {
+#if defined HAVE_OPENMP
+            #pragma omp parallel for schedule(dynamic) num_threads(partition.numThreads)
+            for (int i = stripeRange.start; i < stripeRange.end; ++i)
+                pbody(Range(i, i + 1));
+#else
+            parallel_for_pthreads(*partition.pool, stripeRange, pbody, stripeRange.size());
+#endif
+            ctx.finalize();  // propagate exceptions if exists
+            return true;
+        }
+    }
+    body(range);
+    return true;
+#else
+    CV_UNUSED(partition); CV_UNUSED(range); CV_UNUSED(body); CV_UNUSED(nstripes);
+    return false;
+#endif
+}
+
 int getNumThreads(void)
 {
+    const Ptr<ParallelPartition>& partition = getCoreTlsData().parallelPartition;
+    if (partition)
+        return partition->getNumThreads();
+
     std::shared_ptr<ParallelForAPI>& api = getCurrentParallelForAPI();
     if (api)
     {
@@ -0,0 +1,183 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#ifndef OPENCV_CORE_SRC_PARALLEL_GRAIN_MODEL_HPP
+#define OPENCV_CORE_SRC_PARALLEL_GRAIN_MODEL_HPP
+
+#include <opencv2/core/utility.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#include <map>
+#include <typeindex>
+
+namespace cv { namespace parallel {
+
+// Learns the cheapest number of stripes for parallel_for_() calls with the same loop body type
+// and similar range size (power of 2), including serial execution for small ranges.
+// Candidates are measured in turns, then the best one is used. The following (normal) runs are
+// still measured: if their cost drifts away from the learned one, the parallel candidates are
+// measured again (serial execution only if it is the current choice, so the loops which have
+// been parallel don't get serial runs in the middle of the processing).
+class GrainModel
+{
+public:
+    enum
+    {
+        CANDIDATES = 4,     // serial, default stripes, 1 and 4 stripes per thread
+        SAMPLES = 3,        // measurements of each candidate
+        DRIFT_SAMPLES = 16  // normal runs before the drift is checked
+    };
+
+    struct Key
+    {
+        Key(const std::type_info& type_, const Range& range, int threads_)
+            : type(type_), rangeLog2(0), threads(threads_)
+        {
+            for (int n = range.size(); n > 1; n >>= 1)
+                rangeLog2++;
+        }
+
+        bool operator<(const Key& other) const
+        {
+            if (type != other.type)
+                return type < other.type;
+            if (rangeLog2 != other.rangeLog2)
+                return rangeLog2 < other.rangeLog2;
+            return threads < other.threads;
+        }
+
+        std::type_index type;
+        int rangeLog2;
+        int threads;
+    };
+
+    // Lambdas share the wrapper type, the functor type identifies the call site
+    static const std::type_info& bodyType(const ParallelLoopBody& body)
+    {
+        const ParallelLoopBodyLambdaWrapper* lambda = dynamic_cast<const ParallelLoopBodyLambdaWrapper*>(&body);
+        return lambda ? lambda->getFunctorType() : typeid(body);
+    }
+
+    // Returns the candidate to use: 0 means serial execution, otherwise nstripes is updated
+    int select(const Key& key, double& nstripes)
+    {
+        int candidate;
+        {
+            cv::AutoLock lock(mutex);
+            Entry& e = entries[key];
+            candidate = e.best;
+            for (int k = 0; candidate < 0 && k < CANDIDATES; k++)
+            {
+                const int c = (e.calls + k) % CANDIDATES;
+                if (e.isMeasured(c) && e.samples[c] < SAMPLES)
+                    candidate = c;
+            }
+            if (candidate < 0)
+                candidate = e.last_best >= 0 ? e.last_best : 1;  // all the samples are in flight
+            e.calls++;
+        }
+        switch (candidate)
+        {
+        case 2: nstripes = key.threads; break;
+        case 3: nstripes = key.threads * 4; break;
+        default: break;  // serial or the default value
+        }
+        return candidate;
+    }
+
+    void update(const Key& key, int candidate, int64 ticks, int rangeSize)
+    {
+        cv::AutoLock lock(mutex);
+        Entry& e = entries[key];
+        const double cost = (double)ticks / rangeSize;
+        if (e.best >= 0)
+        {
+            if (candidate != e.best)
+                return;  // selected before the end of the learning
+            // exponential moving average of the normal runs
+            e.recent = e.normal_runs == 0 ? cost : e.recent + (cost - e.recent) / DRIFT_SAMPLES;
+            if (++e.normal_runs >= DRIFT_SAMPLES && (e.recent > e.learned * 2 || e.recent * 2 < e.learned))
+            {
+                CV_LOG_INFO(NULL, "parallel_for_: " << key.type.name() << " range=2^" << key.rangeLog2
+                        << " threads=" << key.threads << ": cost has changed, measuring the candidates again");
+                e.relearn();
+            }
+            return;
+        }
+        if (!e.isMeasured(candidate))
+            return;
+        e.ticks[candidate] += cost;
+        e.samples[candidate]++;
+        int best = -1;
+        for (int i = 0; i < CANDIDATES; i++)
+        {
+            if (!e.isMeasured(i))
+                continue;
+            if (e.samples[i] < SAMPLES)
+                return;
+            if (best < 0 || e.ticks[i] / e.samples[i] < e.ticks[best] / e.samples[best])
+                best = i;
+        }
+        e.best = e.last_best = best;
+        e.learned = e.ticks[best] / e.samples[best];
+        e.normal_runs = 0;
+        CV_LOG_INFO(NULL, "parallel_for_: " << key.type.name() << " range=2^" << key.rangeLog2
+                << " threads=" << key.threads << ": selected candidate " << best
+                << (best == 0 ? " (serial)" : "") << ", "
+                << e.learned * 1e9 / getTickFrequency() << " ns per item");
+    }
+
+    // -1 while the candidates are measured
+    int getSelected(const Key& key)
+    {
+        cv::AutoLock lock(mutex);
+        std::map<Key, Entry>::const_iterator it = entries.find(key);
+        return it != entries.end() ? it->second.best : -1;
+    }
+
+private:
+    struct Entry
+    {
+        Entry() : calls(0), best(-1), last_best(-1), learned(0), recent(0), normal_runs(0)
+        {
+            for (int i = 0; i < CANDIDATES; i++)
+            {
+                ticks[i] = 0;
+                samples[i] = 0;
+            }
+        }
+
+        // serial execution is measured at the first learning, then only if it has been selected
+        bool isMeasured(int candidate) const
+        {
+            return candidate != 0 || last_best <= 0;
+        }
+
+        void relearn()
+        {
+            for (int i = 0; i < CANDIDATES; i++)
+            {
+                ticks[i] = 0;
+                samples[i] = 0;
+            }
+            best = -1;
+            normal_runs = 0;
+        }
+
+        double ticks[CANDIDATES];  // per range item
+        int samples[CANDIDATES];
+        int calls;
+        int best;
+        int last_best;
+        double learned;  // cost of the selected candidate (per range item)
+        double recent;   // cost of the normal runs
+        int normal_runs;
+    };
+
+    cv::Mutex mutex;
+    std::map<Key, Entry> entries;
+};
+
+}} // namespace
+
+#endif // OPENCV_CORE_SRC_PARALLEL_GRAIN_MODEL_HPP
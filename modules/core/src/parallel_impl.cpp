@@ -5,6 +5,7 @@
 #include "precomp.hpp"
 
 #include "parallel_impl.hpp"
+#include "numa.hpp"
 
 #ifdef HAVE_PTHREADS_PF
 #include <pthread.h>
@@ -21,9 +22,8 @@
 //#define CV_PROFILE_THREADS 64
 //#define getTickCount getCPUTickCount  // use this if getTickCount() calls are expensive (and getCPUTickCount() is accurate)
 
-//#define CV_USE_GLOBAL_WORKERS_COND_VAR  // not effective on many-core systems (10+)
-
 #include <atomic>
+#include <deque>
 
 // Spin lock's OS-level yield
 #ifdef DECLARE_CV_YIELD
@@ -74,12 +74,89 @@ namespace cv
 static int CV_ACTIVE_WAIT_PAUSE_LIMIT = (int)utils::getConfigurationParameterSizeT("OPENCV_THREAD_POOL_ACTIVE_WAIT_PAUSE_LIMIT", 16);  // iterations
 static int CV_WORKER_ACTIVE_WAIT = (int)utils::getConfigurationParameterSizeT("OPENCV_THREAD_POOL_ACTIVE_WAIT_WORKER", 2000);  // iterations
 static int CV_MAIN_THREAD_ACTIVE_WAIT = (int)utils::getConfigurationParameterSizeT("OPENCV_THREAD_POOL_ACTIVE_WAIT_MAIN", 10000); // iterations
-
 static int CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT = (int)utils::getConfigurationParameterSizeT("OPENCV_THREAD_POOL_ACTIVE_WAIT_THREADS_LIMIT", 0); // number of real cores
 
+static bool CV_THREAD_POOL_NUMA = utils::getConfigurationParameterBool("OPENCV_THREAD_POOL_NUMA", false);  // pin workers to NUMA nodes
+
+static inline void activeWaitPause(int i)
+{
+    if (CV_ACTIVE_WAIT_PAUSE_LIMIT > 0 && (i < CV_ACTIVE_WAIT_PAUSE_LIMIT || (i & 1)))
+        CV_PAUSE(16);
+    else
+        CV_YIELD();
+}
+
 class WorkerThread;
 class ParallelJob;
 
+// Part of the parallel job: range of stripes which is not started yet
+struct ParallelTask
+{
+    ParallelTask() : job(NULL) {}
+    ParallelTask(ParallelJob* job_, const Range& range_) : job(job_), range(range_) {}
+
+    ParallelJob* job;
+    Range range;
+};
+
+// Tasks of one thread. The owner pushes and pops tasks at the back (the smallest
+// and the most recently split parts of its range), other threads steal from the front.
+class TaskDeque
+{
+public:
+    TaskDeque() : size(0)
+    {
+        int res = pthread_mutex_init(&mutex, NULL);
+        if (res != 0)
+            CV_LOG_FATAL(NULL, "Can't create task queue mutex: res = " << res);
+    }
+    ~TaskDeque()
+    {
+        pthread_mutex_destroy(&mutex);
+    }
+
+    void push(const ParallelTask& task)
+    {
+        pthread_mutex_lock(&mutex);
+        tasks.push_back(task);
+        size.store(tasks.size(), std::memory_order_release);
+        pthread_mutex_unlock(&mutex);
+    }
+
+    // Takes the task from the back (from the front if steal == true).
+    // If job is not NULL then only tasks of this job are considered.
+    bool take(ParallelTask& task, const ParallelJob* job, bool steal)
+    {
+        if (empty())
+            return false;
+        bool found = false;
+        pthread_mutex_lock(&mutex);
+        const size_t n = tasks.size();
+        for (size_t k = 0; k < n; k++)
+        {
+            const size_t i = steal ? k : n - 1 - k;
+            if (job == NULL || tasks[i].job == job)
+            {
+                task = tasks[i];
+                tasks.erase(tasks.begin() + i);
+                found = true;
+                break;
+            }
+        }
+        size.store(tasks.size(), std::memory_order_release);
+        pthread_mutex_unlock(&mutex);
+        return found;
+    }
+
+    // quick check without locking, result may be outdated
+    bool empty() const { return size.load(std::memory_order_acquire) == 0; }
+
+private:
+    pthread_mutex_t mutex;
+    std::deque<ParallelTask> tasks;
+    std::atomic<size_t> size;
+};
+
 class ThreadPool
 {
 public:
@@ -96,10 +173,9 @@ public:
 
     void reconfigure(unsigned new_threads_count)
     {
-        if (new_threads_count == threads.size())
-            return;
         pthread_mutex_lock(&mutex);
-        reconfigure_(new_threads_count);
+        if (active_runs == 0)
+            reconfigure_(new_threads_count);
         pthread_mutex_unlock(&mutex);
     }
     bool reconfigure_(unsigned new_threads_count); // internal implementation
@@ -112,23 +188,54 @@ public:
 
     ThreadPool();
 
+    // pool of a partition
+    ThreadPool(unsigned num_threads_, const std::vector<int>& cpus_);
+
     ~ThreadPool();
 
+    void init();
+
+    // Executes the task, the upper half of the remaining range is moved to the deque
+    // if there are threads looking for work and the previous part has been taken already.
+    // Returns the number of executed stripes.
+    int execute(const ParallelTask& task, TaskDeque& deque);
+
+    // Own deque first, then the deque of external threads, then steal from other workers (of the same node first)
+    bool findTask(ParallelTask& task, TaskDeque& deque, unsigned seed, int node, const ParallelJob* job);
+    bool hasTasks() const;
+
+    // Helps with the tasks of the job, then waits until other threads complete the rest
+    void wait(ParallelJob& job, TaskDeque& deque, unsigned seed, int node);
+
+    void push(TaskDeque& deque, const ParallelTask& task);
+    void wake(bool all);
+
     unsigned num_threads;
 
-    pthread_mutex_t mutex;  // guards fields (job/threads) from non-worker threads (concurrent parallel_for calls)
-#if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-    pthread_cond_t cond_thread_wake;
-#endif
+    const bool is_partition;
+    const std::vector<int> cpus;  // workers of partition are pinned to these CPUs (if not empty)
 
-    pthread_mutex_t mutex_notify;
-    pthread_cond_t cond_thread_task_complete;
+    pthread_mutex_t mutex;  // guards threads/active_runs from non-worker threads (concurrent parallel_for calls)
+    int active_runs;  // parallel regions started by non-worker threads, workers are not reconfigured while they run
 
     std::vector< Ptr<WorkerThread> > threads;
 
-    Ptr<ParallelJob> job;
+    int numa_nodes;  // nodes the workers are pinned to (OPENCV_THREAD_POOL_NUMA), 0 if workers are not pinned
+    std::vector<int> node_worker;  // first worker of each node
+
+    TaskDeque external_tasks;  // tasks split by non-worker threads
+
+    std::atomic<unsigned> idle_threads;  // workers which are looking for a task
+
+    // sleeping workers are woken up on each new task
+    pthread_mutex_t mutex_wake;
+    pthread_cond_t cond_wake;
+    std::atomic<unsigned> sleeping_threads;
+    std::atomic<unsigned> wake_epoch;
 
 #ifdef CV_PROFILE_THREADS
+    // Workers take tasks of all active regions, so the statistics are meaningful
+    // when there is a single parallel region at a time
     double tickFreq;
     int64 jobSubmitTime;
     struct ThreadStatistics
@@ -187,7 +294,6 @@ public:
     };
     ThreadStatistics threads_stat[CV_PROFILE_THREADS]; // 0 - main thread, 1..N - worker threads
 #endif
-
 };
 
 class WorkerThread
@@ -200,15 +306,9 @@ public:
 
     std::atomic<bool> stop_thread;
 
-    std::atomic<bool> has_wake_signal;
-
-    Ptr<ParallelJob> job;
+    TaskDeque tasks;
 
-    pthread_mutex_t mutex;
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-    volatile bool isActive;
-    pthread_cond_t cond_thread_wake;
-#endif
+    int node;  // index in numa::getNodes() the worker is pinned to, -1 if it's not pinned
 
     WorkerThread(ThreadPool& thread_pool_, unsigned id_) :
         thread_pool(thread_pool_),
@@ -216,27 +316,15 @@ public:
         posix_thread(0),
         is_created(false),
         stop_thread(false),
-        has_wake_signal(false)
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-        , isActive(true)
-#endif
+        node(-1)
     {
         CV_LOG_VERBOSE(NULL, 1, "MainThread: initializing new worker: " << id);
-        int res = pthread_mutex_init(&mutex, NULL);
-        if (res != 0)
-        {
-            CV_LOG_ERROR(NULL, id << ": Can't create thread mutex: res = " << res);
-            return;
-        }
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-        res = pthread_cond_init(&cond_thread_wake, NULL);
-        if (res != 0)
-        {
-            CV_LOG_ERROR(NULL, id << ": Can't create thread condition variable: res = " << res);
-            return;
-        }
-#endif
-        res = pthread_create(&posix_thread, NULL, thread_loop_wrapper, (void*)this);
+    }
+
+    // threads are started when all workers of the pool are created, they steal tasks from each other
+    void start()
+    {
+        int res = pthread_create(&posix_thread, NULL, thread_loop_wrapper, (void*)this);
         if (res != 0)
         {
             CV_LOG_ERROR(NULL, id << ": Can't spawn new thread: res = " << res);
@@ -247,30 +335,24 @@ public:
         }
     }
 
-    ~WorkerThread()
+    void join()
     {
-        CV_LOG_VERBOSE(NULL, 1, "MainThread: destroy worker thread: " << id);
         if (is_created)
         {
-            if (!stop_thread)
-            {
-                pthread_mutex_lock(&mutex);  // to avoid signal miss due pre-check
-                stop_thread = true;
-                pthread_mutex_unlock(&mutex);
-#if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-                pthread_cond_broadcast(&thread_pool.cond_thread_wake);
-#else
-                pthread_cond_signal(&cond_thread_wake);
-#endif
-            }
+            CV_DbgAssert(stop_thread);
             pthread_join(posix_thread, NULL);
+            is_created = false;
         }
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-        pthread_cond_destroy(&cond_thread_wake);
-#endif
-        pthread_mutex_destroy(&mutex);
     }
 
+    ~WorkerThread()
+    {
+        CV_LOG_VERBOSE(NULL, 1, "MainThread: destroy worker thread: " << id);
+        join();
+    }
+
+    static WorkerThread* current();
+
     void thread_body();
     static void* thread_loop_wrapper(void* thread_object)
     {
@@ -282,219 +364,213 @@ public:
     }
 };
 
+static pthread_key_t g_workerKey;
+static pthread_once_t g_workerKeyOnce = PTHREAD_ONCE_INIT;
+
+static void createWorkerKey()
+{
+    int res = pthread_key_create(&g_workerKey, NULL);
+    if (res != 0)
+        CV_LOG_FATAL(NULL, "Can't create TLS key for worker threads: res = " << res);
+}
+
+WorkerThread* WorkerThread::current()
+{
+    pthread_once(&g_workerKeyOnce, createWorkerKey);
+    return (WorkerThread*)pthread_getspecific(g_workerKey);
+}
+
 class ParallelJob
 {
 public:
-    ParallelJob(const ThreadPool& thread_pool_, const Range& range_, const ParallelLoopBody& body_, int nstripes_) :
-        thread_pool(thread_pool_),
+    ParallelJob(const ParallelLoopBody& body_, const Range& range_) :
         body(body_),
-        range(range_),
-        nstripes((unsigned)nstripes_),
-        is_completed(false)
+        remaining(range_.size()),
+        is_completed(false),
+        is_completed_flag(false)
     {
         CV_LOG_VERBOSE(NULL, 5, "ParallelJob::ParallelJob(" << (void*)this << ")");
-        current_task.store(0, std::memory_order_relaxed);
-        active_thread_count.store(0, std::memory_order_relaxed);
-        completed_thread_count.store(0, std::memory_order_relaxed);
-        dummy0_[0] = 0, dummy1_[0] = 0, dummy2_[0] = 0; // compiler warning
+        int res = 0;
+        res |= pthread_mutex_init(&mutex, NULL);
+        res |= pthread_cond_init(&cond_complete, NULL);
+        if (res != 0)
+            CV_LOG_FATAL(NULL, "Can't initialize parallel job");
     }
 
     ~ParallelJob()
     {
         CV_LOG_VERBOSE(NULL, 5, "ParallelJob::~ParallelJob(" << (void*)this << ")");
+        pthread_cond_destroy(&cond_complete);
+        pthread_mutex_destroy(&mutex);
     }
 
-    unsigned execute(bool is_worker_thread)
+    // the thread which completes the last stripes notifies the owner of the job
+    void complete(int stripes)
     {
-        unsigned executed_tasks = 0;
-        const int task_count = range.size();
-        const int remaining_multiplier = std::min(nstripes,
-                std::max(
-                        std::min(100u, thread_pool.num_threads * 4),
-                        thread_pool.num_threads * 2
-                ));  // experimental value
-        for (;;)
+        if (remaining.fetch_sub(stripes, std::memory_order_acq_rel) == stripes)
         {
-            int chunk_size = std::max(1, (task_count - current_task) / remaining_multiplier);
-            int id = current_task.fetch_add(chunk_size, std::memory_order_seq_cst);
-            if (id >= task_count)
-                break; // no more free tasks
-
-            executed_tasks += chunk_size;
-            int start_id = id;
-            int end_id = std::min(task_count, id + chunk_size);
-            CV_LOG_VERBOSE(NULL, 9, "Thread: job " << start_id << "-" << end_id);
-
-            //TODO: if (not pending exception)
-            {
-                body.operator()(Range(range.start + start_id, range.start + end_id));
-            }
-            if (is_worker_thread && is_completed)
-            {
-                CV_LOG_ERROR(NULL, "\t\t\t\tBUG! Job: " << (void*)this << " " << id << " " << active_thread_count << " " << completed_thread_count);
-                CV_Assert(!is_completed); // TODO Dbg this
-            }
+            pthread_mutex_lock(&mutex);
+            is_completed = true;
+            is_completed_flag.store(true, std::memory_order_release);
+            pthread_cond_broadcast(&cond_complete);
+            pthread_mutex_unlock(&mutex);
         }
-        return executed_tasks;
     }
 
-    const ThreadPool& thread_pool;
     const ParallelLoopBody& body;
-    const Range range;
-    const unsigned nstripes;
-
-    std::atomic<int> current_task;  // next free part of job
-    int64 dummy0_[8];  // avoid cache-line reusing for the same atomics
 
-    std::atomic<int> active_thread_count;  // number of threads worked on this job
-    int64 dummy1_[8];  // avoid cache-line reusing for the same atomics
+    std::atomic<int> remaining;  // number of stripes which are not executed yet
+    int64 dummy_[8];  // avoid cache-line reusing for the same atomics
 
-    std::atomic<int> completed_thread_count;  // number of threads completed any activities on this job
-    int64 dummy2_[8];  // avoid cache-line reusing for the same atomics
-
-    std::atomic<bool> is_completed;
-
-    // TODO exception handling
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_complete;
+    bool is_completed;  // guarded by mutex
+    std::atomic<bool> is_completed_flag;  // for active wait
 };
 
 
-// Disable thread sanitization check when CV_USE_GLOBAL_WORKERS_COND_VAR is not
-// set because it triggers as the main thread reads isActive while the children
-// thread writes it (but it all works out because a mutex is locked in the main
-// thread and isActive re-checked).
-// This is to solve issue #19463.
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR) && defined(__clang__) && defined(__has_feature)
-#if __has_feature(thread_sanitizer)
-__attribute__((no_sanitize("thread")))
-#endif
+#ifdef OPENCV_HAVE_THREAD_AFFINITY
+static void setThreadAffinity(unsigned id, const std::vector<int>& cpus)
+{
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (size_t i = 0; i < cpus.size(); ++i)
+        CPU_SET(cpus[i], &cpu_set);
+    int res = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (res != 0)
+        CV_LOG_WARNING(NULL, "Thread: can't set affinity of worker " << id << ": res = " << res);
+}
 #endif
+
 void WorkerThread::thread_body()
 {
     (void)cv::utils::getThreadID(); // notify OpenCV about new thread
     CV_LOG_VERBOSE(NULL, 5, "Thread: new thread: " << id);
 
+    pthread_once(&g_workerKeyOnce, createWorkerKey);
+    pthread_setspecific(g_workerKey, this);
+
+    if (thread_pool.is_partition)
+    {
+        // workers of partition don't start parallel regions in the global pool
+        getCoreTlsData().parallelPartitionRegion = true;
+#ifdef OPENCV_HAVE_THREAD_AFFINITY
+        if (!thread_pool.cpus.empty())
+            setThreadAffinity(id, thread_pool.cpus);
+#endif
+    }
+#ifdef OPENCV_HAVE_THREAD_AFFINITY
+    if (node >= 0)
+        setThreadAffinity(id, numa::getNodes()[node].cpus);
+#endif
+
+    ThreadPool& pool = thread_pool;
     bool allow_active_wait = true;
 
 #ifdef CV_PROFILE_THREADS
-    ThreadPool::ThreadStatistics& stat = thread_pool.threads_stat[id + 1];
+    ThreadPool::ThreadStatistics& stat = pool.threads_stat[id + 1];
 #endif
 
     while (!stop_thread)
     {
-        CV_LOG_VERBOSE(NULL, 5, "Thread: ... loop iteration: allow_active_wait=" << allow_active_wait << "   has_wake_signal=" << has_wake_signal);
-        if (allow_active_wait && CV_WORKER_ACTIVE_WAIT > 0)
+        ParallelTask task;
+        if (pool.findTask(task, tasks, id + 1, node, NULL))
         {
-            allow_active_wait = false;
-            for (int i = 0; i < CV_WORKER_ACTIVE_WAIT; i++)
-            {
-                if (has_wake_signal)
-                    break;
-                if (CV_ACTIVE_WAIT_PAUSE_LIMIT > 0 && (i < CV_ACTIVE_WAIT_PAUSE_LIMIT || (i & 1)))
-                    CV_PAUSE(16);
-                else
-                    CV_YIELD();
-            }
-        }
-        pthread_mutex_lock(&mutex);
+            const unsigned idle = pool.idle_threads.fetch_sub(1, std::memory_order_relaxed) - 1;
 #ifdef CV_PROFILE_THREADS
-        stat.threadWait = getTickCount();
-#endif
-        while (!has_wake_signal) // to handle spurious wakeups
-        {
-            //CV_LOG_VERBOSE(NULL, 5, "Thread: wait (sleep) ...");
-#if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-            pthread_cond_wait(&thread_pool.cond_thread_wake, &mutex);
+            if (stat.threadExecuteStart == 0)
+                stat.threadExecuteStart = getTickCount();
+            stat.executedTasks += pool.execute(task, tasks);
+            stat.threadExecuteStop = getTickCount();
 #else
-            isActive = false;
-            pthread_cond_wait(&cond_thread_wake, &mutex);
-            isActive = true;
+            pool.execute(task, tasks);
 #endif
-            CV_LOG_VERBOSE(NULL, 5, "Thread: wake ... (has_wake_signal=" << has_wake_signal << " stop_thread=" << stop_thread << ")")
-        }
+            pool.idle_threads.fetch_add(1, std::memory_order_relaxed);
+            if (CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT > 0)
+            {
+                const int active = (int)(pool.threads.size() - idle);
+                allow_active_wait = !(active >= CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT && (id & 1) == 0); // turn off a half of threads
+            }
 #ifdef CV_PROFILE_THREADS
-        stat.threadWake = getTickCount();
+            stat.threadFree = getTickCount();
+            stat.keepActive = allow_active_wait;
 #endif
+            continue;
+        }
 
-        CV_LOG_VERBOSE(NULL, 5, "Thread: checking for new job");
-        if (CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT == 0)
-            allow_active_wait = true;
-        Ptr<ParallelJob> j_ptr; swap(j_ptr, job);
-        has_wake_signal = false;
-        pthread_mutex_unlock(&mutex);
-
-        if (!stop_thread)
+        bool has_tasks = false;
+        const int active_wait = allow_active_wait ? CV_WORKER_ACTIVE_WAIT : 0;
+        for (int i = 0; i < active_wait && !stop_thread; i++)
         {
-            ParallelJob* j = j_ptr;
-            if (j)
+            if (pool.hasTasks())
             {
-                CV_LOG_VERBOSE(NULL, 5, "Thread: job size=" << j->range.size() << " done=" << j->current_task);
-                if (j->current_task < j->range.size())
-                {
-                    int other = j->active_thread_count.fetch_add(1, std::memory_order_seq_cst);
-                    CV_LOG_VERBOSE(NULL, 5, "Thread: processing new job (with " << other << " other threads)"); CV_UNUSED(other);
+                has_tasks = true;
+                break;
+            }
+            activeWaitPause(i);
+        }
+        if (has_tasks)
+            continue;
+
+        // The pusher increments wake_epoch before it checks sleeping_threads,
+        // so either the epoch check below fails or the pusher signals us
+        unsigned epoch = pool.wake_epoch.load(std::memory_order_seq_cst);
+        if (pool.hasTasks())
+            continue;
+        pthread_mutex_lock(&pool.mutex_wake);
 #ifdef CV_PROFILE_THREADS
-                    stat.threadExecuteStart = getTickCount();
-                    stat.executedTasks = j->execute(true);
-                    stat.threadExecuteStop = getTickCount();
-#else
-                    j->execute(true);
+        stat.threadWait = getTickCount();
 #endif
-                    int completed = j->completed_thread_count.fetch_add(1, std::memory_order_seq_cst) + 1;
-                    int active = j->active_thread_count.load(std::memory_order_acquire);
-                    if (CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT > 0)
-                    {
-                        allow_active_wait = true;
-                        if (active >= CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT && (id & 1) == 0) // turn off a half of threads
-                            allow_active_wait = false;
-                    }
-                    CV_LOG_VERBOSE(NULL, 5, "Thread: completed job processing: " << active << " " << completed);
-                    if (active == completed)
-                    {
-                        bool need_signal = !j->is_completed;
-                        j->is_completed = true;
-                        j = NULL; j_ptr.release();
-                        if (need_signal)
-                        {
-                            CV_LOG_VERBOSE(NULL, 5, "Thread: job finished => notifying the main thread");
-                            pthread_mutex_lock(&thread_pool.mutex_notify);  // to avoid signal miss due pre-check condition
-                            // empty
-                            pthread_mutex_unlock(&thread_pool.mutex_notify);
-                            pthread_cond_broadcast/*pthread_cond_signal*/(&thread_pool.cond_thread_task_complete);
-                        }
-                    }
-                }
-                else
-                {
-                    CV_LOG_VERBOSE(NULL, 5, "Thread: no free job tasks");
-                }
-            }
+        pool.sleeping_threads.fetch_add(1, std::memory_order_seq_cst);
+        while (!stop_thread && pool.wake_epoch.load(std::memory_order_seq_cst) == epoch)
+        {
+            CV_LOG_VERBOSE(NULL, 5, "Thread: wait (sleep) ...");
+            pthread_cond_wait(&pool.cond_wake, &pool.mutex_wake);
         }
+        pool.sleeping_threads.fetch_sub(1, std::memory_order_seq_cst);
+        pthread_mutex_unlock(&pool.mutex_wake);
 #ifdef CV_PROFILE_THREADS
-        stat.threadFree = getTickCount();
-        stat.keepActive = allow_active_wait;
+        stat.threadWake = getTickCount();
 #endif
+        if (CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT == 0)
+            allow_active_wait = true;
     }
 }
 
-ThreadPool::ThreadPool()
+ThreadPool::ThreadPool() :
+    is_partition(false)
+{
+    init();
+    num_threads = defaultNumberOfThreads();
+}
+
+ThreadPool::ThreadPool(unsigned num_threads_, const std::vector<int>& cpus_) :
+    is_partition(true), cpus(cpus_)
+{
+    init();
+    num_threads = num_threads_;
+}
+
+void ThreadPool::init()
 {
 #ifdef CV_PROFILE_THREADS
     tickFreq = getTickFrequency();
 #endif
+    active_runs = 0;
+    numa_nodes = 0;
+    idle_threads.store(0);
+    sleeping_threads.store(0);
+    wake_epoch.store(0);
 
     int res = 0;
     res |= pthread_mutex_init(&mutex, NULL);
-    res |= pthread_mutex_init(&mutex_notify, NULL);
-#if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-    res |= pthread_cond_init(&cond_thread_wake, NULL);
-#endif
-    res |= pthread_cond_init(&cond_thread_task_complete, NULL);
+    res |= pthread_mutex_init(&mutex_wake, NULL);
+    res |= pthread_cond_init(&cond_wake, NULL);
 
     if (0 != res)
     {
         CV_LOG_FATAL(NULL, "Failed to initialize ThreadPool (pthreads)");
     }
-    num_threads = defaultNumberOfThreads();
 }
 
 bool ThreadPool::reconfigure_(unsigned new_threads_count)
@@ -502,213 +578,247 @@ bool ThreadPool::reconfigure_(unsigned new_threads_count)
     if (new_threads_count == threads.size())
         return false;
 
-    if (new_threads_count < threads.size())
+    // Workers steal from each other, so the pool is rebuilt as a whole.
+    // There are no tasks at this point: all the parallel regions are completed.
+    // The caller holds the pool mutex.
+    CV_LOG_VERBOSE(NULL, 1, "MainThread: reconfigure worker pool: " << threads.size() << " => " << new_threads_count);
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i]->stop_thread = true;
+    pthread_mutex_lock(&mutex_wake);  // to avoid signal miss due pre-check
+    pthread_cond_broadcast(&cond_wake);
+    pthread_mutex_unlock(&mutex_wake);
+    // Running workers scan the deques of each other (hasTasks(), findTask()),
+    // so no worker object is destroyed until all of them are joined
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i]->join();
+    threads.clear();
+
+    std::vector< Ptr<WorkerThread> > new_threads;
+    new_threads.reserve(new_threads_count);
+    for (unsigned i = 0; i < new_threads_count; ++i)
+        new_threads.push_back(Ptr<WorkerThread>(new WorkerThread(*this, i)));
+    threads.swap(new_threads);
+    idle_threads.store(new_threads_count);
+
+    numa_nodes = 0;
+    node_worker.clear();
+#ifdef OPENCV_HAVE_THREAD_AFFINITY
+    const std::vector<numa::Node>& nodes = numa::getNodes();
+    if (CV_THREAD_POOL_NUMA && !is_partition && nodes.size() > 1 && new_threads_count > 0)
     {
-        CV_LOG_VERBOSE(NULL, 1, "MainThread: reduce worker pool: " << threads.size() << " => " << new_threads_count);
-        std::vector< Ptr<WorkerThread> > release_threads(threads.size() - new_threads_count);
-        for (size_t i = new_threads_count; i < threads.size(); ++i)
+        // the calling thread and the workers are split into contiguous groups per node,
+        // the calling thread belongs to the first group
+        const size_t total = new_threads_count + 1;
+        numa_nodes = (int)std::min(total, nodes.size());
+        node_worker.assign(numa_nodes, -1);
+        for (unsigned i = 0; i < new_threads_count; ++i)
         {
-            pthread_mutex_lock(&threads[i]->mutex);  // to avoid signal miss due pre-check
-            threads[i]->stop_thread = true;
-            threads[i]->has_wake_signal = true;
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-            pthread_mutex_unlock(&threads[i]->mutex);
-            pthread_cond_broadcast/*pthread_cond_signal*/(&threads[i]->cond_thread_wake); // wake thread
-#else
-            pthread_mutex_unlock(&threads[i]->mutex);
-#endif
-            std::swap(threads[i], release_threads[i - new_threads_count]);
+            const int node = (int)((i + 1) * numa_nodes / total);
+            threads[i]->node = node;
+            if (node_worker[node] < 0)
+                node_worker[node] = (int)i;
         }
-#if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-        CV_LOG_VERBOSE(NULL, 1, "MainThread: notify worker threads about termination...");
-        pthread_cond_broadcast(&cond_thread_wake); // wake all threads
+    }
 #endif
-        threads.resize(new_threads_count);
-        release_threads.clear();  // calls thread_join which want to lock mutex
-        return false;
+
+    // the new set of workers is complete before any of them starts scanning it
+    for (unsigned i = 0; i < new_threads_count; ++i)
+        threads[i]->start();
+    return false;
+}
+
+ThreadPool::~ThreadPool()
+{
+    reconfigure(0);
+    pthread_cond_destroy(&cond_wake);
+    pthread_mutex_destroy(&mutex_wake);
+    pthread_mutex_destroy(&mutex);
+}
+
+void ThreadPool::push(TaskDeque& deque, const ParallelTask& task)
+{
+    deque.push(task);
+    wake(false);
+}
+
+void ThreadPool::wake(bool all)
+{
+    wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping_threads.load(std::memory_order_seq_cst) > 0)
+    {
+        pthread_mutex_lock(&mutex_wake);
+        if (all)
+            pthread_cond_broadcast(&cond_wake);
+        else
+            pthread_cond_signal(&cond_wake);
+        pthread_mutex_unlock(&mutex_wake);
     }
-    else
+}
+
+bool ThreadPool::hasTasks() const
+{
+    if (!external_tasks.empty())
+        return true;
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        if (!threads[i]->tasks.empty())
+            return true;
+    }
+    return false;
+}
+
+bool ThreadPool::findTask(ParallelTask& task, TaskDeque& deque, unsigned seed, int node, const ParallelJob* job)
+{
+    if (deque.take(task, job, false))
+        return true;
+    if (&deque != &external_tasks && external_tasks.take(task, job, true))
+        return true;
+    const size_t n = threads.size();
+    for (int same_node = node >= 0 ? 1 : 0; same_node >= 0; --same_node)
     {
-        CV_LOG_VERBOSE(NULL, 1, "MainThread: upgrade worker pool: " << threads.size() << " => " << new_threads_count);
-        for (size_t i = threads.size(); i < new_threads_count; ++i)
+        for (size_t k = 0; k < n; ++k)
         {
-            threads.push_back(Ptr<WorkerThread>(new WorkerThread(*this, (unsigned)i))); // spawn more threads
+            WorkerThread& victim = *threads[(seed + k) % n];
+            if (same_node && victim.node != node)
+                continue;
+            if (&victim.tasks != &deque && victim.tasks.take(task, job, true))
+                return true;
         }
     }
     return false;
 }
 
-ThreadPool::~ThreadPool()
+int ThreadPool::execute(const ParallelTask& task, TaskDeque& deque)
 {
-    reconfigure(0);
-    pthread_cond_destroy(&cond_thread_task_complete);
-#if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-    pthread_cond_destroy(&cond_thread_wake);
-#endif
-    pthread_mutex_destroy(&mutex);
-    pthread_mutex_destroy(&mutex_notify);
+    ParallelJob& job = *task.job;
+    Range r = task.range;
+    const int stripes = r.size();
+    while (r.start < r.end)
+    {
+        // split on demand: the previous part must be taken before the next one is offered
+        if (r.end - r.start > 1 &&
+            idle_threads.load(std::memory_order_relaxed) > 0 &&
+            deque.empty())
+        {
+            int middle = r.start + (r.end - r.start) / 2;
+            push(deque, ParallelTask(&job, Range(middle, r.end)));
+            r.end = middle;
+        }
+        CV_LOG_VERBOSE(NULL, 9, "Thread: job " << r.start);
+        job.body(Range(r.start, r.start + 1));
+        r.start++;
+    }
+    // the job may be destroyed after this call
+    const int executed = stripes - (task.range.end - r.end);
+    job.complete(executed);
+    return executed;
+}
+
+void ThreadPool::wait(ParallelJob& job, TaskDeque& deque, unsigned seed, int node)
+{
+    ParallelTask task;
+    while (!job.is_completed_flag.load(std::memory_order_acquire) &&
+           findTask(task, deque, seed, node, &job))
+    {
+        execute(task, deque);
+    }
+
+    // the rest of the job is executed by other threads
+    for (int i = 0; i < CV_MAIN_THREAD_ACTIVE_WAIT; i++)
+    {
+        if (job.is_completed_flag.load(std::memory_order_acquire))
+            break;
+        activeWaitPause(i);
+    }
+    // lock the mutex in any case: the completing thread may still use the job
+    pthread_mutex_lock(&job.mutex);
+    while (!job.is_completed)
+    {
+        CV_LOG_VERBOSE(NULL, 5, "MainThread: wait completion (sleep) ...");
+        pthread_cond_wait(&job.cond_complete, &job.mutex);
+    }
+    pthread_mutex_unlock(&job.mutex);
 }
 
 void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double nstripes)
 {
-    CV_LOG_VERBOSE(NULL, 1, "MainThread: new parallel job: num_threads=" << num_threads << "   range=" << range.size() << "   nstripes=" << nstripes << "   job=" << (void*)job);
-#ifdef CV_PROFILE_THREADS
-    jobSubmitTime = getTickCount();
-    threads_stat[0].reset();
-    threads_stat[0].threadWait = jobSubmitTime;
-    threads_stat[0].threadWake = jobSubmitTime;
-#endif
-    if (getNumOfThreads() > 1 &&
-        job == NULL &&
-        (range.size() * nstripes >= 2 || (range.size() > 1 && nstripes <= 0))
-    )
+    CV_LOG_VERBOSE(NULL, 1, "MainThread: new parallel job: num_threads=" << num_threads << "   range=" << range.size() << "   nstripes=" << nstripes);
+    CV_UNUSED(nstripes);  // the range is already split into stripes
+    if (getNumOfThreads() <= 1 || range.size() <= 1)
     {
-        pthread_mutex_lock(&mutex);
-        if (job != NULL)
-        {
-            pthread_mutex_unlock(&mutex);
-            body(range);
-            return;
-        }
+        body(range);
+        return;
+    }
+
+    WorkerThread* worker = WorkerThread::current();
+    if (worker && &worker->thread_pool == this)
+    {
+        // nested region: the worker splits it into its own deque, idle threads steal the parts
+        ParallelJob job(body, range);
+        execute(ParallelTask(&job, range), worker->tasks);
+        wait(job, worker->tasks, worker->id + 1, worker->node);
+        return;
+    }
+
+    // non-worker threads (including concurrent parallel_for_ calls) share the same workers
+    pthread_mutex_lock(&mutex);
+    if (active_runs == 0)
         reconfigure_(num_threads - 1);
+    active_runs++;
+    const bool has_workers = !threads.empty();
+    pthread_mutex_unlock(&mutex);
 
+    if (has_workers)
+    {
+#ifdef CV_PROFILE_THREADS
+        jobSubmitTime = getTickCount();
+        for (size_t i = 0; i < threads.size() + 1 && i < CV_PROFILE_THREADS; i++)
+            threads_stat[i].reset();
+        threads_stat[0].threadWait = jobSubmitTime;
+        threads_stat[0].threadWake = jobSubmitTime;
+#endif
+        ParallelJob job(body, range);
+        Range r = range;
+        if (numa_nodes > 1)
         {
-            CV_LOG_VERBOSE(NULL, 1, "MainThread: initialize parallel job: " << range.size());
-            job = Ptr<ParallelJob>(new ParallelJob(*this, range, body, nstripes));
-            pthread_mutex_unlock(&mutex);
-
-            CV_LOG_VERBOSE(NULL, 5, "MainThread: wake worker threads...");
-            for (size_t i = 0; i < threads.size(); ++i)
+            // Consecutive blocks of the range go to the nodes. Regions over the same data are split
+            // the same way, so workers mostly touch the rows placed on their node by the first touch.
+            for (int k = numa_nodes - 1; k > 0; --k)
             {
-                WorkerThread& thread = *(threads[i].get());
-                if (
-#if defined(__clang__) && defined(__has_feature)
-#if __has_feature(thread_sanitizer)
-                        1 ||  // Robust workaround to avoid data race warning of `thread.job`
-#endif
-#endif
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-                        thread.isActive ||
-#endif
-                        thread.has_wake_signal
-                        || !thread.job.empty()  // #10881
-                )
-                {
-                    pthread_mutex_lock(&thread.mutex);
-                    thread.job = job;
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-                    bool isActive = thread.isActive;
-#endif
-                    thread.has_wake_signal = true;
-#ifdef CV_PROFILE_THREADS
-                    threads_stat[i + 1].reset();
-#endif
-                    pthread_mutex_unlock(&thread.mutex);
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-                    if (!isActive)
-                    {
-                        pthread_cond_broadcast/*pthread_cond_signal*/(&thread.cond_thread_wake); // wake thread
-                    }
-#endif
-                }
-                else
+                const int start = range.start + (int)((int64)range.size() * k / numa_nodes);
+                if (start < r.end && node_worker[k] >= 0)
                 {
-                    CV_Assert(thread.job.empty());
-                    thread.job = job;
-                    thread.has_wake_signal = true;
-#ifdef CV_PROFILE_THREADS
-                    threads_stat[i + 1].reset();
-#endif
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-                    pthread_cond_broadcast/*pthread_cond_signal*/(&thread.cond_thread_wake); // wake thread
-#endif
+                    threads[node_worker[k]]->tasks.push(ParallelTask(&job, Range(start, r.end)));
+                    r.end = start;
                 }
             }
+            wake(true);
+        }
 #ifdef CV_PROFILE_THREADS
-            threads_stat[0].threadPing = getTickCount();
-#endif
-#if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-            pthread_cond_broadcast(&cond_thread_wake); // wake all threads
-#endif
-#ifdef CV_PROFILE_THREADS
-            threads_stat[0].threadWake = getTickCount();
-#endif
-            CV_LOG_VERBOSE(NULL, 5, "MainThread: wake worker threads... (done)");
-
-            {
-                ParallelJob& j = *(this->job);
-#ifdef CV_PROFILE_THREADS
-                threads_stat[0].threadExecuteStart = getTickCount();
-                threads_stat[0].executedTasks = j.execute(false);
-                threads_stat[0].threadExecuteStop = getTickCount();
+        threads_stat[0].threadExecuteStart = getTickCount();
+        threads_stat[0].executedTasks = execute(ParallelTask(&job, r), external_tasks);
+        threads_stat[0].threadExecuteStop = getTickCount();
 #else
-                j.execute(false);
+        execute(ParallelTask(&job, r), external_tasks);
 #endif
-                CV_Assert(j.current_task >= j.range.size());
-                CV_LOG_VERBOSE(NULL, 5, "MainThread: complete self-tasks: " << j.active_thread_count << " " << j.completed_thread_count);
-                if (job->is_completed || j.active_thread_count == 0)
-                {
-                    job->is_completed = true;
-                    CV_LOG_VERBOSE(NULL, 5, "MainThread: no WIP worker threads");
-                }
-                else
-                {
-                    if (CV_MAIN_THREAD_ACTIVE_WAIT > 0)
-                    {
-                        for (int i = 0; i < CV_MAIN_THREAD_ACTIVE_WAIT; i++)  // don't spin too much in any case (inaccurate getTickCount())
-                        {
-                            if (job->is_completed)
-                            {
-                                CV_LOG_VERBOSE(NULL, 5, "MainThread: job finalize (active wait) " << j.active_thread_count << " " << j.completed_thread_count);
-                                break;
-                            }
-                            if (CV_ACTIVE_WAIT_PAUSE_LIMIT > 0 && (i < CV_ACTIVE_WAIT_PAUSE_LIMIT || (i & 1)))
-                                CV_PAUSE(16);
-                            else
-                                CV_YIELD();
-                        }
-                    }
-                    if (!job->is_completed)
-                    {
-                        CV_LOG_VERBOSE(NULL, 5, "MainThread: prepare wait " << j.active_thread_count << " " << j.completed_thread_count);
-                        pthread_mutex_lock(&mutex_notify);
-                        for (;;)
-                        {
-                            if (job->is_completed)
-                            {
-                                CV_LOG_VERBOSE(NULL, 5, "MainThread: job finalize (wait) " << j.active_thread_count << " " << j.completed_thread_count);
-                                break;
-                            }
-                            CV_LOG_VERBOSE(NULL, 5, "MainThread: wait completion (sleep) ...");
-                            pthread_cond_wait(&cond_thread_task_complete, &mutex_notify);
-                            CV_LOG_VERBOSE(NULL, 5, "MainThread: wake");
-                        }
-                        pthread_mutex_unlock(&mutex_notify);
-                    }
-                }
-            }
+        wait(job, external_tasks, 0, -1);
 #ifdef CV_PROFILE_THREADS
-            threads_stat[0].threadFree = getTickCount();
-            std::cout << "Job: sz=" << range.size() << " nstripes=" << nstripes << "    Time: " << (threads_stat[0].threadFree - jobSubmitTime) / tickFreq * 1e6 << " usec" << std::endl;
-            for (int i = 0; i < (int)threads.size() + 1; i++)
-            {
-                threads_stat[i].dump(i - 1, jobSubmitTime, tickFreq);
-            }
-#endif
-            if (job)
-            {
-                pthread_mutex_lock(&mutex);
-                CV_LOG_VERBOSE(NULL, 5, "MainThread: job release");
-                CV_Assert(job->is_completed);
-                job.release();
-                pthread_mutex_unlock(&mutex);
-            }
+        threads_stat[0].threadFree = getTickCount();
+        std::cout << "Job: sz=" << range.size() << " nstripes=" << nstripes << "    Time: " << (threads_stat[0].threadFree - jobSubmitTime) / tickFreq * 1e6 << " usec" << std::endl;
+        for (int i = 0; i < (int)threads.size() + 1 && i < CV_PROFILE_THREADS; i++)
+        {
+            threads_stat[i].dump(i - 1, jobSubmitTime, tickFreq);
         }
+#endif
     }
     else
     {
         body(range);
     }
+
+    pthread_mutex_lock(&mutex);
+    active_runs--;
+    pthread_mutex_unlock(&mutex);
 }
 
 size_t ThreadPool::getNumOfThreads()
@@ -722,7 +832,7 @@ void ThreadPool::setNumOfThreads(unsigned n)
     {
         num_threads = n;
         if (n == 1)
-           if (job == NULL) reconfigure(0);  // stop worker threads immediately
+            reconfigure(0);  // stop worker threads immediately (if there are no active regions)
     }
 }
 
@@ -748,6 +858,21 @@ void parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, dou
     ThreadPool::instance().run(range, body, nstripes);
 }
 
+ThreadPool* parallel_pthreads_create_pool(unsigned num_threads, const std::vector<int>& cpus)
+{
+    return new ThreadPool(num_threads, cpus);
+}
+
+void parallel_pthreads_release_pool(ThreadPool* pool)
+{
+    delete pool;
+}
+
+void parallel_for_pthreads(ThreadPool& pool, const Range& range, const ParallelLoopBody& body, double nstripes)
+{
+    pool.run(range, body, nstripes);
+}
+
 }
 
 #endif
@@ -4,6 +4,13 @@
 #ifndef OPENCV_CORE_PARALLEL_IMPL_HPP
 #define OPENCV_CORE_PARALLEL_IMPL_HPP
 
+#if defined _GNU_SOURCE \
+    && !defined(__MINGW32__) \
+    && !defined(__EMSCRIPTEN__) \
+    && !defined(__ANDROID__)
+#define OPENCV_HAVE_THREAD_AFFINITY 1
+#endif
+
 namespace cv {
 
 unsigned defaultNumberOfThreads();
@@ -12,6 +19,12 @@ void parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, dou
 size_t parallel_pthreads_get_threads_num();
 void parallel_pthreads_set_threads_num(int num);
 
+// Thread pools of ParallelPartition: workers are pinned to the CPUs (if not empty)
+class ThreadPool;
+ThreadPool* parallel_pthreads_create_pool(unsigned num_threads, const std::vector<int>& cpus);
+void parallel_pthreads_release_pool(ThreadPool* pool);
+void parallel_for_pthreads(ThreadPool& pool, const Range& range, const ParallelLoopBody& body, double nstripes);
+
 }
 
 #endif // OPENCV_CORE_PARALLEL_IMPL_HPP
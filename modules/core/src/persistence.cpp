@@ -11,6 +11,14 @@
 
 #include <opencv2/core/utils/logger.hpp>
 
+#if defined __linux__ || defined __APPLE__ || defined __HAIKU__ || defined __FreeBSD__
+#define OPENCV_PERSISTENCE_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace cv
 {
 
@@ -349,7 +357,13 @@ static inline void writeReal(uchar* p, double fval)
 #endif
 }
 
+static inline bool isSameNode(const FileNode& a, const FileNode& b)
+{
+    return !a.empty() && a.fs == b.fs && a.blockIdx == b.blockIdx && a.ofs == b.ofs;
+}
 
+// thrown when the FileStorage::parse() callback asks to stop reading
+struct ParsingStopped {};
 
 void FileStorage::Impl::init() {
     flags = 0;
@@ -391,6 +405,12 @@ void FileStorage::Impl::init() {
 
     filename.clear();
     lineno = 0;
+
+    mapped_data = 0;
+    mapped_size = 0;
+    stream_root = FileNode();
+    top_node = FileNode();
+    top_node_block = top_node_ofs = top_node_blksz = 0;
 }
 
 FileStorage::Impl::Impl(FileStorage *_fs) {
@@ -498,7 +518,9 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
                 dot_pos[3] = '\0', fnamelen--;
         }
 
-        if (!isGZ) {
+        if (!isGZ && !write_mode && node_callback && mapFile()) {
+            // the mapped file is read as a memory buffer
+        } else if (!isGZ) {
             file = fopen(filename.c_str(), !write_mode ? "rt" : !append ? "wt" : "a+t");
             if (!file)
             {
@@ -724,8 +746,19 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
             }
 
             if (!parser_do_not_use_direct_dereference.empty()) {
-                ok = getParser().parse(ptr);
-                if (ok) {
+                bool stopped = false;
+                try
+                {
+                    ok = getParser().parse(ptr);
+                    if (ok && node_callback)
+                        releaseTopLevelNode();
+                }
+                catch (const ParsingStopped&)
+                {
+                    // the node tree is incomplete, it must not be accessed
+                    stopped = true;
+                }
+                if (ok && !stopped) {
                     finalizeCollection(root_nodes);
 
                     CV_Assert(!fs_data_ptrs.empty());
@@ -862,6 +895,12 @@ void FileStorage::Impl::setEof() {
 }
 
 void FileStorage::Impl::closeFile() {
+#ifdef OPENCV_PERSISTENCE_USE_MMAP
+    if (mapped_data)
+        munmap(mapped_data, mapped_size);
+#endif
+    mapped_data = 0;
+    mapped_size = 0;
     if (file)
         fclose(file);
 #if USE_ZLIB
@@ -1470,6 +1509,10 @@ uchar *FileStorage::Impl::reserveNodeSpace(FileNode &node, size_t sz) {
         shrinkSize = ofs;
     }
 
+    // the incremental mode keeps track of the relocated nodes
+    const bool is_stream_root = node_callback && isSameNode(node, stream_root);
+    const bool is_top_node = node_callback && isSameNode(node, top_node);
+
     size_t blockSize = std::max((size_t) CV_FS_MAX_LEN * 4 - 256, sz) + 256;
     Ptr<std::vector<uchar> > pv = makePtr<std::vector<uchar> >(blockSize);
     fs_data.push_back(pv);
@@ -1479,6 +1522,10 @@ uchar *FileStorage::Impl::reserveNodeSpace(FileNode &node, size_t sz) {
     node.blockIdx = fs_data_ptrs.size() - 1;
     node.ofs = 0;
     freeSpaceOfs = sz;
+    if (is_stream_root)
+        stream_root = node;
+    else if (is_top_node)
+        top_node = node;
 
     if (ptr && ptr + 5 <= blockEnd) {
         new_ptr[0] = ptr[0];
@@ -1506,6 +1553,12 @@ unsigned FileStorage::Impl::getStringOfs(const std::string &key) const {
 FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key,
                                     int elem_type, const void *value, int len) {
     FileStorage_API *fs = this;
+    const bool is_root = collection.blockIdx == 0 && collection.ofs == 0;
+    const bool is_top_node = node_callback && !is_root && isSameNode(collection, stream_root);
+    // in the incremental mode the previous top-level node is complete once the next one (or the next stream) starts
+    if (node_callback && (is_root || is_top_node))
+        releaseTopLevelNode();
+
     bool noname = key.empty() || (fmt == FileStorage::FORMAT_XML && strcmp(key.c_str(), "_") == 0);
     convertToCollection(noname ? FileNode::SEQ : FileNode::MAP, collection);
 
@@ -1530,6 +1583,11 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
     size_t blockIdx = fs_data_ptrs.size() - 1;
     size_t ofs = freeSpaceOfs;
     FileNode node(fs_ext, blockIdx, ofs);
+    if (is_top_node) {
+        top_node_block = blockIdx;
+        top_node_ofs = ofs;
+        top_node_blksz = fs_data_blksz[blockIdx];
+    }
 
     size_t sz0 = 1 + (noname ? 0 : 4) + 8;
     uchar *ptr = reserveNodeSpace(node, sz0);
@@ -1556,9 +1614,72 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
     int nelems = readInt(cp + 5);
     writeInt(cp + 5, nelems + 1);
 
+    if (node_callback) {
+        if (is_root)
+            stream_root = node;
+        else if (is_top_node)
+            top_node = node;
+    }
+
     return node;
 }
 
+// Passes the last top-level node to the callback and then removes it from the node storage,
+// so the space can be reused by the next top-level node
+void FileStorage::Impl::releaseTopLevelNode() {
+    if (top_node.empty())
+        return;
+    FileNode node = top_node;
+    top_node = FileNode();
+    bool proceed = node_callback(node);
+
+    // drop the blocks allocated since the node was added and restore the block size
+    // (the block is shrunk when the node doesn't fit into it)
+    fs_data.resize(top_node_block + 1);
+    fs_data_ptrs.resize(top_node_block + 1);
+    fs_data_blksz.resize(top_node_block + 1);
+    std::vector<uchar>& block = *fs_data[top_node_block];
+    block.resize(top_node_blksz);
+    fs_data_ptrs[top_node_block] = &block[0];
+    fs_data_blksz[top_node_block] = top_node_blksz;
+    // new nodes expect zeroed space
+    memset(&block[0] + top_node_ofs, 0, top_node_blksz - top_node_ofs);
+    freeSpaceOfs = top_node_ofs;
+
+    uchar *ptr = stream_root.ptr() + 1;
+    if (stream_root.isNamed())
+        ptr += 4;
+    writeInt(ptr + 4, readInt(ptr + 4) - 1);
+    finalizeCollection(stream_root);
+
+    if (!proceed)
+        throw ParsingStopped();
+}
+
+bool FileStorage::Impl::mapFile() {
+#ifdef OPENCV_PERSISTENCE_USE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    void *data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+        data = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+    madvise(data, (size_t) st.st_size, MADV_SEQUENTIAL);
+    mapped_data = data;
+    mapped_size = (size_t) st.st_size;
+    strbuf = (char *) data;
+    strbufsize = mapped_size;
+    strbufpos = 0;
+    return true;
+#else
+    return false;
+#endif
+}
+
 void FileStorage::Impl::finalizeCollection(FileNode &collection) {
     if (!collection.isSeq() && !collection.isMap())
         return;
@@ -1891,6 +2012,29 @@ bool FileStorage::open(const String& filename, int flags, const String& encoding
     }
 }
 
+bool FileStorage::parse(const String& filename, int flags, const std::function<bool(const FileNode&)>& callback,
+                        const String& encoding)
+{
+    CV_Assert((flags & 3) == READ);
+    CV_Assert(callback);
+    release();
+    p->node_callback = callback;
+    bool ok = false;
+    try
+    {
+        ok = p->open(filename.c_str(), flags, encoding.c_str());
+    }
+    catch (...)
+    {
+        p->node_callback = nullptr;
+        release();
+        throw;  // re-throw
+    }
+    p->node_callback = nullptr;
+    release();
+    return ok;
+}
+
 bool FileStorage::isOpened() const { return p->is_opened; }
 
 void FileStorage::release()
@@ -181,6 +181,11 @@ public:
 
     FileStorage* getFS();
 
+    // incremental reading (FileStorage::parse())
+    bool mapFile();
+
+    void releaseTopLevelNode();
+
     FileStorage* fs_ext;
 
     std::string filename;
@@ -242,6 +247,16 @@ public:
     size_t strbufsize;
     size_t strbufpos;
     int lineno;
+
+    void* mapped_data;
+    size_t mapped_size;
+
+    std::function<bool(const FileNode&)> node_callback;
+    FileNode stream_root;  //!< the collection top-level nodes are added to
+    FileNode top_node;     //!< the last top-level node, it's passed to the callback when the next one starts
+    size_t top_node_block;     //!< the node storage state before top_node has been added
+    size_t top_node_ofs;
+    size_t top_node_blksz;
 };
 
 }
@@ -153,7 +153,18 @@ void read(const FileNode& node, Mat& m, const Mat& default_mat)
     size_t nelems = data_node.size();
     CV_Assert(nelems == m.total()*m.channels());
 
-    data_node.readRaw(dt, (uchar*)m.ptr(), m.total()*m.elemSize());
+    if (m.isContinuous())
+    {
+        data_node.readRaw(dt, (uchar*)m.ptr(), m.total()*m.elemSize());
+        return;
+    }
+    // the preallocated destination may be a submatrix, read it plane by plane
+    const Mat* arrays[] = { &m, 0 };
+    uchar* ptrs[1] = { 0 };
+    NAryMatIterator planes(arrays, ptrs);
+    FileNodeIterator it = data_node.begin();
+    for (size_t i = 0; i < planes.nplanes; i++, ++planes)
+        it.readRaw(dt, ptrs[0], planes.size*m.elemSize());
 }
 
 void read( const FileNode& node, SparseMat& m, const SparseMat& default_mat )
@@ -332,6 +332,7 @@ struct CoreTLSData
 #ifdef HAVE_OPENVX
         ,useOpenVX(-1)
 #endif
+        ,parallelPartitionRegion(false)
     {}
 
     RNG rng;
@@ -345,6 +346,8 @@ struct CoreTLSData
 #ifdef HAVE_OPENVX
     int useOpenVX; // 1 - use, 0 - do not use, -1 - auto/not initialized
 #endif
+    Ptr<ParallelPartition> parallelPartition;  // see ParallelPartitionScope
+    bool parallelPartitionRegion;  // inside of a parallel region of a partition, nested regions are not parallelized
 };
 
 CoreTLSData& getCoreTlsData();
@@ -1964,4 +1964,101 @@ TEST(Core_InputOutput, FileStorage_invalid_path_regression_21448_JSON)
 }
 
 
+static void test_FileStorage_parse(const std::string& suffix)
+{
+    const std::string filename = cv::tempfile(suffix.c_str());
+    const int N = 10;
+    std::vector<Mat> frames(N);
+    {
+        FileStorage fs(filename, FileStorage::WRITE);
+        fs << "count" << N;
+        RNG& rng = theRNG();
+        for (int i = 0; i < N; i++)
+        {
+            frames[i].create(48, 64, CV_8UC3);
+            rng.fill(frames[i], RNG::UNIFORM, 0, 256);
+            fs << cv::format("frame%d", i) << frames[i];
+            fs << cv::format("text%d", i) << std::string(3000 + i, (char)('a' + i));
+        }
+        fs << "names" << "[" << "a" << "b" << "]";
+    }
+
+    // preallocated non-continuous destination
+    Mat canvas(100, 100, CV_8UC3, Scalar::all(0));
+    Mat frame = canvas(Rect(10, 20, 64, 48));
+    const uchar* data = frame.data;
+    std::vector<std::string> names;
+    int count = 0;
+    FileStorage fs;
+    bool ok = fs.parse(filename, FileStorage::READ, [&](const FileNode& node) {
+        names.push_back(node.name());
+        const int i = (int)(names.size() - 2) / 2;
+        if (node.name() == "count")
+            node >> count;
+        else if (node.isMap())
+        {
+            node >> frame;
+            EXPECT_EQ(data, frame.data);
+            EXPECT_EQ(0, cvtest::norm(frame, frames[i], NORM_INF)) << node.name();
+        }
+        else if (node.isString())
+        {
+            EXPECT_EQ(std::string(3000 + i, (char)('a' + i)), (std::string)node) << node.name();
+        }
+        else
+        {
+            EXPECT_TRUE(node.isSeq());
+            EXPECT_EQ(2u, node.size());
+            EXPECT_EQ("b", (std::string)node[1]);
+        }
+        return true;
+    });
+    ASSERT_TRUE(ok);
+    EXPECT_FALSE(fs.isOpened());
+    EXPECT_EQ(N, count);
+    ASSERT_EQ((size_t)N*2 + 2, names.size());
+    EXPECT_EQ("frame0", names[1]);
+    EXPECT_EQ("text0", names[2]);
+    EXPECT_EQ("names", names.back());
+    EXPECT_EQ(0, cvtest::norm(canvas(Rect(0, 0, 100, 20)), NORM_INF));  // nothing is written outside of ROI
+
+    // stop after the first frame
+    names.clear();
+    ok = fs.parse(filename, FileStorage::READ, [&](const FileNode& node) {
+        names.push_back(node.name());
+        return !node.isMap();
+    });
+    ASSERT_TRUE(ok);
+    EXPECT_EQ(2u, names.size());
+
+    EXPECT_EQ(0, remove(filename.c_str()));
+}
+
+TEST(Core_InputOutput, FileStorage_parse_xml) { test_FileStorage_parse(".xml"); }
+TEST(Core_InputOutput, FileStorage_parse_yml) { test_FileStorage_parse(".yml"); }
+TEST(Core_InputOutput, FileStorage_parse_json) { test_FileStorage_parse(".json"); }
+TEST(Core_InputOutput, FileStorage_parse_xml_gz) { test_FileStorage_parse(".xml.gz"); }
+
+TEST(Core_InputOutput, FileStorage_parse_YAML_multiple_documents)
+{
+    const std::string content = "%YAML:1.0\n---\na: 42\nb: [ 1, 2 ]\n...\n---\nc: 1988\n";
+    std::vector<std::string> names;
+    std::vector<int> values;
+    FileStorage fs;
+    bool ok = fs.parse(content, FileStorage::READ + FileStorage::MEMORY, [&](const FileNode& node) {
+        names.push_back(node.name());
+        values.push_back(node.isSeq() ? (int)node[1] : (int)node);
+        return true;
+    });
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(3u, names.size());
+    EXPECT_EQ("a", names[0]);
+    EXPECT_EQ("b", names[1]);
+    EXPECT_EQ("c", names[2]);
+    EXPECT_EQ(42, values[0]);
+    EXPECT_EQ(2, values[1]);
+    EXPECT_EQ(1988, values[2]);
+}
+
+
 }} // namespace
@@ -10,6 +10,9 @@
 #endif
 
 #include "opencv2/core/cuda.hpp"
+#include "opencv2/core/utils/allocator_stats.hpp"
+
+#include <thread>
 
 namespace opencv_test { namespace {
 
@@ -2563,4 +2566,103 @@ TEST(Mat, Recreate1DMatWithSameMeta)
     EXPECT_NO_THROW(m.create(dims, depth));
 }
 
+TEST(Mat, NumaAllocator)
+{
+    MatAllocator* allocator = Mat::getNumaAllocator();
+    ASSERT_TRUE(allocator != NULL);
+
+    const int rows[] = {4, 2048};  // small and large (above the threshold) buffers
+    for (size_t i = 0; i < sizeof(rows) / sizeof(rows[0]); i++)
+    {
+        Mat m;
+        m.allocator = allocator;
+        m.create(rows[i], 1024, CV_8UC4);
+        ASSERT_TRUE(m.isContinuous());
+        parallel_for_(Range(0, m.rows), [&](const Range& r) {
+            m.rowRange(r).setTo(Scalar(1, 2, 3, 4));
+        });
+        Mat expected(m.size(), m.type(), Scalar(1, 2, 3, 4));
+        EXPECT_EQ(0, cvtest::norm(m, expected, NORM_INF));
+
+        Mat roi = m.rowRange(1, 3).clone();
+        m.release();
+        EXPECT_EQ(0, cvtest::norm(roi, expected.rowRange(1, 3), NORM_INF));
+    }
+}
+
+TEST(Mat, CachingAllocator)
+{
+    MatAllocator* allocator = Mat::getCachingAllocator();
+    BufferPoolController* pool = allocator->getBufferPoolController();
+    ASSERT_TRUE(pool != NULL);
+    utils::CachingAllocatorStatisticsInterface& stats = utils::getCachingAllocatorStatistics();
+    pool->freeAllReservedBuffers();
+    ASSERT_EQ(0u, pool->getReservedSize());
+    const uint64_t usage0 = stats.getCurrentUsage();
+
+    const uchar* data = NULL;
+    {
+        Mat frame;
+        frame.allocator = allocator;
+        frame.create(1080, 1920, CV_8UC3);
+        frame.setTo(Scalar::all(1));
+        data = frame.data;
+        EXPECT_LT(usage0, stats.getCurrentUsage());
+    }
+    EXPECT_EQ(usage0, stats.getCurrentUsage());
+    EXPECT_LT(0u, pool->getReservedSize());
+
+    // the same size class reuses the buffer
+    const uint64_t hits0 = stats.getNumberOfCacheHits();
+    {
+        Mat frame;
+        frame.allocator = allocator;
+        frame.create(1079, 1920, CV_8UC3);
+        EXPECT_EQ(data, frame.data);
+        EXPECT_EQ(hits0 + 1, stats.getNumberOfCacheHits());
+        EXPECT_EQ(0u, pool->getReservedSize());
+    }
+
+    // buffers released by other threads are reused through the global pool
+    pool->freeAllReservedBuffers();
+    std::thread([&]() {
+        for (int i = 0; i < 8; i++)
+        {
+            Mat m;
+            m.allocator = allocator;
+            m.create(512 + i, 512, CV_32FC1);
+            m.setTo(Scalar::all(i));
+            m.release();
+        }
+    }).join();
+    const uint64_t hits1 = stats.getNumberOfCacheHits();
+    {
+        Mat m;
+        m.allocator = allocator;
+        m.create(512, 512, CV_32FC1);
+        EXPECT_EQ(hits1 + 1, stats.getNumberOfCacheHits());
+    }
+
+    // small buffers go to the standard allocator
+    {
+        Mat small;
+        small.allocator = allocator;
+        small.create(4, 4, CV_8UC1);
+        EXPECT_EQ(Mat::getStdAllocator(), small.u->currAllocator);
+    }
+
+    // the limit of cached memory
+    const size_t maxReserved = pool->getMaxReservedSize();
+    pool->setMaxReservedSize(0);
+    EXPECT_EQ(0u, pool->getReservedSize());
+    {
+        Mat m;
+        m.allocator = allocator;
+        m.create(1024, 1024, CV_8UC1);
+    }
+    EXPECT_EQ(0u, pool->getReservedSize());
+    pool->setMaxReservedSize(maxReserved);
+    pool->freeAllReservedBuffers();
+}
+
 }} // namespace
@@ -8,7 +8,10 @@
 
 #include <opencv2/core/utils/fp_control_utils.hpp>
 
+#include "../src/parallel/grain_model.hpp"
+
 #ifdef CV_CXX11
+#include <atomic>
 #include <chrono>
 #include <thread>
 #endif
@@ -308,6 +311,284 @@ TEST(Core_Parallel, propagate_fp_denormals_ignore_hint)
     }
 }
 
+class ThreadRecorderParallelLoopBody : public cv::ParallelLoopBody
+{
+public:
+    ThreadRecorderParallelLoopBody(std::vector<int>& dst_) : dst(dst_) {}
+    void operator()(const cv::Range& r) const CV_OVERRIDE
+    {
+        for (int i = r.start; i < r.end; i++)
+            dst[i] = i * 2;
+        // nested regions are executed by the worker
+        int nested = 0;
+        parallel_for_(cv::Range(0, 100), [&](const cv::Range& nr) { nested += nr.size(); });
+        CV_Assert(nested == 100);
+        cv::AutoLock lock(mutex);
+        threads.insert(cv::utils::getThreadID());
+    }
+
+    std::vector<int>& dst;
+    mutable cv::Mutex mutex;
+    mutable std::set<int> threads;
+};
+
+TEST(Core_Parallel, partitions)
+{
+    const int nPartitions = 3, nThreads = 2;
+    const int globalThreads = cv::getNumThreads();
+    std::vector<Ptr<ParallelPartition> > partitions(nPartitions);
+    for (int i = 0; i < nPartitions; i++)
+    {
+        partitions[i] = ParallelPartition::create(nThreads);
+        ASSERT_EQ(nThreads, partitions[i]->getNumThreads());
+    }
+
+    std::vector<std::vector<int> > results(nPartitions, std::vector<int>(1000));
+    std::vector<std::set<int> > threads(nPartitions);
+    std::vector<int> numThreads(nPartitions);
+    std::vector<std::thread> runners;
+    for (int i = 0; i < nPartitions; i++)
+    {
+        runners.push_back(std::thread([&, i]() {
+            ParallelPartitionScope scope(partitions[i]);
+            numThreads[i] = cv::getNumThreads();
+            for (int iter = 0; iter < 20; iter++)
+            {
+                ThreadRecorderParallelLoopBody body(results[i]);
+                parallel_for_(cv::Range(0, (int)results[i].size()), body);
+                threads[i].insert(body.threads.begin(), body.threads.end());
+            }
+        }));
+    }
+    for (size_t i = 0; i < runners.size(); i++)
+        runners[i].join();
+
+    for (int i = 0; i < nPartitions; i++)
+    {
+        EXPECT_EQ(nThreads, numThreads[i]);
+        EXPECT_LE(threads[i].size(), (size_t)nThreads);  // the calling thread and the workers
+        for (int k = 0; k < (int)results[i].size(); k++)
+            ASSERT_EQ(k * 2, results[i][k]) << "partition " << i;
+    }
+
+    {
+        ParallelPartitionScope scope(partitions[0]);
+        Mat dst(1000, 100, CV_8SC1, Scalar::all(0));
+        EXPECT_THROW(parallel_for_(cv::Range(0, dst.rows), ThrowErrorParallelLoopBody(dst, dst.rows / 2)), cv::Exception);
+    }
+    EXPECT_EQ(globalThreads, cv::getNumThreads());
+}
+
+TEST(Core_Parallel, concurrent_regions)
+{
+    const int nRunners = 3;
+    const int globalThreads = cv::getNumThreads();
+    cv::setNumThreads(4);
+
+    std::vector<std::vector<int> > results(nRunners, std::vector<int>(1000));
+    std::vector<std::thread> runners;
+    for (int i = 0; i < nRunners; i++)
+    {
+        runners.push_back(std::thread([&, i]() {
+            for (int iter = 0; iter < 20; iter++)
+            {
+                std::vector<int>& dst = results[i];
+                parallel_for_(cv::Range(0, (int)dst.size()), [&](const cv::Range& r) {
+                    for (int k = r.start; k < r.end; k++)
+                        dst[k] = k * (i + 1) + iter;
+                });
+            }
+        }));
+    }
+    for (size_t i = 0; i < runners.size(); i++)
+        runners[i].join();
+    cv::setNumThreads(globalThreads);
+
+    for (int i = 0; i < nRunners; i++)
+    {
+        for (int k = 0; k < (int)results[i].size(); k++)
+            ASSERT_EQ(k * (i + 1) + 19, results[i][k]) << "runner " << i;
+    }
+}
+
+TEST(Core_Parallel, nested_regions)
+{
+    const int globalThreads = cv::getNumThreads();
+    cv::setNumThreads(4);
+
+    const int outer = 16, inner = 500;
+    std::vector<int> results(outer * inner, 0);
+    std::atomic<int> calls(0);
+    parallel_for_(cv::Range(0, outer), [&](const cv::Range& r) {
+        for (int i = r.start; i < r.end; i++)
+        {
+            parallel_for_(cv::Range(0, inner), [&](const cv::Range& nr) {
+                for (int k = nr.start; k < nr.end; k++)
+                    results[i * inner + k] += i + k;
+                calls++;
+            });
+        }
+    });
+    cv::setNumThreads(globalThreads);
+
+    EXPECT_LE(outer, calls.load());
+    for (int i = 0; i < outer; i++)
+    {
+        for (int k = 0; k < inner; k++)
+            ASSERT_EQ(i + k, results[i * inner + k]) << "i=" << i << " k=" << k;
+    }
+
+    // exceptions of nested regions are propagated to the caller
+    Mat dst(100, 10, CV_8SC1, Scalar::all(0));
+    cv::setNumThreads(4);
+    EXPECT_THROW(parallel_for_(cv::Range(0, 4), [&](const cv::Range&) {
+        parallel_for_(cv::Range(0, dst.rows), ThrowErrorParallelLoopBody(dst, dst.rows / 2));
+    }), cv::Exception);
+    cv::setNumThreads(globalThreads);
+}
+
+TEST(Core_Parallel, reconfigure)
+{
+    const int globalThreads = cv::getNumThreads();
+    const int counts[] = { 8, 2, 6, 3, 1, 4, 2 };  // the pool grows and shrinks between regions
+    for (int iter = 0; iter < 5; iter++)
+    {
+        for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+        {
+            cv::setNumThreads(counts[i]);
+            std::atomic<int> sum(0);
+            parallel_for_(cv::Range(0, 1000), [&](const cv::Range& r) {
+                for (int k = r.start; k < r.end; k++)
+                    sum += k;
+            });
+            ASSERT_EQ(999 * 1000 / 2, sum.load()) << "threads=" << counts[i];
+        }
+    }
+    cv::setNumThreads(globalThreads);
+}
+
+// simulates runs of a loop body with the given costs (per item) of the candidates
+static int runGrainModel(cv::parallel::GrainModel& model, const cv::parallel::GrainModel::Key& key,
+                         const double cost[], int calls, std::vector<int>* selected = NULL)
+{
+    const int range = 1000;
+    int candidate = -1;
+    for (int i = 0; i < calls; i++)
+    {
+        double nstripes = -1;
+        candidate = model.select(key, nstripes);
+        if (candidate == 2)
+            EXPECT_EQ(key.threads, nstripes);
+        else if (candidate == 3)
+            EXPECT_EQ(key.threads * 4, nstripes);
+        else
+            EXPECT_EQ(-1, nstripes);
+        if (selected)
+            selected->push_back(candidate);
+        model.update(key, candidate, (int64)(cost[candidate] * range), range);
+    }
+    return candidate;
+}
+
+TEST(Core_Parallel, adaptive_nstripes_selection)
+{
+    using cv::parallel::GrainModel;
+    GrainModel model;
+    const GrainModel::Key key(typeid(int), cv::Range(0, 1000), 4);
+    EXPECT_EQ(-1, model.getSelected(key));
+
+    // all the candidates are measured, then the cheapest one is used
+    const double cost1[GrainModel::CANDIDATES] = { 10, 8, 2, 5 };
+    std::vector<int> selected;
+    runGrainModel(model, key, cost1, GrainModel::CANDIDATES * GrainModel::SAMPLES, &selected);
+    EXPECT_EQ(2, model.getSelected(key));
+    for (int c = 0; c < GrainModel::CANDIDATES; c++)
+        EXPECT_EQ(GrainModel::SAMPLES, (int)std::count(selected.begin(), selected.end(), c)) << c;
+
+    // stable cost: the selection is kept
+    selected.clear();
+    runGrainModel(model, key, cost1, 1000, &selected);
+    EXPECT_EQ(1000, (int)std::count(selected.begin(), selected.end(), 2));
+
+    // the cost of normal runs has changed: the parallel candidates are measured again, serial runs are not forced
+    const double cost2[GrainModel::CANDIDATES] = { 1, 30, 20, 6 };
+    selected.clear();
+    runGrainModel(model, key, cost2, 100, &selected);
+    EXPECT_EQ(0, (int)std::count(selected.begin(), selected.end(), 0));
+    EXPECT_EQ(3, model.getSelected(key));
+
+    // other keys are learned separately
+    EXPECT_EQ(-1, model.getSelected(GrainModel::Key(typeid(int), cv::Range(0, 100), 4)));
+    EXPECT_EQ(-1, model.getSelected(GrainModel::Key(typeid(float), cv::Range(0, 1000), 4)));
+    EXPECT_EQ(-1, model.getSelected(GrainModel::Key(typeid(int), cv::Range(0, 1000), 8)));
+
+    // serial execution is kept measured while it is selected
+    GrainModel model2;
+    const double cost3[GrainModel::CANDIDATES] = { 1, 8, 2, 5 };
+    EXPECT_EQ(0, runGrainModel(model2, key, cost3, GrainModel::CANDIDATES * GrainModel::SAMPLES + 1));
+    EXPECT_EQ(0, model2.getSelected(key));
+}
+
+TEST(Core_Parallel, adaptive_nstripes_lambdas)
+{
+    using cv::parallel::GrainModel;
+    int cheap = 0, expensive = 0;
+    const cv::ParallelLoopBodyLambdaWrapper body1([&](const cv::Range& r) { cheap += r.size(); });
+    const cv::ParallelLoopBodyLambdaWrapper body2([&](const cv::Range& r) { expensive += r.size() * 100; });
+
+    // each lambda is learned separately, not as the wrapper type
+    const std::type_info& type1 = GrainModel::bodyType(body1);
+    const std::type_info& type2 = GrainModel::bodyType(body2);
+    EXPECT_NE(std::type_index(type1), std::type_index(type2));
+    EXPECT_NE(std::type_index(typeid(cv::ParallelLoopBodyLambdaWrapper)), std::type_index(type1));
+    const cv::ParallelLoopBodyLambdaWrapper body1_copy(body1);
+    EXPECT_EQ(std::type_index(type1), std::type_index(GrainModel::bodyType(body1_copy)));
+
+    GrainModel model;
+    const GrainModel::Key key1(type1, cv::Range(0, 1000), 4);
+    const GrainModel::Key key2(type2, cv::Range(0, 1000), 4);
+    const double cost1[GrainModel::CANDIDATES] = { 1, 8, 2, 5 };
+    const double cost2[GrainModel::CANDIDATES] = { 100, 40, 25, 30 };
+    for (int i = 0; i < 100; i++)
+    {
+        runGrainModel(model, key1, cost1, 1);
+        runGrainModel(model, key2, cost2, 1);
+    }
+    EXPECT_EQ(0, model.getSelected(key1));
+    EXPECT_EQ(2, model.getSelected(key2));
+}
+
+class CountStripesBody : public cv::ParallelLoopBody
+{
+public:
+    CountStripesBody() : calls(0), items(0) {}
+    void operator()(const cv::Range& r) const CV_OVERRIDE
+    {
+        calls++;
+        items += r.size();
+    }
+    mutable std::atomic<int> calls;
+    mutable std::atomic<int> items;
+};
+
+TEST(Core_Parallel, nstripes)
+{
+    const int globalThreads = cv::getNumThreads();
+    cv::setNumThreads(4);
+    // the caller's nstripes is used as is (also with OPENCV_PARALLEL_ADAPTIVE_GRAIN)
+    for (int iter = 0; iter < 50; iter++)
+    {
+        for (int nstripes = 1; nstripes <= 7; nstripes++)
+        {
+            CountStripesBody body;
+            parallel_for_(cv::Range(0, 1000), body, nstripes);
+            ASSERT_EQ(nstripes, body.calls.load()) << "iter=" << iter;
+            ASSERT_EQ(1000, body.items.load());
+        }
+    }
+    cv::setNumThreads(globalThreads);
+}
+
 TEST(Core_Version, consistency)
 {
     // this test verifies that OpenCV version loaded in runtime
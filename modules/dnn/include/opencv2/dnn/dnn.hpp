@@ -105,6 +105,8 @@ CV__DNN_INLINE_NS_BEGIN
         DNN_TARGET_CUDA_FP16,
         DNN_TARGET_HDDL,
         DNN_TARGET_NPU,
+        DNN_TARGET_CPU_FP16,  //!< CPU with weights of convolution and fully connected layers stored in FP16. Computations are in FP32.
+                              //!< FP16 weights are shared by clones of the network, FP32 parameters are kept for the other targets.
     };
 
     CV_EXPORTS std::vector< std::pair<Backend, Target> > getAvailableBackends();
@@ -435,6 +437,26 @@ CV__DNN_INLINE_NS_BEGIN
         virtual ~Layer();
     };
 
+    /** @brief Measurements of a single layer run collected by Net::enableProfiling().
+     *
+     * Bytes count only the data of layer inputs and outputs, layer weights are not included.
+     */
+    struct CV_EXPORTS LayerProfile
+    {
+        int forwardId;       //!< index of the forward pass since profiling was enabled
+        int layerId;
+        String name;
+        String type;
+        double startMs;      //!< start time relative to the moment when profiling was enabled
+        double timeMs;       //!< wall time of the layer
+        int threads;         //!< number of threads available for the layer (cv::getNumThreads())
+        int64 flops;         //!< estimated by Layer::getFLOPS() for the actual shapes
+        int64 inputBytes;
+        int64 outputBytes;
+
+        double gflops() const { return timeMs > 0 ? flops * 1e-6 / timeMs : 0; }  //!< achieved GFLOP/s
+    };
+
     /** @brief This class allows to create and manipulate comprehensive artificial neural networks.
      *
      * Neural network is presented as directed acyclic graph (DAG), where vertices are Layer instances,
@@ -599,7 +621,11 @@ CV__DNN_INLINE_NS_BEGIN
          *  @details By default runs forward pass for the whole network.
          *
          *  This is an asynchronous version of forward(const String&).
-         *  dnn::DNN_BACKEND_INFERENCE_ENGINE backend is required.
+         *  dnn::DNN_BACKEND_OPENCV or dnn::DNN_BACKEND_INFERENCE_ENGINE backend is required.
+         *  dnn::DNN_BACKEND_OPENCV runs requests concurrently on a pool of execution contexts which share
+         *  weights but have separate activation blobs. The number of contexts is controlled by
+         *  OPENCV_DNN_ASYNC_CONTEXTS configuration parameter (2 by default). Current inputs of the network
+         *  are copied on each call, so setInput() may be called right after.
          */
         CV_WRAP AsyncArray forwardAsync(const String& outputName = String());
 
@@ -624,6 +650,15 @@ CV__DNN_INLINE_NS_BEGIN
         CV_WRAP_AS(forwardAndRetrieve) void forward(CV_OUT std::vector<std::vector<Mat> >& outputBlobs,
                                                     const std::vector<String>& outBlobNames);
 
+        /** @brief Creates a copy of the network which shares weights with this network.
+         *
+         * Constant blobs of the layers are shared and must not be modified, each copy allocates
+         * its own intermediate blobs. Use clones to run the same model from several threads without
+         * duplication of the weights. Modifications of the clone by setParam() replace the blob
+         * of the clone only. Backend, target and fusion settings are copied as well.
+         */
+        CV_WRAP Net clone() const;
+
         /** @brief Returns a quantized Net from a floating-point Net.
          *  @param calibData Calibration data to compute the quantization parameters.
          *  @param inputsDtype Datatype of quantized net's inputs. Can be CV_32F or CV_8S.
@@ -682,6 +717,7 @@ CV__DNN_INLINE_NS_BEGIN
          * | DNN_TARGET_CUDA        |                    |                              |                    |                 + |
          * | DNN_TARGET_CUDA_FP16   |                    |                              |                    |                 + |
          * | DNN_TARGET_HDDL        |                    |                            + |                    |                   |
+         * | DNN_TARGET_CPU_FP16    |                  + |                              |                    |                   |
          */
         CV_WRAP void setPreferableTarget(int targetId);
 
@@ -843,6 +879,44 @@ CV__DNN_INLINE_NS_BEGIN
         */
         CV_WRAP void enableWinograd(bool useWinograd);
 
+        /** @brief Enables or disables the static memory planner.
+         *
+         * The planner computes lifetimes of intermediate blobs from the network topology and packs them
+         * into a single preallocated arena using best-fit offset assignment. Blobs that may be read by the user
+         * (network inputs and outputs) are kept out of the arena. Supported by DNN_BACKEND_OPENCV on DNN_TARGET_CPU only.
+         * When the network has been allocated for the requested input shapes, getMemoryConsumption() reports
+         * the planned memory in @p blobs. The planner is disabled by default.
+         * @param useMemoryPlanner true to enable the memory planner.
+         */
+        CV_WRAP void enableMemoryPlanner(bool useMemoryPlanner);
+
+        /** @brief Sets the number of cached execution plans for different input shapes.
+         *
+         * Change of input shapes reallocates the network. With the cache, shapes of the blobs and their placement
+         * in memory are kept for the recently used input shapes, so switching between a few resolutions skips
+         * shape inference. Only the blobs memory is allocated again. Layers are finalized for the new shapes,
+         * packed weights are kept if they don't depend on the shapes. The least recently used plan is dropped if
+         * the cache is full or the plans take more than OPENCV_DNN_SHAPE_PLAN_CACHE_MAX_BYTES (16 MB by default).
+         * Supported by DNN_BACKEND_OPENCV on CPU targets only.
+         * The default value is 0 (disabled) and can be changed by OPENCV_DNN_SHAPE_PLAN_CACHE_SIZE variable.
+         * @param size maximal number of cached plans.
+         */
+        CV_WRAP void setShapePlanCacheSize(int size);
+
+        /** @brief Runs the network on a dedicated group of threads.
+         *
+         * By default layers of all the networks use the global thread pool, so networks which are run
+         * concurrently from different threads compete for the same workers. With the budget, forward() runs
+         * parallel regions of the network on its own @p numThreads threads (including the calling one) which are
+         * pinned to @p cpus. For example, four networks with budgets of four disjoint cores don't slow down each other.
+         * Supported by the builtin pthreads parallel framework, see cv::ParallelPartition for details.
+         * Clones of the network share its threads, so they don't exceed the budget when run concurrently.
+         * @param numThreads number of threads, or 0 to use the number of @p cpus. Zero with empty @p cpus
+         * restores the global thread pool.
+         * @param cpus indices of CPUs the worker threads are pinned to, empty to not pin them.
+         */
+        CV_WRAP void setThreadBudget(int numThreads, const std::vector<int>& cpus = std::vector<int>());
+
         /** @brief Returns overall time for inference and timings (in ticks) for layers.
          *
          * Indexes in returned vector correspond to layers ids. Some layers can be fused with others,
@@ -853,6 +927,29 @@ CV__DNN_INLINE_NS_BEGIN
          */
         CV_WRAP int64 getPerfProfile(CV_OUT std::vector<double>& timings);
 
+        /** @brief Enables or disables collection of detailed per-layer profile.
+         *
+         * When enabled, each forward pass records wall time, number of threads, FLOPs and input/output bytes
+         * of every executed layer. Enabling resets previously collected records. Layers fused with others are not reported.
+         * @param enable true to start profiling.
+         * @see getProfile(), dumpProfile()
+         */
+        CV_WRAP void enableProfiling(bool enable = true);
+
+        /** @brief Returns records collected since profiling was enabled, in order of execution. */
+        std::vector<LayerProfile> getProfile() const;
+
+        /** @brief Dump collected profile to String in Chrome trace event format
+         *  @returns JSON which can be opened by chrome://tracing or Perfetto UI
+         *  @see enableProfiling()
+         */
+        CV_WRAP String dumpProfile() const;
+        /** @brief Dump collected profile to file in Chrome trace event format
+         *  @param path   path to output file with .json extension
+         *  @see dumpProfile()
+         */
+        CV_WRAP void dumpProfileToFile(const String& path) const;
+
 
         struct Impl;
         inline Impl* getImpl() const { return impl.get(); }
@@ -1194,6 +1291,36 @@ CV__DNN_INLINE_NS_BEGIN
                              CV_OUT std::vector<int>& indices,
                              const float eta = 1.f, const int top_k = 0);
 
+    /** @brief Performs batched non maximum suppression on given boxes and corresponding scores across different classes.
+     *
+     * Boxes of different classes never suppress each other. Classes are processed in parallel.
+     * Detections of a batch of images may be processed by a single call if @p class_ids combine
+     * indices of images and classes, for example `imageId * numClasses + classId`.
+     *
+     * @param bboxes a set of bounding boxes to apply NMS.
+     * @param scores a set of corresponding confidences.
+     * @param class_ids a set of corresponding class ids.
+     * @param score_threshold a threshold used to filter boxes by score.
+     * @param nms_threshold a threshold used in non maximum suppression.
+     * @param indices the kept indices of bboxes after NMS sorted by scores.
+     * @param eta a coefficient in adaptive threshold formula: \f$nms\_threshold_{i+1}=eta\cdot nms\_threshold_i\f$,
+     * the threshold is adapted for every class separately.
+     * @param top_k if `>0`, keep at most @p top_k picked indices.
+     */
+    CV_EXPORTS void NMSBoxesBatched(const std::vector<Rect>& bboxes, const std::vector<float>& scores,
+                                    const std::vector<int>& class_ids, const float score_threshold,
+                                    const float nms_threshold, CV_OUT std::vector<int>& indices,
+                                    const float eta = 1.f, const int top_k = 0);
+
+    /** @overload
+     *
+     * Boxes are processed in double precision. Boxes with equal scores are returned in order of their indices.
+     */
+    CV_EXPORTS_W void NMSBoxesBatched(const std::vector<Rect2d>& bboxes, const std::vector<float>& scores,
+                                      const std::vector<int>& class_ids, const float score_threshold,
+                                      const float nms_threshold, CV_OUT std::vector<int>& indices,
+                                      const float eta = 1.f, const int top_k = 0);
+
     /**
      * @brief Enum of Soft NMS methods.
      * @see softNMSBoxes
@@ -1764,6 +1891,46 @@ public:
     CV_WRAP int getMaxCandidates() const;
 };
 
+/** @brief This class assembles dynamic batches from single-sample requests of many threads.
+ *
+ * BatchingExecutor owns a network and runs it in a dedicated thread. Incoming requests are queued
+ * and combined into a batch of up to @p maxBatchSize samples. A batch is executed as soon as it is full
+ * or when its first request has waited for @p maxDelayUs microseconds. Only requests with the same
+ * input shape, type and output name are batched together. Outputs are scattered back to the callers
+ * through AsyncArray futures.
+ *
+ * The network must have a single input and its outputs must have batch size as the first dimension.
+ * The network must not be used directly while it is owned by the executor.
+ */
+class CV_EXPORTS BatchingExecutor
+{
+public:
+    /**
+     * @brief Creates executor and starts its thread.
+     * @param[in] network Net object.
+     * @param[in] maxBatchSize Maximal number of samples in a batch.
+     * @param[in] maxDelayUs Maximal time in microseconds to wait for a batch to fill up.
+     */
+    BatchingExecutor(const Net& network, int maxBatchSize = 8, int64 maxDelayUs = 1000);
+
+    /** @brief Processes all pending requests and stops the executor thread. */
+    ~BatchingExecutor();
+
+    /** @brief Enqueues a request to compute output of layer with name @p outputName.
+     *  @param[in] blob Input blob with batch size 1.
+     *  @param[in] outputName Name for layer which output is needed to get. By default the last layer is used.
+     *  @returns future with the first output of the specified layer for the given sample.
+     */
+    AsyncArray forwardAsync(InputArray blob, const String& outputName = String());
+
+    /** @brief Synchronous version of forwardAsync(). Blocks until the result is ready. */
+    Mat forward(InputArray blob, const String& outputName = String());
+
+    struct Impl;
+protected:
+    Ptr<Impl> impl;
+};
+
 //! @}
 CV__DNN_INLINE_NS_END
 }
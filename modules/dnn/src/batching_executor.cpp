@@ -0,0 +1,227 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <opencv2/core/detail/async_promise.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+struct BatchingExecutor::Impl
+{
+    struct Request
+    {
+        Mat blob;
+        String outputName;
+        AsyncPromise promise;
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        std::chrono::steady_clock::time_point arrival;
+#endif
+
+        // Requests are batched together if they have the same input layout and requested output
+        bool compatible(const Request& other) const
+        {
+            return blob.type() == other.blob.type() && shape(blob) == shape(other.blob) &&
+                   outputName == other.outputName;
+        }
+    };
+
+    Net net;
+    int maxBatchSize;
+    int64 maxDelayUs;
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque< Ptr<Request> > queue;
+    bool stopped;
+    std::thread worker;
+#endif
+
+    Impl(const Net& network, int maxBatchSize_, int64 maxDelayUs_)
+        : net(network)
+        , maxBatchSize(maxBatchSize_)
+        , maxDelayUs(maxDelayUs_)
+    {
+        CV_Assert(!net.empty());
+        CV_CheckGE(maxBatchSize, 1, "");
+        CV_Assert(maxDelayUs >= 0);
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        stopped = false;
+        worker = std::thread(&Impl::run, this);
+#endif
+    }
+
+    ~Impl()
+    {
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        cond.notify_all();
+        worker.join();
+#endif
+    }
+
+    AsyncArray enqueue(InputArray blob, const String& outputName)
+    {
+        Ptr<Request> request = makePtr<Request>();
+        blob.getMat().copyTo(request->blob);  // guarantees continuous data owned by the request
+        CV_CheckGE(request->blob.dims, 1, "");
+        CV_CheckEQ(request->blob.size[0], 1, "DNN/BatchingExecutor: input blob must have batch size 1");
+        request->outputName = outputName;
+        AsyncArray result = request->promise.getArrayResult();
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        request->arrival = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            CV_Assert(!stopped);
+            queue.push_back(request);
+        }
+        cond.notify_all();
+#else
+        process(std::vector< Ptr<Request> >(1, request));
+#endif
+        return result;
+    }
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+    int countCompatible(const Request& first) const
+    {
+        int count = 0;
+        for (size_t i = 0; i < queue.size() && count < maxBatchSize; ++i)
+        {
+            if (first.compatible(*queue[i]))
+                count++;
+        }
+        return count;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            cond.wait(lock, [this]() { return stopped || !queue.empty(); });
+            if (queue.empty())
+                return;  // stopped, all requests are processed
+
+            // Wait for the batch to fill up unless the first request is out of time.
+            Ptr<Request> first = queue.front();
+            const std::chrono::steady_clock::time_point deadline = first->arrival + std::chrono::microseconds(maxDelayUs);
+            while (!stopped && countCompatible(*first) < maxBatchSize)
+            {
+                if (cond.wait_until(lock, deadline) == std::cv_status::timeout)
+                    break;
+            }
+
+            std::vector< Ptr<Request> > batch;
+            for (std::deque< Ptr<Request> >::iterator it = queue.begin(); it != queue.end() && (int)batch.size() < maxBatchSize;)
+            {
+                if (first->compatible(**it))
+                {
+                    batch.push_back(*it);
+                    it = queue.erase(it);
+                }
+                else
+                    ++it;
+            }
+
+            lock.unlock();
+            process(batch);
+            lock.lock();
+        }
+    }
+#endif
+
+    void process(const std::vector< Ptr<Request> >& batch)
+    {
+        CV_TRACE_FUNCTION();
+        CV_Assert(!batch.empty());
+        try
+        {
+            const int batchSize = (int)batch.size();
+            const Mat& sample = batch[0]->blob;
+            const size_t sampleBytes = sample.total() * sample.elemSize();
+
+            MatShape inputShape = shape(sample);
+            inputShape[0] = batchSize;
+            Mat input(inputShape, sample.type());
+            for (int i = 0; i < batchSize; ++i)
+                std::memcpy(input.ptr() + i * sampleBytes, batch[i]->blob.ptr(), sampleBytes);
+
+            net.setInput(input);
+            Mat output = net.forward(batch[0]->outputName);
+            CV_Assert(output.isContinuous());
+            CV_CheckGE(output.dims, 1, "");
+            CV_CheckEQ(output.size[0], batchSize, "DNN/BatchingExecutor: output must have batch size as the first dimension");
+
+            MatShape outputShape = shape(output);
+            outputShape[0] = 1;
+            const size_t outputBytes = output.total() * output.elemSize() / batchSize;
+            for (int i = 0; i < batchSize; ++i)
+            {
+                Mat result(outputShape, output.type(), output.ptr() + i * outputBytes);
+                batch[i]->promise.setValue(result.clone());
+            }
+        }
+        catch (const cv::Exception& e)
+        {
+            CV_LOG_DEBUG(NULL, "DNN/BatchingExecutor: batch of " << batch.size() << " requests failed: " << e.what());
+            for (size_t i = 0; i < batch.size(); ++i)
+                batch[i]->promise.setException(e);
+        }
+#if CV__EXCEPTION_PTR
+        catch (...)
+        {
+            std::exception_ptr e = std::current_exception();
+            for (size_t i = 0; i < batch.size(); ++i)
+                batch[i]->promise.setException(e);
+        }
+#endif
+    }
+};
+
+
+BatchingExecutor::BatchingExecutor(const Net& network, int maxBatchSize, int64 maxDelayUs)
+    : impl(makePtr<BatchingExecutor::Impl>(network, maxBatchSize, maxDelayUs))
+{
+    // nothing
+}
+
+BatchingExecutor::~BatchingExecutor()
+{
+    // nothing
+}
+
+AsyncArray BatchingExecutor::forwardAsync(InputArray blob, const String& outputName)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->enqueue(blob, outputName);
+}
+
+Mat BatchingExecutor::forward(InputArray blob, const String& outputName)
+{
+    CV_TRACE_FUNCTION();
+    Mat result;
+    forwardAsync(blob, outputName).get(result);
+    return result;
+}
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
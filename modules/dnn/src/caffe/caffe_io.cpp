@@ -104,6 +104,7 @@
 
 #include "caffe_io.hpp"
 #include "glog_emulator.hpp"
+#include "../mapped_file.hpp"
 
 namespace cv {
 namespace dnn {
@@ -1134,9 +1135,11 @@ bool ReadProtoFromTextFile(const char* filename, Message* proto) {
 }
 
 bool ReadProtoFromBinaryFile(const char* filename, Message* proto) {
-    std::ifstream fs(filename, std::ifstream::in | std::ifstream::binary);
-    CHECK(fs.is_open()) << "Can't open \"" << filename << "\"";
-    IstreamInputStream raw_input(&fs);
+    Ptr<MappedFile> file = MappedFile::open(filename);
+    CHECK(file) << "Can't open \"" << filename << "\"";
+    if (file->size() > (size_t)kProtoReadBytesLimit)
+        return false;
+    ArrayInputStream raw_input(file->data(), (int)file->size());
 
     return ReadProtoFromBinary(&raw_input, proto);
 }
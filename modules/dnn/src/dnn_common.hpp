@@ -13,7 +13,7 @@
 namespace cv { namespace dnn {
 CV__DNN_INLINE_NS_BEGIN
 #define IS_DNN_OPENCL_TARGET(id) (id == DNN_TARGET_OPENCL || id == DNN_TARGET_OPENCL_FP16)
-#define IS_DNN_CPU_TARGET(id) (id == DNN_TARGET_CPU) // TODO: add DNN_TARGET_CPU_FP16
+#define IS_DNN_CPU_TARGET(id) (id == DNN_TARGET_CPU || id == DNN_TARGET_CPU_FP16)
 Mutex& getInitializationMutex();
 void initializeLayerFactory();
 
@@ -36,6 +36,18 @@ bool getParam_DNN_OPENCL_ALLOW_ALL_DEVICES();
 
 int getParam_DNN_BACKEND_DEFAULT();
 
+/// Number of execution contexts used by Net::forwardAsync() on DNN_BACKEND_OPENCV
+size_t getParam_DNN_ASYNC_CONTEXTS();
+
+/// Map model files into memory instead of reading them (zero-copy load of external data)
+bool getParam_DNN_MODEL_MMAP();
+
+/// Number of cached execution plans for different input shapes (see Net::setShapePlanCacheSize())
+size_t getParam_DNN_SHAPE_PLAN_CACHE_SIZE();
+
+/// Maximal memory used by the cached execution plans for different input shapes
+size_t getParam_DNN_SHAPE_PLAN_CACHE_MAX_BYTES();
+
 // Additional checks (slowdowns execution!)
 bool getParam_DNN_CHECK_NAN_INF();
 bool getParam_DNN_CHECK_NAN_INF_DUMP();
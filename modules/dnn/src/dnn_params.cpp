@@ -41,6 +41,30 @@ int getParam_DNN_BACKEND_DEFAULT()
     return PARAM_DNN_BACKEND_DEFAULT;
 }
 
+size_t getParam_DNN_ASYNC_CONTEXTS()
+{
+    static size_t DNN_ASYNC_CONTEXTS = utils::getConfigurationParameterSizeT("OPENCV_DNN_ASYNC_CONTEXTS", 2);
+    return DNN_ASYNC_CONTEXTS;
+}
+
+bool getParam_DNN_MODEL_MMAP()
+{
+    static bool DNN_MODEL_MMAP = utils::getConfigurationParameterBool("OPENCV_DNN_MODEL_MMAP", true);
+    return DNN_MODEL_MMAP;
+}
+
+size_t getParam_DNN_SHAPE_PLAN_CACHE_SIZE()
+{
+    static size_t DNN_SHAPE_PLAN_CACHE_SIZE = utils::getConfigurationParameterSizeT("OPENCV_DNN_SHAPE_PLAN_CACHE_SIZE", 0);
+    return DNN_SHAPE_PLAN_CACHE_SIZE;
+}
+
+size_t getParam_DNN_SHAPE_PLAN_CACHE_MAX_BYTES()
+{
+    static size_t DNN_SHAPE_PLAN_CACHE_MAX_BYTES = utils::getConfigurationParameterSizeT("OPENCV_DNN_SHAPE_PLAN_CACHE_MAX_BYTES", 16 << 20);
+    return DNN_SHAPE_PLAN_CACHE_MAX_BYTES;
+}
+
 // Additional checks (slowdowns execution!)
 bool getParam_DNN_CHECK_NAN_INF()
 {
@@ -5,6 +5,7 @@
 #include "precomp.hpp"
 
 #include <opencv2/imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
 
 
 namespace cv {
@@ -38,6 +39,212 @@ Mat blobFromImages(InputArrayOfArrays images, double scalefactor, Size size,
     return blob;
 }
 
+namespace {
+
+// Converts a row of interleaved pixels to planes of the blob: dst = (src - mean) * scale.
+// Destination planes are already swapped, the mean is in order of the planes.
+template<typename T, typename D>
+static void convertRowToPlanes(const T* src, D* const* dst, int width, int nch, const float* mean, float scale)
+{
+    for (int c = 0; c < nch; ++c)
+    {
+        const T* s = src + c;
+        D* d = dst[c];
+        const float m = mean[c];
+        for (int x = 0; x < width; ++x, s += nch)
+            d[x] = saturate_cast<D>((s[0] - m) * scale);
+    }
+}
+
+#if CV_SIMD
+static inline void storeNormalized(float* dst, const v_uint8& v, const v_float32& m, const v_float32& s)
+{
+    const int nlanes = v_float32::nlanes;
+    v_uint16 w0, w1;
+    v_expand(v, w0, w1);
+    v_uint32 d0, d1, d2, d3;
+    v_expand(w0, d0, d1);
+    v_expand(w1, d2, d3);
+    v_store(dst, (v_cvt_f32(v_reinterpret_as_s32(d0)) - m) * s);
+    v_store(dst + nlanes, (v_cvt_f32(v_reinterpret_as_s32(d1)) - m) * s);
+    v_store(dst + nlanes * 2, (v_cvt_f32(v_reinterpret_as_s32(d2)) - m) * s);
+    v_store(dst + nlanes * 3, (v_cvt_f32(v_reinterpret_as_s32(d3)) - m) * s);
+}
+#endif
+
+static void convertRow(const uchar* src, float* const* dst, int width, int nch, const float* mean, float scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int vlanes = v_uint8::nlanes;
+    const v_float32 s = vx_setall_f32(scale);
+    const v_float32 m0 = vx_setall_f32(mean[0]);
+    if (nch == 1)
+    {
+        for (; x <= width - vlanes; x += vlanes)
+            storeNormalized(dst[0] + x, vx_load(src + x), m0, s);
+    }
+    else if (nch == 3)
+    {
+        const v_float32 m1 = vx_setall_f32(mean[1]), m2 = vx_setall_f32(mean[2]);
+        for (; x <= width - vlanes; x += vlanes)
+        {
+            v_uint8 a, b, c;
+            v_load_deinterleave(src + x * 3, a, b, c);
+            storeNormalized(dst[0] + x, a, m0, s);
+            storeNormalized(dst[1] + x, b, m1, s);
+            storeNormalized(dst[2] + x, c, m2, s);
+        }
+    }
+    else if (nch == 4)
+    {
+        const v_float32 m1 = vx_setall_f32(mean[1]), m2 = vx_setall_f32(mean[2]), m3 = vx_setall_f32(mean[3]);
+        for (; x <= width - vlanes; x += vlanes)
+        {
+            v_uint8 a, b, c, d;
+            v_load_deinterleave(src + x * 4, a, b, c, d);
+            storeNormalized(dst[0] + x, a, m0, s);
+            storeNormalized(dst[1] + x, b, m1, s);
+            storeNormalized(dst[2] + x, c, m2, s);
+            storeNormalized(dst[3] + x, d, m3, s);
+        }
+    }
+#endif
+    if (x < width)
+    {
+        float* tail[4];
+        for (int c = 0; c < nch; ++c)
+            tail[c] = dst[c] + x;
+        convertRowToPlanes(src + x * nch, tail, width - x, nch, mean, scale);
+    }
+}
+
+static void convertRow(const float* src, float* const* dst, int width, int nch, const float* mean, float scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int vlanes = v_float32::nlanes;
+    const v_float32 s = vx_setall_f32(scale);
+    const v_float32 m0 = vx_setall_f32(mean[0]);
+    if (nch == 1)
+    {
+        for (; x <= width - vlanes; x += vlanes)
+            v_store(dst[0] + x, (vx_load(src + x) - m0) * s);
+    }
+    else if (nch == 3)
+    {
+        const v_float32 m1 = vx_setall_f32(mean[1]), m2 = vx_setall_f32(mean[2]);
+        for (; x <= width - vlanes; x += vlanes)
+        {
+            v_float32 a, b, c;
+            v_load_deinterleave(src + x * 3, a, b, c);
+            v_store(dst[0] + x, (a - m0) * s);
+            v_store(dst[1] + x, (b - m1) * s);
+            v_store(dst[2] + x, (c - m2) * s);
+        }
+    }
+    else if (nch == 4)
+    {
+        const v_float32 m1 = vx_setall_f32(mean[1]), m2 = vx_setall_f32(mean[2]), m3 = vx_setall_f32(mean[3]);
+        for (; x <= width - vlanes; x += vlanes)
+        {
+            v_float32 a, b, c, d;
+            v_load_deinterleave(src + x * 4, a, b, c, d);
+            v_store(dst[0] + x, (a - m0) * s);
+            v_store(dst[1] + x, (b - m1) * s);
+            v_store(dst[2] + x, (c - m2) * s);
+            v_store(dst[3] + x, (d - m3) * s);
+        }
+    }
+#endif
+    if (x < width)
+    {
+        float* tail[4];
+        for (int c = 0; c < nch; ++c)
+            tail[c] = dst[c] + x;
+        convertRowToPlanes(src + x * nch, tail, width - x, nch, mean, scale);
+    }
+}
+
+static void convertRow(const uchar* src, uchar* const* dst, int width, int nch, const float*, float)
+{
+    int x = 0;
+#if CV_SIMD
+    const int vlanes = v_uint8::nlanes;
+    if (nch == 3)
+    {
+        for (; x <= width - vlanes; x += vlanes)
+        {
+            v_uint8 a, b, c;
+            v_load_deinterleave(src + x * 3, a, b, c);
+            v_store(dst[0] + x, a);
+            v_store(dst[1] + x, b);
+            v_store(dst[2] + x, c);
+        }
+    }
+    else if (nch == 4)
+    {
+        for (; x <= width - vlanes; x += vlanes)
+        {
+            v_uint8 a, b, c, d;
+            v_load_deinterleave(src + x * 4, a, b, c, d);
+            v_store(dst[0] + x, a);
+            v_store(dst[1] + x, b);
+            v_store(dst[2] + x, c);
+            v_store(dst[3] + x, d);
+        }
+    }
+#endif
+    for (; x < width; ++x)
+    {
+        for (int c = 0; c < nch; ++c)
+            dst[c][x] = src[x * nch + c];
+    }
+}
+
+// Writes rows of all the images into the blob in parallel: mean subtraction, scaling,
+// swap of R and B channels and HWC to NCHW transposition are done in a single pass.
+template<typename T, typename D>
+class BlobFromImagesInvoker : public ParallelLoopBody
+{
+public:
+    BlobFromImagesInvoker(const std::vector<Mat>& images_, Mat& blob_, const Scalar& mean_, double scale_, bool swapRB_)
+        : images(images_), blob(blob_), scale((float)scale_), swapRB(swapRB_)
+    {
+        for (int c = 0; c < 4; ++c)
+            mean[c] = (float)mean_[c];
+    }
+
+    void operator()(const Range& r) const CV_OVERRIDE
+    {
+        const int nch = blob.size[1], rows = blob.size[2], width = blob.size[3];
+        for (int row = r.start; row < r.end; ++row)
+        {
+            const int i = row / rows, y = row % rows;
+            D* dst[4];
+            for (int c = 0; c < nch; ++c)
+                dst[c] = blob.ptr<D>(i, c) + (size_t)y * width;
+            if (swapRB && nch >= 3)
+                std::swap(dst[0], dst[2]);
+            // mean is specified in order of the blob channels. It's swapped for 1-channel images too:
+            // mean[2] is subtracted from them as it has always been done.
+            float m[4] = { mean[0], mean[1], mean[2], mean[3] };
+            if (swapRB)
+                std::swap(m[0], m[2]);
+            convertRow(images[i].ptr<T>(y), dst, width, nch, m, scale);
+        }
+    }
+
+private:
+    const std::vector<Mat>& images;
+    Mat& blob;
+    float mean[4];
+    float scale;
+    bool swapRB;
+};
+
+}  // namespace
+
 void blobFromImages(InputArrayOfArrays images_, OutputArray blob_, double scalefactor,
         Size size, const Scalar& mean_, bool swapRB, bool crop, int ddepth)
 {
@@ -72,60 +279,37 @@ void blobFromImages(InputArrayOfArrays images_, OutputArray blob_, double scalef
             else
                 resize(images[i], images[i], size, 0, 0, INTER_LINEAR);
         }
-        if (images[i].depth() == CV_8U && ddepth == CV_32F)
+        // The rest of the preprocessing is done by a single pass below
+        if (images[i].depth() != CV_8U && images[i].depth() != CV_32F)
             images[i].convertTo(images[i], CV_32F);
-        Scalar mean = mean_;
-        if (swapRB)
-            std::swap(mean[0], mean[2]);
-
-        images[i] -= mean;
-        images[i] *= scalefactor;
     }
 
     size_t nimages = images.size();
     Mat image0 = images[0];
     int nch = image0.channels();
     CV_Assert(image0.dims == 2);
-    if (nch == 3 || nch == 4)
+    CV_Assert(nch == 1 || nch == 3 || nch == 4);
+    for (size_t i = 0; i < nimages; i++)
     {
-        int sz[] = { (int)nimages, nch, image0.rows, image0.cols };
-        blob_.create(4, sz, ddepth);
-        Mat blob = blob_.getMat();
-        Mat ch[4];
-
-        for (size_t i = 0; i < nimages; i++)
-        {
-            const Mat& image = images[i];
-            CV_Assert(image.depth() == blob_.depth());
-            nch = image.channels();
-            CV_Assert(image.dims == 2 && (nch == 3 || nch == 4));
-            CV_Assert(image.size() == image0.size());
-
-            for (int j = 0; j < nch; j++)
-                ch[j] = Mat(image.rows, image.cols, ddepth, blob.ptr((int)i, j));
-            if (swapRB)
-                std::swap(ch[0], ch[2]);
-            split(image, ch);
-        }
+        const Mat& image = images[i];
+        CV_Assert(image.dims == 2 && image.channels() == nch);
+        CV_Assert(image.size() == image0.size());
+        CV_Assert(image.depth() == ddepth || (image.depth() == CV_8U && ddepth == CV_32F));
     }
-    else
-    {
-        CV_Assert(nch == 1);
-        int sz[] = { (int)nimages, 1, image0.rows, image0.cols };
-        blob_.create(4, sz, ddepth);
-        Mat blob = blob_.getMat();
 
-        for (size_t i = 0; i < nimages; i++)
-        {
-            const Mat& image = images[i];
-            CV_Assert(image.depth() == blob_.depth());
-            nch = image.channels();
-            CV_Assert(image.dims == 2 && (nch == 1));
-            CV_Assert(image.size() == image0.size());
+    int sz[] = { (int)nimages, nch, image0.rows, image0.cols };
+    blob_.create(4, sz, ddepth);
+    Mat blob = blob_.getMat();
 
-            image.copyTo(Mat(image.rows, image.cols, ddepth, blob.ptr((int)i, 0)));
-        }
-    }
+    // 4 channels are swapped as BGRA -> RGBA
+    const Range rows(0, (int)nimages * image0.rows);
+    const double nstripes = std::min((double)rows.end, (double)blob.total() / (1 << 16));
+    if (ddepth == CV_8U)
+        parallel_for_(rows, BlobFromImagesInvoker<uchar, uchar>(images, blob, mean_, scalefactor, swapRB), nstripes);
+    else if (image0.depth() == CV_8U)
+        parallel_for_(rows, BlobFromImagesInvoker<uchar, float>(images, blob, mean_, scalefactor, swapRB), nstripes);
+    else
+        parallel_for_(rows, BlobFromImagesInvoker<float, float>(images, blob, mean_, scalefactor, swapRB), nstripes);
 }
 
 void imagesFromBlob(const cv::Mat& blob_, OutputArrayOfArrays images_)
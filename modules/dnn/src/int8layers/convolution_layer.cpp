@@ -564,7 +564,7 @@ public:
     class ParallelConv : public cv::ParallelLoopBody
     {
     public:
-        enum { BLK_SIZE = 32, BLK_SIZE_CN = 64 };
+        enum { BLK_SIZE = 32, BLK_SIZE_CN = 64, BLK_SIZE_1x1 = 128 };
 
         const Mat* input_;
         const Mat* weights_;
@@ -577,6 +577,7 @@ public:
         const Mat* activLUT_;
         const ActivationLayerInt8* activ_;
         bool is1x1_;
+        bool fastConv1x1_;
         bool useAVX2;
         bool useAVX512;
         bool useLASX;
@@ -586,7 +587,7 @@ public:
 
         ParallelConv()
             : input_(0), weights_(0), output_(0), ngroups_(0), nstripes_(0),
-              biasvec_(0), activLUT_(0), activ_(0), is1x1_(false), useAVX2(false), useAVX512(false), useLASX(false)
+              biasvec_(0), activLUT_(0), activ_(0), is1x1_(false), fastConv1x1_(false), useAVX2(false), useAVX512(false), useLASX(false)
             , blk_size_cn(0), inpZp(0), outZp(0), multiplier(0)
         {}
 
@@ -644,6 +645,10 @@ public:
 
             p.useLASX   = checkHardwareSupport(CPU_LASX) && isConv2D;
 
+            // 1x1 convolution with unit strides reads input in place, without im2row
+            p.fastConv1x1_ = p.is1x1_ && isConv2D && strides[0] == 1 && strides[1] == 1 &&
+                             (p.useAVX2 || p.useAVX512 || p.useLASX);
+
             int kernel_d = isConv3D? kernel_size[0] : 1;
             int kernel_h = isConv1D? 1 : kernel_size[kernel_size.size() - 2];
             int kernel_w = kernel_size.back();
@@ -697,6 +702,37 @@ public:
             parallel_for_(Range(0, nstripes), p, nstripes);
         }
 
+    #if CV_TRY_AVX2 || CV_TRY_AVX512_SKX || CV_TRY_LASX
+        void runFastConv1x1(const int8_t* wptr, size_t wstep, const int* biasptr, const float* multptr,
+                            const int8_t* inptr, int inpPlaneSize, int* outptr, int outPlaneSize,
+                            int inpCn, int outCn, int stripeStart, int stripeEnd) const
+        {
+            for( int ofs0 = stripeStart; ofs0 < stripeEnd; ofs0 += BLK_SIZE_1x1 )
+            {
+                int ofs1 = std::min(ofs0 + (int)BLK_SIZE_1x1, stripeEnd);
+            #if CV_TRY_AVX512_SKX
+                if(useAVX512)
+                    opt_AVX512_SKX::fastConv1x1(wptr, wstep, biasptr, multptr, inptr, inpPlaneSize,
+                                                outptr, outPlaneSize, inpCn, outCn, ofs0, ofs1, outZp);
+                else
+            #endif
+            #if CV_TRY_AVX2
+                if(useAVX2)
+                    opt_AVX2::fastConv1x1(wptr, wstep, biasptr, multptr, inptr, inpPlaneSize,
+                                          outptr, outPlaneSize, inpCn, outCn, ofs0, ofs1, outZp);
+                else
+            #endif
+            #if CV_TRY_LASX
+                if(useLASX)
+                    opt_LASX::fastConv1x1(wptr, wstep, biasptr, multptr, inptr, inpPlaneSize,
+                                          outptr, outPlaneSize, inpCn, outCn, ofs0, ofs1, outZp);
+                else
+            #endif
+                    CV_Error(Error::StsInternal, "DNN/Int8: fast 1x1 convolution is not available");
+            }
+        }
+    #endif
+
         virtual void operator ()(const Range &r0) const CV_OVERRIDE
         {
             const int valign = ConvolutionLayerInt8Impl::VEC_ALIGN;
@@ -775,7 +811,7 @@ public:
             int* data_out0_ = output_->ptr<int>();
             AutoBuffer<int8_t> rowbuf0_;
             int8_t* rowbuf0 = 0;
-            bool use_rowbuf = !depthWiseConvolution;
+            bool use_rowbuf = !depthWiseConvolution && !fastConv1x1_;
             int blk_size = depthWiseConvolution ? outPlaneSize : min((int)BLK_SIZE, stripeSize);
 
             // im2row buffer is not used for depth-wise convolution
@@ -811,6 +847,12 @@ public:
                 const int* biasptr = biasptr_ + startOutCn;
                 const float* multptr = multptr_ + startOutCn;
 
+            #if CV_TRY_AVX2 || CV_TRY_AVX512_SKX || CV_TRY_LASX
+                if( fastConv1x1_ )
+                    runFastConv1x1(wptr_orig, wstep, biasptr, multptr, data_inp0, inpPlaneSize,
+                                   data_out0, outPlaneSize, inpCn, outCn, stripeStart, stripeEnd);
+                else
+            #endif
                 for( int cn0 = 0; cn0 < inpCn; cn0 += blk_size_cn )
                 {
                     int cn1 = std::min(cn0 + blk_size_cn, inpCn);
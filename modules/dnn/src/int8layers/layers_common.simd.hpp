@@ -26,6 +26,10 @@ void fastDepthwiseConv( const int8_t* wptr,
 void fastGEMM1T( const int8_t* vec, const int8_t* weights,
                  size_t wstep, const int* bias, const float* multiplier,
                  int* dst, int nvecs, int vecsize, int outZp );
+void fastConv1x1( const int8_t* weights, size_t wstep, const int* bias,
+                  const float* multiplier, const int8_t* input, size_t inpPlaneSize,
+                  int* output, size_t outPlaneSize, int inpCn, int outCn,
+                  int ofs0, int ofs1, int outZp );
 
 #if !defined(CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY) && CV_AVX2
 #define OPENCV_FMADD_EPI8(_Tpvec, func) \
@@ -1257,5 +1261,108 @@ void fastGEMM1T( const int8_t* vec, const int8_t* weights,
 }
 #endif // CV_LASX
 
+#if !defined(CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY) && (CV_AVX2 || CV_LASX)
+
+// 1x1 convolution with unit strides is a GEMM of weights [outCn x inpCn] by input [inpCn x planeSize].
+// Input is used in place (no im2row), pairs of input channels are interleaved to compute
+// 2 products per 32-bit lane by one v_dotprod (i.e. pmaddwd).
+enum { FASTCONV1x1_OUT_BLOCK = 4 };
+
+void fastConv1x1( const int8_t* weights, size_t wstep, const int* bias,
+                  const float* multiplier, const int8_t* input, size_t inpPlaneSize,
+                  int* output, size_t outPlaneSize, int inpCn, int outCn,
+                  int ofs0, int ofs1, int outZp )
+{
+    const int nlanes16 = v_int16::nlanes, nlanes32 = v_int32::nlanes;
+    const v_int32 voutzp = vx_setall_s32(outZp), outmin = vx_setall_s32(-128), outmax = vx_setall_s32(127);
+    const v_int16 vzero = vx_setzero_s16();
+
+    for( int i = 0; i < outCn; i += FASTCONV1x1_OUT_BLOCK )
+    {
+        const int8_t* wptr[FASTCONV1x1_OUT_BLOCK];
+        int* outptr[FASTCONV1x1_OUT_BLOCK];
+        int biasval[FASTCONV1x1_OUT_BLOCK];
+        float mult[FASTCONV1x1_OUT_BLOCK];
+        for( int r = 0; r < FASTCONV1x1_OUT_BLOCK; r++ )
+        {
+            // the tail of output channels is computed in the last row again
+            int i1 = std::min(i + r, outCn - 1);
+            wptr[r] = weights + i1*wstep;
+            outptr[r] = output + i1*outPlaneSize;
+            biasval[r] = bias[i1];
+            mult[r] = multiplier[i1];
+        }
+
+        int j = ofs0;
+        for( ; j <= ofs1 - nlanes16; j += nlanes16 )
+        {
+            v_int32 s00 = vx_setzero_s32(), s01 = vx_setzero_s32(), s10 = vx_setzero_s32(), s11 = vx_setzero_s32(),
+                    s20 = vx_setzero_s32(), s21 = vx_setzero_s32(), s30 = vx_setzero_s32(), s31 = vx_setzero_s32();
+            const int8_t* inptr = input + j;
+            int k = 0;
+            for( ; k < inpCn; k += 2, inptr += inpPlaneSize*2 )
+            {
+                v_int16 x0 = vx_load_expand(inptr), x1, xl, xh;
+                int w0[FASTCONV1x1_OUT_BLOCK], w1[FASTCONV1x1_OUT_BLOCK];
+                if( k + 1 < inpCn )
+                {
+                    x1 = vx_load_expand(inptr + inpPlaneSize);
+                    for( int r = 0; r < FASTCONV1x1_OUT_BLOCK; r++ )
+                    {
+                        w0[r] = wptr[r][k];
+                        w1[r] = wptr[r][k + 1];
+                    }
+                }
+                else
+                {
+                    x1 = vzero;
+                    for( int r = 0; r < FASTCONV1x1_OUT_BLOCK; r++ )
+                    {
+                        w0[r] = wptr[r][k];
+                        w1[r] = 0;
+                    }
+                }
+                v_zip(x0, x1, xl, xh);
+
+                // (w0, w1) pairs of int16 packed into int32 lanes
+                v_int16 vw0 = v_reinterpret_as_s16(vx_setall_s32((w0[0] & 0xffff) | (w1[0] << 16)));
+                v_int16 vw1 = v_reinterpret_as_s16(vx_setall_s32((w0[1] & 0xffff) | (w1[1] << 16)));
+                v_int16 vw2 = v_reinterpret_as_s16(vx_setall_s32((w0[2] & 0xffff) | (w1[2] << 16)));
+                v_int16 vw3 = v_reinterpret_as_s16(vx_setall_s32((w0[3] & 0xffff) | (w1[3] << 16)));
+                s00 = v_dotprod(xl, vw0, s00); s01 = v_dotprod(xh, vw0, s01);
+                s10 = v_dotprod(xl, vw1, s10); s11 = v_dotprod(xh, vw1, s11);
+                s20 = v_dotprod(xl, vw2, s20); s21 = v_dotprod(xh, vw2, s21);
+                s30 = v_dotprod(xl, vw3, s30); s31 = v_dotprod(xh, vw3, s31);
+            }
+
+            v_int32 s[FASTCONV1x1_OUT_BLOCK][2] = {{s00, s01}, {s10, s11}, {s20, s21}, {s30, s31}};
+            for( int r = 0; r < FASTCONV1x1_OUT_BLOCK; r++ )
+            {
+                v_int32 vbias = vx_setall_s32(biasval[r]);
+                v_float32 vmult = vx_setall_f32(mult[r]);
+                v_int32 out0 = voutzp + v_round(v_cvt_f32(s[r][0] + vbias)*vmult);
+                v_int32 out1 = voutzp + v_round(v_cvt_f32(s[r][1] + vbias)*vmult);
+                v_store(outptr[r] + j, v_min(v_max(out0, outmin), outmax));
+                v_store(outptr[r] + j + nlanes32, v_min(v_max(out1, outmin), outmax));
+            }
+        }
+
+        for( ; j < ofs1; j++ )
+        {
+            for( int r = 0; r < FASTCONV1x1_OUT_BLOCK; r++ )
+            {
+                int sum = biasval[r];
+                const int8_t* inptr = input + j;
+                for( int k = 0; k < inpCn; k++, inptr += inpPlaneSize )
+                    sum += (int)wptr[r][k] * inptr[0];
+                int out = outZp + (int)std::round(sum*mult[r]);
+                outptr[r][j] = std::min(std::max(out, -128), 127);
+            }
+        }
+    }
+    vx_cleanup();
+}
+#endif // CV_AVX2 || CV_LASX
+
 CV_CPU_OPTIMIZATION_NAMESPACE_END
 }} // namespace
@@ -93,6 +93,9 @@ struct LayerData
     std::map<int, Ptr<BackendNode>> backendNodes;
     // Flag for skip layer computation for specific backend.
     bool skip;
+    // Computes this layer instead of layerInstance: together with the preceding skipped element-wise layers
+    // (see fuseElementwiseChains()) or for data in another layout (see removeLayoutRoundTrips()).
+    Ptr<Layer> fusedLayer;
 
     int flag;
 
@@ -103,6 +106,7 @@ struct LayerData
             return;  // skip "input" layer (assertion in Net::Impl::allocateLayers)
 
         layerInstance.release();
+        fusedLayer.release();
         outputBlobs.clear();
         inputBlobs.clear();
         internals.clear();
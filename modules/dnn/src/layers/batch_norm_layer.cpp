@@ -172,7 +172,7 @@ public:
     {
 #ifdef HAVE_INF_ENGINE
         if (backendId == DNN_BACKEND_INFERENCE_ENGINE_NGRAPH)
-            return preferableTarget == DNN_TARGET_CPU || dims == 4;
+            return IS_DNN_CPU_TARGET(preferableTarget) || dims == 4;
 #endif
         return (backendId == DNN_BACKEND_OPENCV) ||
                backendId == DNN_BACKEND_CUDA ||
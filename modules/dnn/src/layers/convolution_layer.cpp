@@ -260,6 +260,7 @@ public:
     Ptr<ActivationLayer> activ;
 
     Ptr<FastConv2d> fastConv2dImpl;
+    bool fastConv2dOutdated;  // packed weights must be looked up again, see finalize()
 
 #ifdef HAVE_OPENCL
     Ptr<OCL4DNNConvSpatial<float> > convolutionOp;
@@ -282,6 +283,7 @@ public:
 
     ConvolutionLayerImpl(const LayerParams &params) : BaseConvolutionLayerImpl(params)
     {
+        fastConv2dOutdated = false;
 #ifdef HAVE_OPENCL
         newActiv = false;
         activType = OCL4DNN_CONV_FUSED_ACTIV_NONE;
@@ -443,6 +445,9 @@ public:
             // initialized in .forward()
             weightsMat.release();
         }
+        // Packed weights depend on fusion, paddings and preferable target. Current ones are kept
+        // till the next forward() call to be reused by initFastConv2dShared() if nothing has changed.
+        fastConv2dOutdated = true;
 
         weightsMultipliers.assign(numOutput, 1.0);
 
@@ -2098,8 +2103,9 @@ public:
             int nstripes = std::max(getNumThreads(), 1);
 
             // Initialization of FastCovn2d, pack weight.
-            if ((!fastConv2dImpl || variableWeight) && inputs[0].dims == 4)
+            if ((!fastConv2dImpl || fastConv2dOutdated || variableWeight) && inputs[0].dims == 4)
             {
+                fastConv2dOutdated = false;
                 int K = outputs[0].size[1];
                 int C = inputs[0].size[1];
                 int Hk = kernel_size[kernel_size.size() - 2];
@@ -2112,8 +2118,18 @@ public:
                 int dilation_h = dilations[dilations.size() - 2];
                 int dilation_w = dilations.back();
 
-                fastConv2dImpl = initFastConv2d(ngroups, K, C, Hk, Wk, stride_w, stride_h, dilation_w,
-                                                dilation_h, pads_begin, pads_end, weightsMat, &biasvec[0], useWinograd);
+                bool useFP16 = preferableTarget == DNN_TARGET_CPU_FP16;
+                if (variableWeight)
+                    fastConv2dImpl = initFastConv2d(ngroups, K, C, Hk, Wk, stride_w, stride_h, dilation_w,
+                                                    dilation_h, pads_begin, pads_end, weightsMat, &biasvec[0], useWinograd, useFP16);
+                else  // share packed weights with layers of cloned networks
+                    fastConv2dImpl = initFastConv2dShared(ngroups, K, C, Hk, Wk, stride_w, stride_h, dilation_w,
+                                                          dilation_h, pads_begin, pads_end, blobs[0], weightsMultipliers,
+                                                          weightsMat, &biasvec[0], useWinograd, useFP16);
+                // FP16 packed weights are shared by clones of the layer (they are looked up by the FP32 blob),
+                // aligned FP32 weights are not needed anymore: finalize() restores them from the blob
+                if (fastConv2dImpl && fastConv2dImpl->useFP16 && !variableWeight)
+                    weightsMat.release();
             }
 
             if (fastConv2dImpl)
@@ -9,7 +9,7 @@ namespace cv {
 namespace opt_AVX2
 {
 #if CV_TRY_AVX2
-void convBlock_AVX2(int np, const float* a, const float* b, float* c, int ldc, bool init_c)
+void convBlock_AVX2(int np, const float* a, const float* b, int ldb, float* c, int ldc, bool init_c)
 {
 #if CONV_MR == 4 && CONV_NR == 24
     __m256 c00 = _mm256_set1_ps(0.f), c01 = c00, c02 = c00;
@@ -20,10 +20,10 @@ void convBlock_AVX2(int np, const float* a, const float* b, float* c, int ldc, b
     __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
     __m256 b0 = _mm256_setzero_ps(), b1 = _mm256_setzero_ps(), b2 = _mm256_setzero_ps();
 
-    for (int p = 0; p < np; p++, a += CONV_MR, b += CONV_NR)
+    for (int p = 0; p < np; p++, a += CONV_MR, b += ldb)
     {
         a0 = _mm256_set1_ps(a[0]), a1 = _mm256_set1_ps(a[1]);
-        b0 = _mm256_load_ps(b), b1 = _mm256_load_ps(b + 8), b2 = _mm256_load_ps(b + 16);
+        b0 = _mm256_loadu_ps(b), b1 = _mm256_loadu_ps(b + 8), b2 = _mm256_loadu_ps(b + 16);
 
         c00 = _mm256_fmadd_ps(b0, a0, c00);
         c01 = _mm256_fmadd_ps(b1, a0, c01);
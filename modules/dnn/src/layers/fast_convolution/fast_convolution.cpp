@@ -10,6 +10,7 @@
 */
 
 #include "../../precomp.hpp"
+#include "opencv2/core/hal/hal.hpp"
 #include "fast_convolution.hpp"
 #include "fast_convolution.simd.hpp"
 
@@ -24,7 +25,8 @@ Ptr<FastConv2d> initFastConv2d(
         const std::vector<size_t>& pads_end,
         InputArray _weightsMat,
         float* srcBias,
-        bool useWinograd)
+        bool useWinograd,
+        bool useFP16)
 {
     Ptr<FastConv2d> conv = makePtr<FastConv2d>();
 
@@ -46,9 +48,12 @@ Ptr<FastConv2d> initFastConv2d(
     conv->pad_right = pads_end[1];
     conv->conv_type =
             (ngroups > 1 && ngroups == K && ngroups == C) ? _FX_CONV_TYPE_DEPTHWISE :
-            useWinograd && ((conv->useSIMD128 || conv->useAVX2 || conv->useNEON) && Hk == 3 && Wk == 3 &&
+            useWinograd && !useFP16 && ((conv->useSIMD128 || conv->useAVX2 || conv->useNEON) && Hk == 3 && Wk == 3 &&
             dilation_y == 1 && dilation_x == 1 && stride_y == 1 && stride_x == 1) ? _FX_CONV_TYPE_WINOGRAD3X3 :
             _FX_CONV_TYPE_GENERIC;
+    // FP16 storage is used for generic convolutions only, depth-wise weights are small
+    conv->useFP16 = useFP16 && conv->conv_type == _FX_CONV_TYPE_GENERIC;
+    conv->weightsBufPtr_FP16 = 0;
     Mat weightsMat = _weightsMat.getMat();
     auto wShape = shape(weightsMat);
     const size_t wstep = weightsMat.step1();
@@ -192,6 +197,15 @@ Ptr<FastConv2d> initFastConv2d(
                 }
             }
         }});
+
+        if (conv->useFP16)
+        {
+            conv->weightsBuf_FP16.resize(nweights + VEC_ALIGN);
+            conv->weightsBufPtr_FP16 = alignPtr(conv->weightsBuf_FP16.data(), VEC_ALIGN);
+            hal::cvt32f16f(weightsBufPtr, conv->weightsBufPtr_FP16, (int)nweights);
+            std::vector<float>().swap(conv->weightsBuf);  // FP32 weights are not needed anymore
+            conv->weightsBufPtr = 0;
+        }
     }
 
     // store bias; append some zero's to make sure that
@@ -208,6 +222,93 @@ Ptr<FastConv2d> initFastConv2d(
     return conv;
 }
 
+namespace {
+
+struct SharedFastConv2d
+{
+    std::vector<int> params;
+    std::vector<double> weightsMultipliers;
+    std::vector<float> bias;
+    std::weak_ptr<FastConv2d> conv;
+};
+
+// Entries are looked up by the origin weights data. The data can't be reused by another blob
+// while the entry is alive because FastConv2d::originWeights holds a reference to it.
+typedef std::multimap<const uchar*, SharedFastConv2d> SharedFastConv2dCache;
+
+static Mutex& getSharedFastConv2dMutex()
+{
+    static Mutex* mutex = new Mutex();
+    return *mutex;
+}
+
+static SharedFastConv2dCache& getSharedFastConv2dCache()
+{
+    static SharedFastConv2dCache* cache = new SharedFastConv2dCache();
+    return *cache;
+}
+
+}  // namespace
+
+Ptr<FastConv2d> initFastConv2dShared(
+        int ngroups,
+        int K, int C, int Hk, int Wk,
+        int stride_x, int stride_y,
+        int dilation_x, int dilation_y,
+        const std::vector<size_t>& pads_begin,
+        const std::vector<size_t>& pads_end,
+        const Mat& originWeights,
+        const std::vector<double>& weightsMultipliers,
+        InputArray weightsMat,
+        float* srcBias,
+        bool useWinograd,
+        bool useFP16)
+{
+    CV_Assert(!originWeights.empty());
+    CV_Assert(pads_begin.size() >= 2 && pads_end.size() >= 2);
+
+    SharedFastConv2d entry;
+    int params[] = {ngroups, K, C, Hk, Wk, stride_x, stride_y, dilation_x, dilation_y,
+                    (int)pads_begin[0], (int)pads_begin[1], (int)pads_end[0], (int)pads_end[1], (int)useWinograd, (int)useFP16};
+    entry.params.assign(params, params + sizeof(params) / sizeof(params[0]));
+    entry.weightsMultipliers = weightsMultipliers;
+    if (srcBias)
+        entry.bias.assign(srcBias, srcBias + K);
+
+    AutoLock lock(getSharedFastConv2dMutex());
+    SharedFastConv2dCache& cache = getSharedFastConv2dCache();
+    std::pair<SharedFastConv2dCache::iterator, SharedFastConv2dCache::iterator> range = cache.equal_range(originWeights.data);
+    for (SharedFastConv2dCache::iterator it = range.first; it != range.second;)
+    {
+        Ptr<FastConv2d> conv = it->second.conv.lock();
+        if (!conv)
+        {
+            it = cache.erase(it);
+            continue;
+        }
+        if (it->second.params == entry.params && it->second.weightsMultipliers == entry.weightsMultipliers &&
+            it->second.bias == entry.bias)
+            return conv;
+        ++it;
+    }
+
+    // Weights packing runs under the lock, so clones of a network which are initialized
+    // concurrently don't pack the same weights several times.
+    Ptr<FastConv2d> conv = initFastConv2d(ngroups, K, C, Hk, Wk, stride_x, stride_y, dilation_x, dilation_y,
+                                          pads_begin, pads_end, weightsMat, srcBias, useWinograd, useFP16);
+    conv->originWeights = originWeights;
+    entry.conv = conv;
+    for (SharedFastConv2dCache::iterator it = cache.begin(); it != cache.end();)
+    {
+        if (it->second.conv.expired())
+            it = cache.erase(it);
+        else
+            ++it;
+    }
+    cache.insert(std::make_pair((const uchar*)originWeights.data, entry));
+    return conv;
+}
+
 void runFastConv2d(InputArray _input, OutputArray _output, const Ptr<FastConv2d>& conv, int ntasks,
                    const Ptr<ActivationLayer>& actLayer, bool fusedAdd)
 {
@@ -284,6 +385,10 @@ void runFastConv2d(InputArray _input, OutputArray _output, const Ptr<FastConv2d>
 
     int ksize = Hk * Wk;
     bool fast_1x1 = stride_x == 1 && stride_y == 1 && ksize == 1;
+    // In the 1x1 case the full CONV_NR-wide slices are read by the kernels directly from the input tensor.
+    // It's not done if the feature planes are 128-byte aligned: rows of a block of channels would
+    // compete for a few sets of L1 cache, while the packed copy stays in the cache.
+    bool direct_1x1 = fast_1x1 && (inp_planesize * sizeof(float)) % 128 != 0;
     int HkWkCg = Hk*Wk*Cg;
 
     int MAX_STRIPES = 2; // (56 + CONV_NR - 1)/CONV_NR;
@@ -308,7 +413,9 @@ void runFastConv2d(InputArray _input, OutputArray _output, const Ptr<FastConv2d>
     int nsubtasks = N*ngroups*Kstripes;
 
     size_t stripesize = CONV_NR * ksize * Cg;
-    size_t taskbufsize = (stripesize + CONV_NR * K_BLOCK_SIZE) * MAX_STRIPES;
+    // with FP16 weights the task buffer also keeps the current block of weights converted to FP32
+    size_t wbufsize = conv->useFP16 ? (size_t)K_BLOCK_SIZE * C_BLOCK_SIZE : 0;
+    size_t taskbufsize = (stripesize + CONV_NR * K_BLOCK_SIZE) * MAX_STRIPES + wbufsize;
     size_t totalbufsize = taskbufsize * ntasks;
 
     AutoBuffer<float> inpbuf_all_;
@@ -339,6 +446,7 @@ void runFastConv2d(InputArray _input, OutputArray _output, const Ptr<FastConv2d>
     {
         float* inpbuf_task = &inpbuf_all[taskbufsize * task_id];
         float* cbuf_task = inpbuf_task + stripesize * MAX_STRIPES;
+        float* wbuf_task = cbuf_task + CONV_NR * K_BLOCK_SIZE * MAX_STRIPES;
 
         int ngs0 = (int)((size_t)nsubtasks * task_id / ntasks);
         int ngs1 = (int)((size_t)nsubtasks * (task_id+1) / ntasks);
@@ -401,7 +509,11 @@ void runFastConv2d(InputArray _input, OutputArray _output, const Ptr<FastConv2d>
                         // of CONV_NR elements from each feature plane and
                         // put it together.
                         inptr += yx0;
-                        if (!partial)
+                        if (direct_1x1 && !partial)
+                        {
+                            // the slice is read in place by the kernels
+                        }
+                        else if (!partial)
                         {
                             // Make special branch where memcpy() is called with a constant buffer size.
                             // Compilers will likely unroll this loop properly.
@@ -515,7 +627,7 @@ void runFastConv2d(InputArray _input, OutputArray _output, const Ptr<FastConv2d>
                 }
 
                 yx0 = yx0_saved;
-                float* weights = conv->weightsBufPtr + g * Kg_aligned * HkWkCg;
+                float* weights = conv->useFP16 ? 0 : conv->weightsBufPtr + g * Kg_aligned * HkWkCg;
                 const float* biasptr = conv->biasBuf.data() + Kg * g;
                 int ldc = nstripes * CONV_NR;
 
@@ -526,25 +638,45 @@ void runFastConv2d(InputArray _input, OutputArray _output, const Ptr<FastConv2d>
                     for (int c0 = 0; c0 < HkWkCg; c0 += C_BLOCK_SIZE)
                     {
                         int c1 = c0 + C_BLOCK_SIZE < HkWkCg ? c0 + C_BLOCK_SIZE : HkWkCg;
+                        float* wptr0;
+                        size_t wstep = (size_t)HkWkCg * CONV_MR;
+                        if (conv->useFP16)
+                        {
+                            // expand the block of weights once, it's reused by all stripes
+                            const float16_t* wptr_fp16 = conv->weightsBufPtr_FP16 + (g * Kg_aligned + k0_block) * HkWkCg + c0*CONV_MR;
+                            for (int k = k0_block, i = 0; k < k1_block; k += CONV_MR, i++, wptr_fp16 += wstep)
+                                hal::cvt16f32f(wptr_fp16, wbuf_task + i * (c1 - c0) * CONV_MR, (c1 - c0) * CONV_MR);
+                            wptr0 = wbuf_task;
+                            wstep = (size_t)(c1 - c0) * CONV_MR;
+                        }
+                        else
+                            wptr0 = weights + k0_block*HkWkCg + c0*CONV_MR;
                         for (int stripe = 0; stripe < nstripes; stripe++)
                         {
-                            float* wptr = weights + k0_block*HkWkCg + c0*CONV_MR;
+                            float* wptr = wptr0;
                             const float* inptr = inpbuf_task + stripe*stripesize + c0 * CONV_NR;
+                            int ldb = CONV_NR;
+                            int yx_stripe = yx0 + stripe * CONV_NR;
+                            if (direct_1x1 && yx_stripe + CONV_NR <= yx_block_limit)
+                            {
+                                inptr = inp + inp_plane_ofs + c0 * inp_planesize + yx_stripe;
+                                ldb = (int)inp_planesize;
+                            }
                             float* cptr = cbuf_task + stripe * CONV_NR;
                             for (int k = k0_block; k < k1_block; k += CONV_MR,
-                                    wptr += HkWkCg * CONV_MR, cptr += CONV_MR * ldc)
+                                    wptr += wstep, cptr += CONV_MR * ldc)
                             {
 #if CV_TRY_AVX2
                                 if (conv->useAVX2)
-                                    opt_AVX2::convBlock_AVX2(c1 - c0, wptr, inptr, cptr, ldc, c0 == 0);
+                                    opt_AVX2::convBlock_AVX2(c1 - c0, wptr, inptr, ldb, cptr, ldc, c0 == 0);
                                 else
 #endif
 #if CV_TRY_NEON
                                 if (conv->useNEON)
-                                    opt_NEON::convBlock_NEON(c1 - c0, wptr, inptr, cptr, ldc, c0 == 0);
+                                    opt_NEON::convBlock_NEON(c1 - c0, wptr, inptr, ldb, cptr, ldc, c0 == 0);
                                 else
 #endif
-                                    convBlock(c1 - c0, wptr, inptr, cptr, ldc, c0 == 0);
+                                    convBlock(c1 - c0, wptr, inptr, ldb, cptr, ldc, c0 == 0);
                             }
                         }
                     }
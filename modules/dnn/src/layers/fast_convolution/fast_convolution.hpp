@@ -68,10 +68,14 @@ struct FastConv2d
 
     std::vector<float> weightsBuf;     // For generic Conv 2D
     float* weightsBufPtr;
+    std::vector<float16_t> weightsBuf_FP16; // For generic Conv 2D with FP16 weights, replaces weightsBuf
+    float16_t* weightsBufPtr_FP16;
     std::vector<float> weightsWinoBuf; // For Winograd F(6x6, 3x3).
     float* weightsWinoBufPtr;
     std::vector<float> biasBuf;
     int conv_type;
+    bool useFP16;  // packed weights of generic convolution are stored in FP16 (DNN_TARGET_CPU_FP16)
+    Mat originWeights;  // set for instances shared by initFastConv2dShared()
 #if CV_SIMD128
     bool useSIMD128 = true;
 #else
@@ -90,7 +94,21 @@ Ptr<FastConv2d> initFastConv2d(
         const std::vector<size_t>& pads_begin,
         const std::vector<size_t>& pads_end,
         InputArray weightsMat,
-        float* srcBias, bool useWinograd);
+        float* srcBias, bool useWinograd, bool useFP16 = false);
+
+// return a FastConv2d instance, shared between layers which are created from the same weights blob
+// (e.g. layers of cloned networks). Packed weights are computed once as originWeights*weightsMultipliers.
+Ptr<FastConv2d> initFastConv2dShared(
+        int ngroups,
+        int K, int C, int Hk, int Wk,
+        int stride_x, int stride_y,
+        int dilation_x, int dilation_y,
+        const std::vector<size_t>& pads_begin,
+        const std::vector<size_t>& pads_end,
+        const Mat& originWeights,
+        const std::vector<double>& weightsMultipliers,
+        InputArray weightsMat,
+        float* srcBias, bool useWinograd, bool useFP16 = false);
 
 // It contains different computing branches, like winograd, 1x1 conv.
 void runFastConv2d(InputArray _input, OutputArray _output, const Ptr<FastConv2d>& conv, int ntasks,
@@ -107,7 +125,7 @@ void runWinograd63(InputArray _input, InputArray _fusedAddMat, OutputArray _outp
 namespace opt_AVX2
 {
 #if CV_TRY_AVX2
-void convBlock_AVX2(int np, const float* a, const float* b, float* c, int ldc, bool init_c);
+void convBlock_AVX2(int np, const float* a, const float* b, int ldb, float* c, int ldc, bool init_c);
 
 void depthWiseBlock_AVX2(const float *inptr, float *outptr, const float *weights, float biasval, int *ofstab, int *yxtab,
                 float minval, float maxval, int Hi, int Wi, int H0, int W0, int ksize, int pad_top, int pad_left,
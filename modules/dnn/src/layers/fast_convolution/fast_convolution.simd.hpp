@@ -11,7 +11,7 @@
 namespace cv {
 namespace dnn {
 
-void convBlock(int np, const float* a, const float* b, float* c, int ldc, bool init_c)
+void convBlock(int np, const float* a, const float* b, int ldb, float* c, int ldc, bool init_c)
 {
 #if CV_SIMD128 && CONV_MR == 4 && CONV_NR == 24
     v_float32x4 c0  = v_setzero_f32(), c1 = c0, c2 = c0, c3 = c0, c4 = c0, c5 = c0;
@@ -19,7 +19,7 @@ void convBlock(int np, const float* a, const float* b, float* c, int ldc, bool i
     v_float32x4 c12 = v_setzero_f32(), c13 = c12, c14 = c12, c15 = c12, c16 = c12, c17 = c12;
     v_float32x4 c18 = v_setzero_f32(), c19 = c18, c20 = c18, c21 = c18, c22 = c18, c23 = c18;
 
-    for (int p = 0; p < np; p++, a += CONV_MR, b += CONV_NR)
+    for (int p = 0; p < np; p++, a += CONV_MR, b += ldb)
     {
         v_float32x4 a0 = v_setall_f32(a[0]);
         v_float32x4 b0 = v_load(b), b1 = v_load(b + 4), b2 = v_load(b + 8);
@@ -124,7 +124,7 @@ void convBlock(int np, const float* a, const float* b, float* c, int ldc, bool i
         {
             float ai = a[CONV_MR*p + i];
             for( int j = 0; j < CONV_NR; j++ )
-                cbuf[i * CONV_NR+j] += b[CONV_NR*p + j] * ai;
+                cbuf[i * CONV_NR+j] += b[ldb*p + j] * ai;
         }
     }
     if (!init_c) {
@@ -145,7 +145,7 @@ void convBlock(int np, const float* a, const float* b, float* c, int ldc, bool i
 namespace opt_NEON
 {
 #if CV_TRY_NEON
-void convBlock_NEON(int np, const float* a, const float* b, float* c, int ldc, bool init_c)
+void convBlock_NEON(int np, const float* a, const float* b, int ldb, float* c, int ldc, bool init_c)
 {
 #if CONV_MR == 4 && CONV_NR == 28  // AARCH64
     {
@@ -154,7 +154,7 @@ void convBlock_NEON(int np, const float* a, const float* b, float* c, int ldc, b
         float32x4_t c20 = vdupq_n_f32(0.f), c21 = c20, c22 = c20, c23 = c20, c24 = c20, c25 = c20, c26 = c20;
         float32x4_t c30 = vdupq_n_f32(0.f), c31 = c30, c32 = c30, c33 = c30, c34 = c30, c35 = c30, c36 = c30;
 
-        for( int p = 0; p < np; p++, a += CONV_MR, b += CONV_NR )
+        for( int p = 0; p < np; p++, a += CONV_MR, b += ldb )
         {
             float32x4_t a0 = vld1q_f32(a), b0, b1, b2;
             b0 = vld1q_f32(b); b1 = vld1q_f32(b + 4); b2 = vld1q_f32(b + 8);
@@ -260,7 +260,7 @@ void convBlock_NEON(int np, const float* a, const float* b, float* c, int ldc, b
         float32x2_t a0 = vdup_n_f32(0.0f), a1 = a0;
         float32x4_t b0 = vdupq_n_f32(0.0f), b1 = vdupq_n_f32(0.0f), b2 = vdupq_n_f32(0.0f);
 
-        for (int p = 0; p < np; p++, a += CONV_MR, b += CONV_NR)
+        for (int p = 0; p < np; p++, a += CONV_MR, b += ldb)
         {
             a0 = vld1_f32(a), a1 = vld1_f32(a+2);
             b0 = vld1q_f32(b), b1 = vld1q_f32(b + 4), b2 = vld1q_f32(b + 8);
@@ -70,6 +70,8 @@ class FullyConnectedLayerImpl CV_FINAL : public InnerProductLayer
 {
 public:
     enum { VEC_ALIGN = 8 };
+    // Batch size starting from which the packed weights are used
+    enum { MIN_PACKED_BATCH = 4 };
 
 #ifdef HAVE_OPENCL
     Ptr<OCL4DNNInnerProduct<float> > innerProductOp;
@@ -91,17 +93,9 @@ public:
             CV_Assert(blobs[0].dims >= 2 && (size_t)(innerSize * numOutput) == blobs[0].total());
             CV_Assert(!bias || (blobs.size() == 2 && (size_t)numOutput == blobs[1].total()));
 
-            weightsMat = blobs[0] = blobs[0].reshape(1, numOutput);
-            int vecsize = weightsMat.cols;
-            if (vecsize % VEC_ALIGN != 0)
-            {
-                int vecsize_aligned = (int)alignSize(vecsize, VEC_ALIGN);
-                Mat weightsBuf(weightsMat.rows, vecsize_aligned, weightsMat.type());
-                Mat wpadding = weightsBuf.colRange(vecsize, vecsize_aligned);
-                wpadding.setTo(Scalar::all(0.));
-                weightsMat = weightsBuf.colRange(0, vecsize);
-                blobs[0].copyTo(weightsMat);
-            }
+            blobs[0] = blobs[0].reshape(1, numOutput);
+            weightsMat = alignWeights(blobs[0], CV_32F);
+            weightsBlob = blobs[0];
 
             if (bias)
                 biasMat = blobs[1] = blobs[1].reshape(1, 1);
@@ -110,6 +104,26 @@ public:
         }
     }
 
+    // Weights with rows padded by zeros up to VEC_ALIGN elements
+    static Mat alignWeights(const Mat& weights, int type)
+    {
+        int vecsize = weights.cols;
+        if (vecsize % VEC_ALIGN == 0 && weights.type() == type)
+            return weights;
+        int vecsize_aligned = (int)alignSize(vecsize, VEC_ALIGN);
+        Mat weightsBuf(weights.rows, vecsize_aligned, type);
+        Mat wpadding = weightsBuf.colRange(vecsize, vecsize_aligned);
+        wpadding.setTo(Scalar::all(0.));
+        Mat alignedWeights = weightsBuf.colRange(0, vecsize);
+        weights.convertTo(alignedWeights, type);
+        return alignedWeights;
+    }
+
+    static void alignWeightsFP16(const Mat& weights, Mat& aligned)
+    {
+        aligned = alignWeights(weights, CV_16F);
+    }
+
     bool getMemoryShapes(const std::vector<MatShape> &inputs,
                          const int requiredOutputs,
                          std::vector<MatShape> &outputs,
@@ -180,8 +194,8 @@ public:
         {
             CV_Assert( srcMat.dims == 2 && srcMat.cols == weights.cols &&
                        dstMat.rows == srcMat.rows && dstMat.cols == weights.rows &&
-                       srcMat.type() == weights.type() && weights.type() == dstMat.type() &&
-                       srcMat.type() == CV_32F &&
+                       (weights.type() == CV_32F || weights.type() == CV_16F) &&
+                       srcMat.type() == dstMat.type() && srcMat.type() == CV_32F &&
                        (biasMat.empty() || (biasMat.type() == srcMat.type() &&
                                            biasMat.isContinuous() && (int)biasMat.total() == dstMat.cols)) );
 
@@ -225,13 +239,23 @@ public:
                 int sampleIdx = (int)(ofs / nw0);
                 int delta = (int)(ofs - (size_t)sampleIdx*nw0);
                 const float* sptr_ = srcMat->ptr<float>(sampleIdx);
-                const float* wptr = weights->ptr<float>(delta);
                 float* dptr = dstMat->ptr<float>(sampleIdx) + delta;
                 const float* biasptr = biasMat->ptr<float>() + delta;
                 int nw = std::min(nw0 - delta, (int)(stripeEnd - ofs));
 
                 memcpy(sptr, sptr_, vecsize*sizeof(sptr[0]));
 
+                if( weights->depth() == CV_16F )
+                {
+                    runFP16(sptr, weights->ptr<float16_t>(delta), wstep, biasptr, dptr, nw, vecsize_aligned);
+                    if(activ)
+                        activ->forwardSlice(dptr, dptr, 1, 1, delta, delta + nw);
+                    ofs += nw;
+                    continue;
+                }
+
+                const float* wptr = weights->ptr<float>(delta);
+
             #if CV_TRY_AVX512_SKX
                 if( useAVX512 )
                     opt_AVX512_SKX::fastGEMM1T( sptr, wptr, wstep, biasptr, dptr, nw, vecsize_aligned);
@@ -303,6 +327,60 @@ public:
             }
         }
 
+        // FP16 weights are expanded to FP32 on the fly, accumulation is in FP32.
+        // Rows of weights and the input vector are zero padded up to vecsize_aligned.
+        void runFP16(const float* sptr, const float16_t* wptr, size_t wstep, const float* biasptr,
+                     float* dptr, int nw, int vecsize_aligned) const
+        {
+        #if CV_TRY_AVX512_SKX
+            if( useAVX512 )
+            {
+                opt_AVX512_SKX::fastGEMM1T_FP16( sptr, wptr, wstep, biasptr, dptr, nw, vecsize_aligned);
+                return;
+            }
+        #endif
+        #if CV_TRY_AVX2
+            if( useAVX2 )
+            {
+                opt_AVX2::fastGEMM1T_FP16( sptr, wptr, wstep, biasptr, dptr, nw, vecsize_aligned);
+                return;
+            }
+        #endif
+            int i = 0, k;
+
+        #if CV_SIMD128
+            for( ; i <= nw - 4; i += 4, wptr += 4*wstep )
+            {
+                v_float32x4 vs0 = v_setall_f32(0.f);
+                v_float32x4 vs1 = v_setall_f32(0.f);
+                v_float32x4 vs2 = v_setall_f32(0.f);
+                v_float32x4 vs3 = v_setall_f32(0.f);
+
+                for( k = 0; k < vecsize_aligned; k += 4 )
+                {
+                    v_float32x4 v = v_load_aligned(sptr + k);
+                    vs0 = v_fma(v, v_load_expand(wptr + k), vs0);
+                    vs1 = v_fma(v, v_load_expand(wptr + wstep + k), vs1);
+                    vs2 = v_fma(v, v_load_expand(wptr + wstep*2 + k), vs2);
+                    vs3 = v_fma(v, v_load_expand(wptr + wstep*3 + k), vs3);
+                }
+
+                v_float32x4 s = v_reduce_sum4(vs0, vs1, vs2, vs3);
+                s += v_load(biasptr + i);
+                v_store(dptr + i, s);
+            }
+        #endif
+
+            for( ; i < nw; i++, wptr += wstep )
+            {
+                float s0 = biasptr[i];
+
+                for( k = 0; k < vecsize_aligned; k++ )
+                    s0 += sptr[k]*(float)wptr[k];
+                dptr[i] = s0;
+            }
+        }
+
         const Mat *srcMat, *weights, *biasMat;
         const ActivationLayer* activ;
         Mat* dstMat;
@@ -314,14 +392,46 @@ public:
         bool useLASX;
     };
 
-#ifdef HAVE_OPENCL
     virtual void finalize(InputArrayOfArrays, OutputArrayOfArrays) CV_OVERRIDE
     {
+#ifdef HAVE_OPENCL
         innerProductOp.release();
         umat_blobs.clear();
         half_blobs.clear();
+#endif
+        if (blobs.empty())
+            return;
+
+        if (bias)
+            biasMat = blobs[1] = blobs[1].reshape(1, 1);
+
+        // weightsMat is updated if the weights blob has been replaced (Net::setParam()).
+        // DNN_TARGET_CPU_FP16 uses the FP16 copy of weights, the blob is kept in FP32 for the other targets.
+        if (preferableTarget == DNN_TARGET_CPU_FP16)
+        {
+            blobs[0] = blobs[0].reshape(1, biasMat.cols);
+            getSharedPackedWeights(blobs[0], alignWeightsFP16, weightsFP16);
+            weightsMat = weightsFP16->packed;
+            weightsBlob = blobs[0];
+        }
+        else
+        {
+            weightsFP16.release();
+            if (weightsMat.depth() != CV_32F || weightsBlob.data != blobs[0].data)
+            {
+                blobs[0] = blobs[0].reshape(1, biasMat.cols);
+                weightsMat = alignWeights(blobs[0], CV_32F);
+                weightsBlob = blobs[0];
+            }
+        }
+
+        // packed weights are used only by DNN_TARGET_CPU (see forward())
+        if (preferableTarget != DNN_TARGET_CPU)
+            packedWeights.release();
     }
 
+#ifdef HAVE_OPENCL
+
     bool forward_ocl(InputArrayOfArrays inps, OutputArrayOfArrays outs, InputArrayOfArrays internals)
     {
         std::vector<UMat> inputs;
@@ -505,6 +615,20 @@ public:
                 Mat srcMat = input[i].reshape(1, outerSize);
                 Mat dstMat = output[i].reshape(1, outerSize);
 
+                // A batch of vectors is multiplied by the packed weights, a single vector uses
+                // the original rows of weights (GEMV reads them only once anyway).
+                if (outerSize >= MIN_PACKED_BATCH && preferableTarget == DNN_TARGET_CPU)
+                {
+                    getPackedWeightsForGEMM(blobs[0], packedWeights);
+                    fastGEMMPacked(srcMat, packedWeights->packed, biasMat, dstMat);
+                    if (activ)
+                    {
+                        for (int j = 0; j < outerSize; j++)
+                            activ->forwardSlice(dstMat.ptr<float>(j), dstMat.ptr<float>(j), 1, 1, 0, dstMat.cols);
+                    }
+                    continue;
+                }
+
                 const int nstripes = getNumThreads();
                 FullyConnected::run(srcMat, weightsMat, biasMat, dstMat, activ.get(), nstripes);
             }
@@ -716,6 +840,9 @@ public:
 
     bool bias;
     Mat weightsMat, biasMat;
+    Mat weightsBlob;  // blob which weightsMat is created from
+    Ptr<PackedWeights> packedWeights;  // transposed weights for batches, shared by clones of the layer
+    Ptr<PackedWeights> weightsFP16;  // aligned FP16 weights of DNN_TARGET_CPU_FP16, shared by clones of the layer
     Ptr<ActivationLayer> activ;
 };
 
@@ -0,0 +1,276 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include "fused_elementwise_layer.hpp"
+
+#include <opencv2/core/hal/intrin.hpp>
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+namespace {
+
+struct FusedAdd
+{
+    static inline float apply(float a, float b) { return a + b; }
+#if CV_SIMD
+    static inline v_float32 apply(const v_float32& a, const v_float32& b) { return a + b; }
+#endif
+};
+
+struct FusedSub
+{
+    static inline float apply(float a, float b) { return a - b; }
+#if CV_SIMD
+    static inline v_float32 apply(const v_float32& a, const v_float32& b) { return a - b; }
+#endif
+};
+
+struct FusedMul
+{
+    static inline float apply(float a, float b) { return a * b; }
+#if CV_SIMD
+    static inline v_float32 apply(const v_float32& a, const v_float32& b) { return a * b; }
+#endif
+};
+
+struct FusedDiv
+{
+    static inline float apply(float a, float b) { return a / b; }
+#if CV_SIMD
+    static inline v_float32 apply(const v_float32& a, const v_float32& b) { return a / b; }
+#endif
+};
+
+struct FusedMax
+{
+    static inline float apply(float a, float b) { return std::max(a, b); }
+#if CV_SIMD
+    static inline v_float32 apply(const v_float32& a, const v_float32& b) { return v_max(a, b); }
+#endif
+};
+
+struct FusedMin
+{
+    static inline float apply(float a, float b) { return std::min(a, b); }
+#if CV_SIMD
+    static inline v_float32 apply(const v_float32& a, const v_float32& b) { return v_min(a, b); }
+#endif
+};
+
+template<typename Func>
+static void binaryLoop(const float* a, const float* b, float* dst, int len)
+{
+    int i = 0;
+#if CV_SIMD
+    const int nlanes = v_float32::nlanes;
+    for (; i <= len - nlanes; i += nlanes)
+        v_store(dst + i, Func::apply(vx_load(a + i), vx_load(b + i)));
+#endif
+    for (; i < len; i++)
+        dst[i] = Func::apply(a[i], b[i]);
+}
+
+class FusedElementwiseInvoker : public ParallelLoopBody
+{
+public:
+    // 4KB per intermediate result: tiles of all the operands stay in L1/L2 cache
+    enum { TILE_SIZE = 1024 };
+
+    const FusedElementwiseLayer& chain;
+    std::vector<const float*> inputData;
+    std::vector<bool> inputIsScalar;
+    std::vector<float> scalarTiles;
+    float* outputData;
+    size_t planeSize;
+    int channels;
+    int numPlanes;
+    // Large planes are split into tiles, small ones (e.g. of 2D tensors) are grouped into tiles
+    int tilesPerPlane;
+    int planesPerTile;
+    int numTiles;
+
+    FusedElementwiseInvoker(const FusedElementwiseLayer& chain_, Mat& output)
+        : chain(chain_)
+    {
+        const size_t total = output.total();
+        const int dims = output.dims;
+        channels = dims > 1 ? output.size[1] : output.size[0];
+        planeSize = dims > 2 ? output.total(2) : 1;
+        numPlanes = (int)(total / planeSize);
+        if (planeSize >= TILE_SIZE)
+        {
+            tilesPerPlane = (int)((planeSize + TILE_SIZE - 1) / TILE_SIZE);
+            planesPerTile = 1;
+            numTiles = numPlanes * tilesPerPlane;
+        }
+        else
+        {
+            tilesPerPlane = 1;
+            planesPerTile = (int)(TILE_SIZE / planeSize);
+            numTiles = (numPlanes + planesPerTile - 1) / planesPerTile;
+        }
+        outputData = output.ptr<float>();
+
+        const size_t ninputs = chain.inputs.size();
+        inputData.resize(ninputs);
+        inputIsScalar.resize(ninputs);
+        size_t nscalars = 0;
+        for (size_t i = 0; i < ninputs; ++i)
+            nscalars += chain.inputs[i]->total() == 1 && total != 1;
+        // Single values are broadcasted into the tiles once, so all the operands are handled the same way
+        scalarTiles.resize(nscalars * TILE_SIZE);
+        for (size_t i = 0, k = 0; i < ninputs; ++i)
+        {
+            const Mat& inp = *chain.inputs[i];
+            CV_Assert(inp.type() == CV_32F && inp.isContinuous());
+            inputIsScalar[i] = inp.total() == 1 && total != 1;
+            if (inputIsScalar[i])
+            {
+                float* tile = &scalarTiles[TILE_SIZE * k++];
+                std::fill(tile, tile + TILE_SIZE, inp.at<float>(0));
+                inputData[i] = tile;
+            }
+            else
+            {
+                CV_CheckEQ(inp.total(), total, "DNN/FusedElementwise: input shape mismatch");
+                inputData[i] = inp.ptr<float>();
+            }
+        }
+    }
+
+    void operator()(const Range& r) const CV_OVERRIDE
+    {
+        const size_t ninputs = chain.inputs.size(), nops = chain.ops.size();
+        AutoBuffer<float> buf_((nops - 1) * TILE_SIZE + 1);
+        AutoBuffer<const float*> operands_(ninputs + nops);
+        float* buf = buf_.data();
+        const float** operands = operands_.data();
+
+        for (int tile = r.start; tile < r.end; ++tile)
+        {
+            // the tile is a part of a plane or consists of several planes
+            int plane, planes, len;
+            size_t start;
+            if (planesPerTile == 1)
+            {
+                plane = tile / tilesPerPlane;
+                planes = 1;
+                const size_t ofs = (size_t)(tile % tilesPerPlane) * TILE_SIZE;
+                len = (int)std::min((size_t)TILE_SIZE, planeSize - ofs);
+                start = plane * planeSize + ofs;
+            }
+            else
+            {
+                plane = tile * planesPerTile;
+                planes = std::min(planesPerTile, numPlanes - plane);
+                len = (int)(planes * planeSize);
+                start = plane * planeSize;
+            }
+
+            for (size_t i = 0; i < ninputs; ++i)
+                operands[i] = inputIsScalar[i] ? inputData[i] : inputData[i] + start;
+
+            for (size_t k = 0; k < nops; ++k)
+            {
+                const FusedElementwiseLayer::Op& op = chain.ops[k];
+                // the last operation writes directly into the output, it's safe for in-place inputs
+                float* dst = k + 1 == nops ? outputData + start : buf + k * TILE_SIZE;
+                const float* a = operands[op.src0];
+                const float* b = op.type != FusedElementwiseLayer::OP_ACTIVATION ? operands[op.src1] : NULL;
+                switch (op.type)
+                {
+                case FusedElementwiseLayer::OP_ACTIVATION: applyActivation(*op.activ, a, dst, plane, planes, len); break;
+                case FusedElementwiseLayer::OP_ADD: binaryLoop<FusedAdd>(a, b, dst, len); break;
+                case FusedElementwiseLayer::OP_SUB: binaryLoop<FusedSub>(a, b, dst, len); break;
+                case FusedElementwiseLayer::OP_MUL: binaryLoop<FusedMul>(a, b, dst, len); break;
+                case FusedElementwiseLayer::OP_DIV: binaryLoop<FusedDiv>(a, b, dst, len); break;
+                case FusedElementwiseLayer::OP_MAX: binaryLoop<FusedMax>(a, b, dst, len); break;
+                case FusedElementwiseLayer::OP_MIN: binaryLoop<FusedMin>(a, b, dst, len); break;
+                default: CV_Error(Error::StsNotImplemented, "Unsupported element-wise operation");
+                }
+                operands[ninputs + k] = dst;
+            }
+        }
+    }
+
+private:
+    // Per-channel parameters of the activation are selected by planes of the tile
+    void applyActivation(const ActivationLayer& activ, const float* src, float* dst, int plane, int planes, int len) const
+    {
+        if (planes == 1 || activ.blobs.empty())  // activations without parameters don't depend on channels
+        {
+            const int cn = plane % channels;
+            activ.forwardSlice(src, dst, len, len, cn, cn + 1);
+            return;
+        }
+        for (int p = 0; p < planes; )
+        {
+            // consecutive channels of the same sample are processed by a single call
+            const int cn = (plane + p) % channels;
+            const int n = std::min(planes - p, channels - cn);
+            const size_t ofs = p * planeSize;
+            activ.forwardSlice(src + ofs, dst + ofs, (int)planeSize, planeSize, cn, cn + n);
+            p += n;
+        }
+    }
+};
+
+}  // namespace
+
+
+FusedElementwiseLayer::FusedElementwiseLayer(const LayerParams& params)
+    : Layer(params)
+{
+    // nothing
+}
+
+int FusedElementwiseLayer::addActivation(const Ptr<ActivationLayer>& activ, int src)
+{
+    CV_Assert(activ);
+    CV_Assert(0 <= src && src < (int)(inputs.size() + ops.size()));
+    Op op;
+    op.type = OP_ACTIVATION;
+    op.activ = activ;
+    op.src0 = src;
+    op.src1 = -1;
+    ops.push_back(op);
+    return (int)(inputs.size() + ops.size()) - 1;
+}
+
+int FusedElementwiseLayer::addBinary(OpType type, int src0, int src1)
+{
+    CV_Assert(type != OP_ACTIVATION);
+    CV_Assert(0 <= src0 && src0 < (int)(inputs.size() + ops.size()));
+    CV_Assert(0 <= src1 && src1 < (int)(inputs.size() + ops.size()));
+    Op op;
+    op.type = type;
+    op.src0 = src0;
+    op.src1 = src1;
+    ops.push_back(op);
+    return (int)(inputs.size() + ops.size()) - 1;
+}
+
+void FusedElementwiseLayer::forward(InputArrayOfArrays, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays)
+{
+    CV_TRACE_FUNCTION();
+    CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+    CV_Assert(!ops.empty());
+
+    std::vector<Mat> outputs;
+    outputs_arr.getMatVector(outputs);
+    CV_Assert(outputs.size() == 1);
+    Mat& output = outputs[0];
+    CV_Assert(output.type() == CV_32F && output.isContinuous());
+    if (output.empty())
+        return;
+
+    FusedElementwiseInvoker body(*this, output);
+    parallel_for_(Range(0, body.numTiles), body);
+}
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
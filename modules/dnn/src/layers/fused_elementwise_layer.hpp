@@ -0,0 +1,60 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef __OPENCV_DNN_LAYERS_FUSED_ELEMENTWISE_LAYER_HPP__
+#define __OPENCV_DNN_LAYERS_FUSED_ELEMENTWISE_LAYER_HPP__
+
+#include <opencv2/dnn/all_layers.hpp>
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+/** @brief Computes a chain of element-wise layers in a single pass over the data.
+ *
+ * The chain is built by Net::Impl::fuseElementwiseChains() and replaces the last layer of the chain
+ * in forward(). Tensor is processed by tiles which stay in cache while all the operations are applied,
+ * so intermediate results are never stored to the memory.
+ *
+ * Operands are numbered in order: inputs of the chain first, then results of the operations.
+ * All the inputs have the shape of the output or contain a single value (broadcasted).
+ */
+class FusedElementwiseLayer CV_FINAL : public Layer
+{
+public:
+    enum OpType
+    {
+        OP_ACTIVATION = 0,
+        OP_ADD,
+        OP_SUB,
+        OP_MUL,
+        OP_DIV,
+        OP_MAX,
+        OP_MIN
+    };
+
+    struct Op
+    {
+        OpType type;
+        Ptr<ActivationLayer> activ;  //!< OP_ACTIVATION only, applied by forwardSlice()
+        int src0, src1;              //!< indices of operands, src1 is not used by activations
+    };
+
+    /// External inputs of the chain, these are input blobs of the fused layers
+    std::vector<const Mat*> inputs;
+    std::vector<Op> ops;
+
+    FusedElementwiseLayer(const LayerParams& params);
+
+    /// Returns index of the operand which contains the result
+    int addActivation(const Ptr<ActivationLayer>& activ, int src);
+    int addBinary(OpType type, int src0, int src1);
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE;
+};
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
+
+#endif  // __OPENCV_DNN_LAYERS_FUSED_ELEMENTWISE_LAYER_HPP__
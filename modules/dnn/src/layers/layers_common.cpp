@@ -43,6 +43,8 @@
 #include "../precomp.hpp"
 #include "layers_common.hpp"
 
+#include <map>
+
 namespace cv
 {
 namespace dnn
@@ -263,5 +265,261 @@ double getWeightScale(const Mat& weightsMat)
     return (realMax == realMin) ? 1.0 : std::max(-realMin, realMax)/127;
 }
 
+void packWeightsForGEMM(const Mat& weights, Mat& packed)
+{
+    CV_Assert(weights.dims == 2 && (weights.type() == CV_32F || weights.type() == CV_16F));
+    const int numOutput = weights.rows;
+    packed.create(weights.cols, (int)alignSize(numOutput, 16), CV_32F);
+    packed.colRange(numOutput, packed.cols).setTo(Scalar::all(0));
+    Mat dst = packed.colRange(0, numOutput);
+    if (weights.type() == CV_32F)
+        transpose(weights, dst);
+    else
+    {
+        Mat weights32f;
+        weights.convertTo(weights32f, CV_32F);
+        transpose(weights32f, dst);
+    }
+}
+
+namespace
+{
+
+static bool isPackedFrom(const PackedWeights& packed, const Mat& weights, PackWeightsFunc pack)
+{
+    return packed.pack == pack &&
+           packed.weights.data == weights.data && packed.weights.size == weights.size &&
+           packed.weights.step[0] == weights.step[0] && packed.weights.type() == weights.type();
+}
+
+// Entries are looked up by the weights data. The data can't be reused by another blob
+// while the entry is alive because PackedWeights::weights holds a reference to it.
+typedef std::multimap<const uchar*, std::weak_ptr<PackedWeights> > PackedWeightsCache;
+
+static Mutex& getPackedWeightsMutex()
+{
+    static Mutex* mutex = new Mutex();
+    return *mutex;
+}
+
+static PackedWeightsCache& getPackedWeightsCache()
+{
+    static PackedWeightsCache* cache = new PackedWeightsCache();
+    return *cache;
+}
+
+}  // namespace
+
+void getSharedPackedWeights(const Mat& weights, PackWeightsFunc pack, Ptr<PackedWeights>& packed)
+{
+    CV_Assert(!weights.empty() && pack);
+    if (packed && isPackedFrom(*packed, weights, pack))
+        return;
+
+    AutoLock lock(getPackedWeightsMutex());
+    PackedWeightsCache& cache = getPackedWeightsCache();
+    std::pair<PackedWeightsCache::iterator, PackedWeightsCache::iterator> range = cache.equal_range(weights.data);
+    for (PackedWeightsCache::iterator it = range.first; it != range.second;)
+    {
+        Ptr<PackedWeights> entry = it->second.lock();
+        if (!entry)
+        {
+            it = cache.erase(it);
+            continue;
+        }
+        if (isPackedFrom(*entry, weights, pack))
+        {
+            packed = entry;
+            return;
+        }
+        ++it;
+    }
+
+    // Packing runs under the lock, so clones of a network which are initialized
+    // concurrently don't pack the same weights several times.
+    Ptr<PackedWeights> entry = makePtr<PackedWeights>();
+    entry->weights = weights;
+    entry->pack = pack;
+    pack(weights, entry->packed);
+    for (PackedWeightsCache::iterator it = cache.begin(); it != cache.end();)
+    {
+        if (it->second.expired())
+            it = cache.erase(it);
+        else
+            ++it;
+    }
+    cache.insert(std::make_pair((const uchar*)weights.data, std::weak_ptr<PackedWeights>(entry)));
+    packed = entry;
+}
+
+void getPackedWeightsForGEMM(const Mat& weights, Ptr<PackedWeights>& packed)
+{
+    getSharedPackedWeights(weights, packWeightsForGEMM, packed);
+}
+
+namespace
+{
+
+class PackedGEMMInvoker : public ParallelLoopBody
+{
+public:
+    // Blocks of 64 rows by panels of packed weights which fit L2 cache
+    enum { BLOCK_M = 64 };
+
+    PackedGEMMInvoker(const Mat& src, const Mat& packed, const Mat& bias, Mat& dst)
+        : src_(src), packed_(packed), bias_(bias), dst_(dst)
+    {
+        blockN = (int)alignSize(std::min(std::max((1 << 16) / std::max(src.cols, 1), 16), 256), 16);
+        blocksN = (dst.cols + blockN - 1) / blockN;
+        blocksM = (dst.rows + BLOCK_M - 1) / BLOCK_M;
+        useAVX = checkHardwareSupport(CPU_AVX);
+        useAVX2 = checkHardwareSupport(CPU_AVX2);
+        useAVX512 = CV_CPU_HAS_SUPPORT_AVX512_SKX;
+        useRVV = checkHardwareSupport(CPU_RVV);
+        useLASX = checkHardwareSupport(CPU_LASX);
+    }
+
+    int numBlocks() const { return blocksM * blocksN; }
+
+    void operator()(const Range& r) const CV_OVERRIDE
+    {
+        const int kmax = src_.cols;
+        const size_t astep = src_.step1(), bstep = packed_.step1(), cstep = dst_.step1();
+        for (int block = r.start; block < r.end; ++block)
+        {
+            const int m0 = (block / blocksN) * BLOCK_M, n0 = (block % blocksN) * blockN;
+            const int mmax = std::min((int)BLOCK_M, dst_.rows - m0), nmax = std::min(blockN, dst_.cols - n0);
+            const float* aptr = src_.ptr<float>(m0);
+            const float* bptr = packed_.ptr<float>() + n0;
+            float* cptr = dst_.ptr<float>(m0) + n0;
+
+        #if CV_TRY_AVX512_SKX
+            if( useAVX512 )
+                opt_AVX512_SKX::fastGEMM( aptr, astep, bptr, bstep, cptr, cstep, mmax, kmax, nmax );
+            else
+        #endif
+        #if CV_TRY_AVX2
+            if( useAVX2 )
+                opt_AVX2::fastGEMM( aptr, astep, bptr, bstep, cptr, cstep, mmax, kmax, nmax );
+            else
+        #endif
+        #if CV_TRY_AVX
+            if( useAVX )
+                opt_AVX::fastGEMM( aptr, astep, bptr, bstep, cptr, cstep, mmax, kmax, nmax );
+            else
+        #endif
+        #if CV_TRY_RVV
+            if( useRVV )
+                opt_RVV::fastGEMM( aptr, astep, bptr, bstep, cptr, cstep, mmax, kmax, nmax );
+            else
+        #endif
+        #if CV_TRY_LASX
+            if( useLASX )
+                opt_LASX::fastGEMM( aptr, astep, bptr, bstep, cptr, cstep, mmax, kmax, nmax );
+            else
+        #endif
+                gemmBlock(aptr, astep, bptr, bstep, cptr, cstep, mmax, kmax, nmax);
+
+            if (!bias_.empty())
+            {
+                const float* biasptr = bias_.ptr<float>() + n0;
+                for (int m = 0; m < mmax; ++m)
+                {
+                    float* dptr = cptr + cstep * m;
+                    for (int n = 0; n < nmax; ++n)
+                        dptr[n] += biasptr[n];
+                }
+            }
+        }
+    }
+
+    // 4x8 micro-kernel: rows of packed weights are padded, so whole vectors are always loaded
+    static void gemmBlock(const float* aptr, size_t astep, const float* bptr, size_t bstep,
+                          float* cptr, size_t cstep, int mmax, int kmax, int nmax)
+    {
+        for (int m = 0; m < mmax; m += 4)
+        {
+            const float* aptr0 = aptr + astep*m;
+            const float* aptr1 = aptr + astep*std::min(m+1, mmax-1);
+            const float* aptr2 = aptr + astep*std::min(m+2, mmax-1);
+            const float* aptr3 = aptr + astep*std::min(m+3, mmax-1);
+            float* cptr0 = cptr + cstep*m;
+            float* cptr1 = cptr + cstep*std::min(m+1, mmax-1);
+            float* cptr2 = cptr + cstep*std::min(m+2, mmax-1);
+            float* cptr3 = cptr + cstep*std::min(m+3, mmax-1);
+            int n = 0;
+        #if CV_SIMD128
+            for (; n < nmax; n += 8)
+            {
+                v_float32x4 d00 = v_setzero_f32(), d01 = v_setzero_f32();
+                v_float32x4 d10 = v_setzero_f32(), d11 = v_setzero_f32();
+                v_float32x4 d20 = v_setzero_f32(), d21 = v_setzero_f32();
+                v_float32x4 d30 = v_setzero_f32(), d31 = v_setzero_f32();
+                for (int k = 0; k < kmax; k++)
+                {
+                    v_float32x4 b0 = v_load(bptr + k*bstep + n), b1 = v_load(bptr + k*bstep + n + 4);
+                    v_float32x4 a0 = v_setall_f32(aptr0[k]), a1 = v_setall_f32(aptr1[k]);
+                    v_float32x4 a2 = v_setall_f32(aptr2[k]), a3 = v_setall_f32(aptr3[k]);
+                    d00 = v_fma(a0, b0, d00); d01 = v_fma(a0, b1, d01);
+                    d10 = v_fma(a1, b0, d10); d11 = v_fma(a1, b1, d11);
+                    d20 = v_fma(a2, b0, d20); d21 = v_fma(a2, b1, d21);
+                    d30 = v_fma(a3, b0, d30); d31 = v_fma(a3, b1, d31);
+                }
+                float buf[32];
+                v_store(buf, d00); v_store(buf + 4, d01);
+                v_store(buf + 8, d10); v_store(buf + 12, d11);
+                v_store(buf + 16, d20); v_store(buf + 20, d21);
+                v_store(buf + 24, d30); v_store(buf + 28, d31);
+                // the block may end in the middle of the vectors
+                const int len = std::min(nmax - n, 8);
+                for (int j = 0; j < len; j++)
+                {
+                    cptr0[n + j] = buf[j];
+                    cptr1[n + j] = buf[8 + j];
+                    cptr2[n + j] = buf[16 + j];
+                    cptr3[n + j] = buf[24 + j];
+                }
+            }
+        #endif
+            for (; n < nmax; n++)
+            {
+                float d0 = 0.f, d1 = 0.f, d2 = 0.f, d3 = 0.f;
+                for (int k = 0; k < kmax; k++)
+                {
+                    float b = bptr[k*bstep + n];
+                    d0 += aptr0[k]*b; d1 += aptr1[k]*b;
+                    d2 += aptr2[k]*b; d3 += aptr3[k]*b;
+                }
+                cptr0[n] = d0; cptr1[n] = d1;
+                cptr2[n] = d2; cptr3[n] = d3;
+            }
+        }
+    }
+
+private:
+    const Mat& src_;
+    const Mat& packed_;
+    const Mat& bias_;
+    Mat& dst_;
+    int blockN, blocksN, blocksM;
+    bool useAVX, useAVX2, useAVX512, useRVV, useLASX;
+};
+
+}  // namespace
+
+void fastGEMMPacked(const Mat& src, const Mat& packed, const Mat& bias, Mat& dst)
+{
+    CV_Assert(src.dims == 2 && src.type() == CV_32F && packed.type() == CV_32F);
+    CV_Assert(dst.dims == 2 && dst.type() == CV_32F);
+    CV_Assert(src.cols == packed.rows && src.rows == dst.rows && dst.cols <= packed.cols);
+    CV_Assert(packed.cols % 16 == 0 && packed.isContinuous());
+    CV_Assert(bias.empty() || (bias.type() == CV_32F && bias.isContinuous() && (int)bias.total() == dst.cols));
+    if (dst.empty())
+        return;
+
+    PackedGEMMInvoker body(src, packed, bias, dst);
+    parallel_for_(Range(0, body.numBlocks()), body);
+}
+
 }
 }
@@ -76,6 +76,33 @@ void getConvPoolPaddings(const std::vector<int>& inp, const std::vector<size_t>&
 
 // Used in quantized model. It will return the (Max_element - Min_element)/127.
 double getWeightScale(const Mat& weightsMat);
+
+// Packs FP32 or FP16 weights of a fully connected (or recurrent) layer, rows are outputs: they are transposed
+// into K x N layout with columns padded up to a multiple of 16, the blocked GEMM kernels
+// read panels of the packed matrix sequentially.
+void packWeightsForGEMM(const Mat& weights, Mat& packed);
+
+// dst = src * weights^T + bias for a batch of vectors (rows of src) with weights packed by
+// packWeightsForGEMM(). bias is either empty or a row of dst.cols elements.
+void fastGEMMPacked(const Mat& src, const Mat& packed, const Mat& bias, Mat& dst);
+
+typedef void (*PackWeightsFunc)(const Mat& weights, Mat& packed);
+
+// Weights prepared for the kernels of a layer, shared between layers which are created from the same
+// weights blob (e.g. layers of cloned networks).
+struct PackedWeights
+{
+    Mat weights;  // origin weights: the reference keeps their data from reuse by another blob
+    PackWeightsFunc pack;
+    Mat packed;
+};
+
+// Updates packed weights if they are not created from the given ones by the given function (first call or
+// the weights blob has been replaced). They are looked up by the weights data, so packing is done once per blob.
+void getSharedPackedWeights(const Mat& weights, PackWeightsFunc pack, Ptr<PackedWeights>& packed);
+
+// getSharedPackedWeights() with packWeightsForGEMM()
+void getPackedWeightsForGEMM(const Mat& weights, Ptr<PackedWeights>& packed);
 }
 }
 
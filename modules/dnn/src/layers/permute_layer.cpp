@@ -121,7 +121,7 @@ public:
 #ifdef HAVE_INF_ENGINE
         if (backendId == DNN_BACKEND_INFERENCE_ENGINE_NGRAPH)
         {
-            if (preferableTarget == DNN_TARGET_CPU)
+            if (IS_DNN_CPU_TARGET(preferableTarget))
                 return _order.size() <= 4 || !isArmComputePlugin();
             return true;
         }
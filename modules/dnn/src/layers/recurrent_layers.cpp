@@ -136,6 +136,9 @@ class LSTMLayerImpl CV_FINAL : public LSTMLayer
     // in ONNXImporter are destructive, so we keep a copy.
     std::vector<Mat> originalBlobs;
 
+    // Weights of every direction packed for batched multiplication, shared by clones of the layer
+    std::vector<Ptr<PackedWeights> > packedWx, packedWh;
+
 public:
 
     LSTMLayerImpl(const LayerParams& params)
@@ -252,6 +255,8 @@ public:
         blobs[0] = Mat(Wh.clone());
         blobs[1] = Mat(Wx.clone());
         blobs[2] = Mat(bias.clone()).reshape(1, 1);
+        packedWx.clear();
+        packedWh.clear();
     }
 
     bool supportBackend(int backendId) CV_OVERRIDE
@@ -312,10 +317,11 @@ public:
             }
         }
 
+        const int _numTimeStamps = useTimestampDim ? inp0[0] : 1;
         internals.assign(1, shape(_numSamples, _numOut)); // hInternal
         internals.push_back(shape(_numSamples, _numOut)); // cInternal
-        internals.push_back(shape(_numSamples, 1)); // dummyOnes
         internals.push_back(shape(_numSamples, 4*_numOut)); // gates
+        internals.push_back(shape(_numTimeStamps*_numSamples, 4*_numOut)); // xGates: Wx * x_t + b for all timestamps
 
         return false;
     }
@@ -378,6 +384,8 @@ public:
         Mat cOut = produceCellOutput ? output[0].clone() : Mat();
         const bool needYcTransform = !originalBlobs.empty(); // if the producer is onnx
         const int numDirs = 1 + static_cast<int>(bidirectional);
+        packedWx.resize(numDirs);
+        packedWh.resize(numDirs);
         for (int i = 0; i < numDirs; ++i)
         {
             Mat Wh = blobs[0];
@@ -411,10 +419,9 @@ public:
 
             int numOut = Wh.size[1];
             Mat hInternal = internals[0], cInternal = internals[1],
-                    dummyOnes = internals[2], gates = internals[3];
+                    gates = internals[2], xGatesTs = internals[3];
             h_0.copyTo(hInternal);
             c_0.copyTo(cInternal);
-            dummyOnes.setTo(1.);
 
             int numSamplesTotal = numTimeStamps*numSamples;
             Mat xTs = input[0].reshape(1, numSamplesTotal);
@@ -428,11 +435,17 @@ public:
                 cOutTs = cOutTs.colRange(i * cOutTs.cols / numDirs, (i + 1) * cOutTs.cols / numDirs);
             }
 
+            // input projection doesn't depend on the previous timestamps: Wx * x_t + b
+            // is computed for all of them by a single matrix multiplication
+            getPackedWeightsForGEMM(Wx, packedWx[i]);
+            fastGEMMPacked(xTs, packedWx[i]->packed, bias, xGatesTs);
+
+            // batch of samples is multiplied by the packed weights, a single one by the original rows
+            const bool usePackedWh = numSamples >= 4;
+            if (usePackedWh)
+                getPackedWeightsForGEMM(Wh, packedWh[i]);
 #if CV_TRY_AVX2 || CV_TRY_AVX
-            bool canUseAvx = gates.isContinuous() && bias.isContinuous()
-                && Wx.depth() == CV_32F && gates.depth() == CV_32F
-                && bias.depth() == CV_32F && Wx.cols >= 8;
-            bool canUseAvx_hInternal = hInternal.isContinuous() && gates.isContinuous() && bias.isContinuous()
+            bool canUseAvx_hInternal = hInternal.isContinuous() && gates.isContinuous()
                 && Wh.depth() == CV_32F && hInternal.depth() == CV_32F && gates.depth() == CV_32F
                 && Wh.cols >= 8;
 #endif
@@ -451,47 +464,14 @@ public:
             for (int ts = tsStart; ts != tsEnd; ts += tsInc)
             {
                 Range curRowRange(ts*numSamples, (ts + 1)*numSamples);
-                Mat xCurr = xTs.rowRange(curRowRange);
+                Mat xGates = xGatesTs.rowRange(curRowRange);
 
-#if CV_TRY_AVX2
-                if (useAVX2 && canUseAvx && xCurr.isContinuous())
+                if (usePackedWh)
                 {
-                    for (int n = 0; n < xCurr.rows; n++) {
-                        opt_AVX2::fastGEMM1T(
-                            xCurr.ptr<float>(n),
-                            Wx.ptr<float>(),
-                            Wx.step1(),
-                            bias.ptr<float>(),
-                            gates.ptr<float>(n),
-                            Wx.rows,
-                            Wx.cols
-                        );
-                    }
-                }
-                else
-#endif
-#if CV_TRY_AVX
-                if (useAVX && canUseAvx && xCurr.isContinuous())
-                {
-                    for (int n = 0; n < xCurr.rows; n++) {
-                        opt_AVX::fastGEMM1T(
-                            xCurr.ptr<float>(n),
-                            Wx.ptr<float>(),
-                            Wx.step1(),
-                            bias.ptr<float>(),
-                            gates.ptr<float>(n),
-                            Wx.rows,
-                            Wx.cols
-                        );
-                    }
+                    fastGEMMPacked(hInternal, packedWh[i]->packed, Mat(), gates);
+                    add(gates, xGates, gates);                          // Wh * h_{t-1} + Wx * x_t + b
                 }
                 else
-#endif
-                {
-                    gemm(xCurr, Wx, 1, gates, 0, gates, GEMM_2_T);      // Wx * x_t
-                    gemm(dummyOnes, bias, 1, gates, 1, gates);          //+b
-                }
-
 #if CV_TRY_AVX2
                 if (useAVX2 && canUseAvx_hInternal)
                 {
@@ -500,7 +480,7 @@ public:
                             hInternal.ptr<float>(n),
                             Wh.ptr<float>(),
                             Wh.step1(),
-                            gates.ptr<float>(n),
+                            xGates.ptr<float>(n),
                             gates.ptr<float>(n),
                             Wh.rows,
                             Wh.cols
@@ -517,7 +497,7 @@ public:
                             hInternal.ptr<float>(n),
                             Wh.ptr<float>(),
                             Wh.step1(),
-                            gates.ptr<float>(n),
+                            xGates.ptr<float>(n),
                             gates.ptr<float>(n),
                             Wh.rows,
                             Wh.cols
@@ -527,7 +507,7 @@ public:
                 else
 #endif
                 {
-                    gemm(hInternal, Wh, 1, gates, 1, gates, GEMM_2_T);  //+Wh * h_{t-1}
+                    gemm(hInternal, Wh, 1, xGates, 1, gates, GEMM_2_T);  // Wh * h_{t-1} + Wx * x_t + b
                 }
 
                 Mat gateI = gates.colRange(0*numOut, 1*numOut);
@@ -898,6 +878,9 @@ class GRULayerImpl CV_FINAL : public GRULayer
     MatShape outTsShape;    //shape of N output samples
     bool bidirectional;     // If true, produces both forward and reversed directions along time axis
 
+    // Weights of every direction packed for batched multiplication, shared by clones of the layer
+    std::vector<Ptr<PackedWeights> > packedWx, packedWh;
+
 public:
 
     GRULayerImpl(const LayerParams& params) : numTimeStamps(0), numSamples(0)
@@ -960,9 +943,8 @@ public:
 
         internals.assign(1, shape(_numSamples, _numOut));     // hInternal
         internals.push_back(shape(_numSamples, 1));           // dummyOnes
-        internals.push_back(shape(_numSamples, 2 * _numOut)); // gates
-        internals.push_back(shape(_numSamples, 2 * _numOut)); // gates_b
-        internals.push_back(shape(_numSamples, 1 * _numOut)); // h_linear
+        internals.push_back(shape(_numSamples, 3 * _numOut)); // hGates: h_(t-1) * Wh
+        internals.push_back(shape(inp0[0] * _numSamples, 3 * _numOut)); // xGates: x * Wx + b for all timestamps
         internals.push_back(shape(_numSamples, _numOut));     // ones
 
         return false;
@@ -1014,6 +996,8 @@ public:
         internals_arr.getMatVector(internals);
 
         const int numDirs = 1 + static_cast<int>(bidirectional);
+        packedWx.resize(numDirs);
+        packedWh.resize(numDirs);
         for (int i = 0; i < numDirs; ++i)
         {
             const Mat &Wh = blobs[0].rowRange(i * blobs[0].rows / numDirs, (i + 1) * blobs[0].rows / numDirs);
@@ -1024,27 +1008,30 @@ public:
             const Mat &bx = bias.colRange(0, bias.cols / 2);
             const Mat &bh = bias.colRange(bias.cols / 2, bias.cols);
 
-            Mat hInternal = internals[0], dummyOnes = internals[1], gates = internals[2],
-                b_rz = internals[3], n_t = internals[4], ones = internals[5];
+            Mat hInternal = internals[0], dummyOnes = internals[1], hGates = internals[2],
+                xGatesTs = internals[3], ones = internals[4];
             h_0.copyTo(hInternal);
             dummyOnes.setTo(1.);
             ones.setTo(1.);
 
             int numOut = Wh.size[1];
-            const Mat& wx_rz = Wx.rowRange(0, 2 * numOut);
-            const Mat& wh_rz = Wh.rowRange(0, 2 * numOut);
-            b_rz = bx.colRange(0, 2 * numOut) + bh.colRange(0, 2 * numOut);
-            const Mat& wx_n = Wx.rowRange(2 * numOut, 3 * numOut);
-            const Mat& wh_n = Wh.rowRange(2 * numOut, 3 * numOut);
-            const Mat& b_in = bx.colRange(2 * numOut, 3 * numOut);
             const Mat& b_hn = bh.colRange(2 * numOut, 3 * numOut);
+            // biases of r and z gates are summed, b_hn is added to h_(t-1) * Wh_n before the reset gate
+            Mat xBias = bx.clone();
+            Mat b_rz = xBias.colRange(0, 2 * numOut);
+            add(b_rz, bh.colRange(0, 2 * numOut), b_rz);
 
             int numSamplesTotal = numTimeStamps * numSamples;
             Mat xTs = input[0].reshape(1, numSamplesTotal);
 
             Mat hOutTs = output[0].reshape(1, numSamplesTotal);
             hOutTs = hOutTs.colRange(i * hOutTs.cols / numDirs, (i + 1) * hOutTs.cols / numDirs);
-            Mat cOutTs = Mat();
+
+            // x * Wx + b doesn't depend on the previous timestamps: computed for all of them at once
+            getPackedWeightsForGEMM(Wx, packedWx[i]);
+            fastGEMMPacked(xTs, packedWx[i]->packed, xBias, xGatesTs);
+            if (numSamples >= 4)
+                getPackedWeightsForGEMM(Wh, packedWh[i]);
 
             int tsStart, tsEnd, tsInc;
             if (i == 1) {
@@ -1060,25 +1047,28 @@ public:
             for (int ts = tsStart; ts != tsEnd; ts += tsInc)
             {
                 Range curRowRange(ts * numSamples, (ts + 1) * numSamples);
-                Mat xCurr = xTs.rowRange(curRowRange);
+                Mat xGates = xGatesTs.rowRange(curRowRange);
+
+                // h_(t-1) * Wh for all the gates, a single sample is multiplied by the original rows
+                if (numSamples >= 4)
+                    fastGEMMPacked(hInternal, packedWh[i]->packed, Mat(), hGates);
+                else
+                    gemm(hInternal, Wh, 1, noArray(), 0, hGates, GEMM_2_T);
 
-                // calculate r_t = sigmoid(x * Wx_r + h_(t-1) * Wh_r + b_r)
                 // calculate z_t = sigmoid(x * Wx_z + h_(t-1) * Wh_z + b_z)
-                gemm(xCurr, wx_rz, 1, gates, 0, gates, GEMM_2_T);      // x * Wx_rz
-                gemm(hInternal, wh_rz, 1, gates, 1, gates, GEMM_2_T);  // + h_(t-1) * Wh_rz
-                gemm(dummyOnes, b_rz, 1, gates, 1, gates);             // + b_rz
-                sigmoid(gates, gates);                                 // sigmoid()
+                // calculate r_t = sigmoid(x * Wx_r + h_(t-1) * Wh_r + b_r)
+                Mat gates = hGates.colRange(0, 2 * numOut);
+                add(gates, xGates.colRange(0, 2 * numOut), gates);
+                sigmoid(gates, gates);
 
                 Mat z = gates.colRange(0, gates.cols / 2);
                 Mat r = gates.colRange(gates.cols / 2, gates.cols);
 
                 // calculate n_t = tanh(r (*) (h_(t-1) * Wh_n + b_hn) + x * Wx_n + b_in)
-                gemm(hInternal, wh_n, 1, n_t, 0, n_t, GEMM_2_T);       // h_(t-1) * Wh_n
-                gemm(dummyOnes, b_hn, 1, n_t, 1, n_t);                 // + b_hn
+                Mat n_t = hGates.colRange(2 * numOut, 3 * numOut);
+                gemm(dummyOnes, b_hn, 1, n_t, 1, n_t);                 // h_(t-1) * Wh_n + b_hn
                 multiply(r, n_t, n_t);                                 // r (*) (h_(t-1) * Wh_n + b_hn)
-
-                gemm(xCurr, wx_n, 1, n_t, 1, n_t, GEMM_2_T);          // + x * Wx_n
-                gemm(dummyOnes, b_in, 1, n_t, 1, n_t);                // + b_in
+                add(n_t, xGates.colRange(2 * numOut, 3 * numOut), n_t); // + x * Wx_n + b_in
                 tanh(n_t, n_t);                                       // tanh()
 
                 //compute next h_t = z (*) h_(t-1) + (1 - z) (*) n_t
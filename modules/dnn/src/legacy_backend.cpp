@@ -53,7 +53,7 @@ Ptr<BackendWrapper> wrapMat(int backendId, int targetId, cv::Mat& m)
 {
     if (backendId == DNN_BACKEND_OPENCV)
     {
-        if (targetId == DNN_TARGET_CPU)
+        if (IS_DNN_CPU_TARGET(targetId))
             return Ptr<BackendWrapper>();
 #ifdef HAVE_OPENCL
         else if (IS_DNN_OPENCL_TARGET(targetId))
@@ -311,8 +311,24 @@ public:
         refCounter.clear();
         reuseMap.clear();
         memHosts.clear();
+        arena.release();
+        plannedMemory = 0;
     }
 
+    // Takes ownership of the preallocated arena built by the memory planner.
+    // Blobs which were allocated separately are released by their users after rebinding.
+    void setArena(const Mat& arena_, size_t plannedMemory_)
+    {
+        memHosts.clear();
+        arena = arena_;
+        plannedMemory = plannedMemory_;
+    }
+
+    size_t getArenaSize() const { return arena.total() * arena.elemSize(); }
+
+    // Returns total memory of intermediate blobs planned by the memory planner (arena and blobs kept out of it).
+    size_t getPlannedMemory() const { return plannedMemory; }
+
 private:
     // Register allocated memory.
     void addHost(const LayerPin& lp, const Mat& mat)
@@ -327,6 +343,8 @@ private:
     // For origin blobs key == value.
     std::map<LayerPin, LayerPin> reuseMap;
     std::map<LayerPin, Mat> memHosts;
+    Mat arena;
+    size_t plannedMemory = 0;
 };  // BlobManager
 
 
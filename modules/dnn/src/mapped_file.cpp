@@ -0,0 +1,182 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "mapped_file.hpp"
+
+#include <opencv2/core/utils/logger.hpp>
+
+#include <fstream>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#define OPENCV_DNN_HAVE_MMAP 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OPENCV_DNN_HAVE_MMAP 1
+#endif
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+namespace {
+
+// Releases the reference to the file when the last matrix which refers to it is destroyed
+class MappedFileAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int, const int*, int, void*, size_t*, AccessFlag, UMatUsageFlags) const CV_OVERRIDE
+    {
+        CV_Error(Error::StsNotImplemented, "DNN: memory mapped blobs can't be reallocated");
+    }
+
+    bool allocate(UMatData*, AccessFlag, UMatUsageFlags) const CV_OVERRIDE
+    {
+        return false;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        delete (Ptr<MappedFile>*)u->userdata;
+        delete u;
+    }
+};
+
+static MappedFileAllocator& getMappedFileAllocator()
+{
+    static MappedFileAllocator* allocator = new MappedFileAllocator();
+    return *allocator;
+}
+
+}  // namespace
+
+
+MappedFile::MappedFile()
+    : data_(NULL), size_(0), mapped_(false)
+#ifdef _WIN32
+    , fileHandle_(INVALID_HANDLE_VALUE), mappingHandle_(NULL)
+#endif
+{
+    // nothing
+}
+
+MappedFile::~MappedFile()
+{
+    if (!mapped_)
+        return;
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+    CloseHandle((HANDLE)mappingHandle_);
+    CloseHandle((HANDLE)fileHandle_);
+#elif defined(OPENCV_DNN_HAVE_MMAP)
+    munmap(data_, size_);
+#endif
+}
+
+Ptr<MappedFile> MappedFile::open(const std::string& path)
+{
+    CV_TRACE_FUNCTION();
+    Ptr<MappedFile> file(new MappedFile());
+
+#ifdef OPENCV_DNN_HAVE_MMAP
+    static bool useMmap = getParam_DNN_MODEL_MMAP();
+    if (useMmap)
+    {
+#if defined(_WIN32)
+        HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return Ptr<MappedFile>();
+        file->fileHandle_ = fileHandle;
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart > 0)
+        {
+            HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+            if (mappingHandle)
+            {
+                void* ptr = MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+                if (ptr)
+                {
+                    file->mappingHandle_ = mappingHandle;
+                    file->data_ = (uchar*)ptr;
+                    file->size_ = (size_t)fileSize.QuadPart;
+                    file->mapped_ = true;
+                    return file;
+                }
+                CloseHandle(mappingHandle);
+            }
+        }
+        CloseHandle(fileHandle);
+        file->fileHandle_ = INVALID_HANDLE_VALUE;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return Ptr<MappedFile>();
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            // private writable mapping: modifications of the blobs don't reach the file
+            void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED)
+            {
+                ::close(fd);  // the mapping keeps a reference to the file
+                file->data_ = (uchar*)ptr;
+                file->size_ = (size_t)st.st_size;
+                file->mapped_ = true;
+                return file;
+            }
+        }
+        ::close(fd);
+#endif
+        CV_LOG_DEBUG(NULL, "DNN: can't map file into memory, read it instead: " << path);
+    }
+#endif  // OPENCV_DNN_HAVE_MMAP
+
+    std::ifstream fs(path.c_str(), std::ios::in | std::ios::binary);
+    if (!fs)
+        return Ptr<MappedFile>();
+    fs.seekg(0, std::ios::end);
+    const std::streamoff fileSize = fs.tellg();
+    if (fileSize < 0)
+        return Ptr<MappedFile>();
+    fs.seekg(0, std::ios::beg);
+    file->buffer_.resize((size_t)fileSize);
+    if (fileSize > 0 && !fs.read((char*)file->buffer_.data(), fileSize))
+        return Ptr<MappedFile>();
+    file->data_ = file->buffer_.data();
+    file->size_ = file->buffer_.size();
+    return file;
+}
+
+Mat MappedFile::view(const Ptr<MappedFile>& file, size_t offset, int dims, const int* sizes, int type)
+{
+    CV_Assert(file);
+    Mat m(dims, sizes, type, file->data_ + offset);
+    const size_t bytes = m.total() * m.elemSize();
+    CV_Assert(offset <= file->size_ && bytes <= file->size_ - offset);
+
+    UMatData* u = new UMatData(&getMappedFileAllocator());
+    u->data = u->origdata = m.data;
+    u->size = bytes;
+    u->userdata = new Ptr<MappedFile>(file);
+    u->refcount = 1;
+    m.u = u;
+    return m;
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
@@ -0,0 +1,54 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef __OPENCV_DNN_MAPPED_FILE_HPP__
+#define __OPENCV_DNN_MAPPED_FILE_HPP__
+
+#include <opencv2/core.hpp>
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+/** @brief Read-only view of a model file.
+ *
+ * The file is mapped into memory with copy-on-write semantics, so matrices created by view() may be
+ * modified without changes of the file. If memory mapping is not available (or disabled
+ * by OPENCV_DNN_MODEL_MMAP=0) the whole file is read into a buffer.
+ */
+class MappedFile
+{
+public:
+    /// Returns empty pointer if the file can't be opened
+    static Ptr<MappedFile> open(const std::string& path);
+
+    ~MappedFile();
+
+    const uchar* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool isMapped() const { return mapped_; }
+
+    /** @brief Returns a matrix which refers to the file data at @p offset without copying.
+     *
+     * The file stays mapped while the matrix (or any of its copies) is alive.
+     */
+    static Mat view(const Ptr<MappedFile>& file, size_t offset, int dims, const int* sizes, int type);
+
+private:
+    MappedFile();
+
+    uchar* data_;
+    size_t size_;
+    bool mapped_;
+    std::vector<uchar> buffer_;
+#ifdef _WIN32
+    void* fileHandle_;
+    void* mappingHandle_;
+#endif
+};
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
+
+#endif  // __OPENCV_DNN_MAPPED_FILE_HPP__
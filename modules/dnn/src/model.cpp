@@ -564,45 +564,16 @@ void DetectionModel::detect(InputArray frame, CV_OUT std::vector<int>& classIds,
 
         if (nmsThreshold)
         {
+            std::vector<int> indices;
             if (getNmsAcrossClasses())
-            {
-                std::vector<int> indices;
                 NMSBoxes(predBoxes, predConfidences, confThreshold, nmsThreshold, indices);
-                for (int idx : indices)
-                {
-                    boxes.push_back(predBoxes[idx]);
-                    confidences.push_back(predConfidences[idx]);
-                    classIds.push_back(predClassIds[idx]);
-                }
-            }
             else
+                NMSBoxesBatched(predBoxes, predConfidences, predClassIds, confThreshold, nmsThreshold, indices);
+            for (int idx : indices)
             {
-                std::map<int, std::vector<size_t> > class2indices;
-                for (size_t i = 0; i < predClassIds.size(); i++)
-                {
-                    if (predConfidences[i] >= confThreshold)
-                    {
-                        class2indices[predClassIds[i]].push_back(i);
-                    }
-                }
-                for (const auto& it : class2indices)
-                {
-                    std::vector<Rect> localBoxes;
-                    std::vector<float> localConfidences;
-                    for (size_t idx : it.second)
-                    {
-                        localBoxes.push_back(predBoxes[idx]);
-                        localConfidences.push_back(predConfidences[idx]);
-                    }
-                    std::vector<int> indices;
-                    NMSBoxes(localBoxes, localConfidences, confThreshold, nmsThreshold, indices);
-                    classIds.resize(classIds.size() + indices.size(), it.first);
-                    for (int idx : indices)
-                    {
-                        boxes.push_back(localBoxes[idx]);
-                        confidences.push_back(localConfidences[idx]);
-                    }
-                }
+                boxes.push_back(predBoxes[idx]);
+                confidences.push_back(predConfidences[idx]);
+                classIds.push_back(predClassIds[idx]);
             }
         }
         else
@@ -77,6 +77,7 @@ Mat Net::forward(const String& outputName)
     CV_TRACE_FUNCTION();
     CV_Assert(impl);
     CV_Assert(!empty());
+    ParallelPartitionScope parallelScope(impl->parallelPartition);
     return impl->forward(outputName);
 }
 
@@ -93,6 +94,7 @@ void Net::forward(OutputArrayOfArrays outputBlobs, const String& outputName)
     CV_TRACE_FUNCTION();
     CV_Assert(impl);
     CV_Assert(!empty());
+    ParallelPartitionScope parallelScope(impl->parallelPartition);
     return impl->forward(outputBlobs, outputName);
 }
 
@@ -102,6 +104,7 @@ void Net::forward(OutputArrayOfArrays outputBlobs,
     CV_TRACE_FUNCTION();
     CV_Assert(impl);
     CV_Assert(!empty());
+    ParallelPartitionScope parallelScope(impl->parallelPartition);
     return impl->forward(outputBlobs, outBlobNames);
 }
 
@@ -111,9 +114,17 @@ void Net::forward(std::vector<std::vector<Mat>>& outputBlobs,
     CV_TRACE_FUNCTION();
     CV_Assert(impl);
     CV_Assert(!empty());
+    ParallelPartitionScope parallelScope(impl->parallelPartition);
     return impl->forward(outputBlobs, outBlobNames);
 }
 
+Net Net::clone() const
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->clone();
+}
+
 // FIXIT drop from inference API
 Net Net::quantize(InputArrayOfArrays calibData, int inputsDtype, int outputsDtype, bool perChannel)
 {
@@ -402,6 +413,27 @@ void Net::enableWinograd(bool useWinograd)
     return impl->enableWinograd(useWinograd);
 }
 
+void Net::enableMemoryPlanner(bool useMemoryPlanner)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->enableMemoryPlanner(useMemoryPlanner);
+}
+
+void Net::setShapePlanCacheSize(int size)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->setShapePlanCacheSize(size);
+}
+
+void Net::setThreadBudget(int numThreads, const std::vector<int>& cpus)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->setThreadBudget(numThreads, cpus);
+}
+
 void Net::setHalideScheduler(const String& scheduler)
 {
     CV_TRACE_FUNCTION();
@@ -417,5 +449,39 @@ int64 Net::getPerfProfile(std::vector<double>& timings)
     return impl->getPerfProfile(timings);
 }
 
+void Net::enableProfiling(bool enable)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->enableProfiling(enable);
+}
+
+std::vector<LayerProfile> Net::getProfile() const
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->profile;
+}
+
+String Net::dumpProfile() const
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->dumpProfile();
+}
+
+void Net::dumpProfileToFile(const String& path) const
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    std::ofstream file(path.c_str());
+    if (!file.is_open())
+        CV_Error(Error::StsError, "DNN: can't open file for writing the profile: " + path);
+    file << dumpProfile();
+    file.close();
+    if (file.fail())
+        CV_Error(Error::StsError, "DNN: can't write the profile: " + path);
+}
+
 CV__DNN_INLINE_NS_END
 }}  // namespace cv::dnn
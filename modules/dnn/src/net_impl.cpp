@@ -5,6 +5,7 @@
 #include "precomp.hpp"
 
 #include "net_impl.hpp"
+#include "layers/fused_elementwise_layer.hpp"
 
 namespace cv {
 namespace dnn {
@@ -56,6 +57,11 @@ Net::Impl::Impl()
     preferableTarget = DNN_TARGET_CPU;
     hasDynamicShapes = false;
     useWinograd = true;
+    useMemoryPlanner = false;
+    profilingEnabled = false;
+    profilingForwardId = -1;
+    profilingStartTicks = 0;
+    shapePlanCacheSize = getParam_DNN_SHAPE_PLAN_CACHE_SIZE();
 }
 
 
@@ -79,6 +85,7 @@ void Net::Impl::clear()
             it->second.internals.clear();
         }
         it->second.skip = false;
+        it->second.fusedLayer.release();
         // it->second.consumers.clear();
         Ptr<Layer> currLayer = it->second.layerInstance;
 
@@ -89,6 +96,7 @@ void Net::Impl::clear()
     }
     netWasAllocated = false;
     layersTimings.clear();
+    asyncExecutor.release();
 }
 
 
@@ -97,7 +105,7 @@ void Net::Impl::validateBackendAndTarget()
     CV_TRACE_FUNCTION();
 
     CV_Assert(preferableBackend != DNN_BACKEND_OPENCV ||
-              preferableTarget == DNN_TARGET_CPU ||
+              IS_DNN_CPU_TARGET(preferableTarget) ||
               preferableTarget == DNN_TARGET_OPENCL ||
               preferableTarget == DNN_TARGET_OPENCL_FP16);
     CV_Assert(preferableBackend != DNN_BACKEND_HALIDE ||
@@ -386,10 +394,56 @@ int Net::Impl::addLayer(const String& name, const String& type, const int& dtype
     if (dtype == CV_8S)
         netWasQuantized = true;
 
+    shapePlans.clear();
     return id;
 }
 
 
+Net Net::Impl::clone() const
+{
+    CV_TRACE_FUNCTION();
+
+    Net dstNet_;
+    Net::Impl& dstNet = *(dstNet_.impl);
+    dstNet.netInputLayer->outNames = netInputLayer->outNames;
+    dstNet.netInputLayer->shapes = netInputLayer->shapes;
+    dstNet.layers[0].dtype = layers.at(0).dtype;
+    dstNet.layers[0].params = layers.at(0).params;
+
+    std::map<int, int> idMap;  // ids of the source net may have gaps
+    idMap[0] = 0;
+    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        const LayerData& ld = it->second;
+        if (ld.id == 0)
+            continue;
+        LayerParams params = ld.params;  // blobs are shallow copies
+        int newLid = dstNet.addLayer(ld.name, ld.type, ld.dtype, params);
+        idMap[ld.id] = newLid;
+        for (int i = 0; i < (int)ld.inputBlobsId.size(); ++i)
+        {
+            const LayerPin& pin = ld.inputBlobsId[i];
+            CV_Assert(idMap.count(pin.lid));
+            dstNet.connect(idMap[pin.lid], pin.oid, newLid, i);
+        }
+    }
+    for (std::map<std::string, int>::const_iterator it = outputNameToId.begin(); it != outputNameToId.end(); ++it)
+        dstNet.outputNameToId.insert(std::make_pair(it->first, idMap[it->second]));
+
+    dstNet.preferableBackend = preferableBackend;
+    dstNet.preferableTarget = preferableTarget;
+    dstNet.halideConfigFile = halideConfigFile;
+    dstNet.hasDynamicShapes = hasDynamicShapes;
+    dstNet.netWasQuantized = netWasQuantized;
+    dstNet.fusion = fusion;
+    dstNet.useWinograd = useWinograd;
+    dstNet.useMemoryPlanner = useMemoryPlanner;
+    dstNet.shapePlanCacheSize = shapePlanCacheSize;
+    dstNet.parallelPartition = parallelPartition;  // clones share the threads of the budget
+    return dstNet_;
+}
+
+
 int Net::Impl::addLayerToPrev(const String& name, const String& type, const int& dtype, LayerParams& params)
 {
     int prvLid = lastLayerId;
@@ -408,6 +462,7 @@ void Net::Impl::connect(int outLayerId, int outNum, int inLayerId, int inNum)
     addLayerInput(ldInp, inNum, LayerPin(outLayerId, outNum));
     ldOut.requiredOutputs.insert(outNum);
     ldOut.consumers.push_back(LayerPin(inLayerId, outNum));
+    shapePlans.clear();
 
     CV_LOG_VERBOSE(NULL, 0, "DNN: connect(" << outLayerId << ":" << outNum << " ==> " << inLayerId << ":" << inNum << ")");
 }
@@ -483,16 +538,39 @@ void Net::Impl::allocateLayer(int lid, const LayersShapesMap& layersShapes)
     for (std::set<int>::const_iterator i = ld.inputLayersId.begin(); i != ld.inputLayersId.end(); i++)
         allocateLayer(*i, layersShapes);
 
-    // bind inputs
+    bindLayerInputs(ld);
+
+    LayersShapesMap::const_iterator layerShapesIt = layersShapes.find(lid);
+
+    CV_Assert(layerShapesIt != layersShapes.end());
+
+    if (preferableBackend == DNN_BACKEND_OPENCV && preferableTarget == DNN_TARGET_OPENCL_FP16 && ld.dtype == CV_32F)
+        ld.dtype = CV_16S;
+
+    std::vector<LayerPin> pinsForInternalBlobs;
+    blobManager.allocateBlobsForLayer(ld, layerShapesIt->second, pinsForInternalBlobs);
+    finalizeLayer(ld);
+
+    // After allocation of layer, we decrease counters to it's input blobs.
+    blobManager.releaseReferences(ld.inputBlobsId);
+    blobManager.releaseReferences(pinsForInternalBlobs);
+
+    ld.flag = 1;
+}
+
+
+void Net::Impl::bindLayerInputs(LayerData& ld)
+{
     if (ld.id == 0)  // DataLayer
     {
-        ninputs = netInputLayer->inputsData.size();
+        size_t ninputs = netInputLayer->inputsData.size();
         ld.inputBlobsWrappers.resize(ninputs);
         for (size_t i = 0; i < ninputs; i++)
             ld.inputBlobsWrappers[i] = wrap(netInputLayer->inputsData[i]);
     }
     else
     {
+        size_t ninputs = ld.inputBlobsId.size();
         ld.inputBlobs.resize(ninputs);
         ld.inputBlobsWrappers.resize(ninputs);
         for (size_t i = 0; i < ninputs; i++)
@@ -504,16 +582,12 @@ void Net::Impl::allocateLayer(int lid, const LayersShapesMap& layersShapes)
             ld.inputBlobsWrappers[i] = layers[from.lid].outputBlobsWrappers[from.oid];
         }
     }
+}
 
-    LayersShapesMap::const_iterator layerShapesIt = layersShapes.find(lid);
-
-    CV_Assert(layerShapesIt != layersShapes.end());
-
-    if (preferableBackend == DNN_BACKEND_OPENCV && preferableTarget == DNN_TARGET_OPENCL_FP16 && ld.dtype == CV_32F)
-        ld.dtype = CV_16S;
 
-    std::vector<LayerPin> pinsForInternalBlobs;
-    blobManager.allocateBlobsForLayer(ld, layerShapesIt->second, pinsForInternalBlobs);
+// Wraps allocated blobs and prepares the layer for their shapes
+void Net::Impl::finalizeLayer(LayerData& ld)
+{
     ld.outputBlobsWrappers.resize(ld.outputBlobs.size());
     for (int i = 0; i < ld.outputBlobs.size(); ++i)
         ld.outputBlobsWrappers[i] = wrap(ld.outputBlobs[i]);
@@ -530,8 +604,8 @@ void Net::Impl::allocateLayer(int lid, const LayersShapesMap& layersShapes)
         {
             inps[i] = *ld.inputBlobs[i];
         }
+        layerPtr->preferableTarget = preferableTarget;  // layers may prepare target specific data in finalize()
         layerPtr->finalize(inps, ld.outputBlobs);
-        layerPtr->preferableTarget = preferableTarget;
 #if 0
         std::cout << "\toutputs:";
         size_t noutputs = ld.outputBlobs.size();
@@ -542,12 +616,6 @@ void Net::Impl::allocateLayer(int lid, const LayersShapesMap& layersShapes)
         std::cout << "\n";
 #endif
     }
-
-    // After allocation of layer, we decrease counters to it's input blobs.
-    blobManager.releaseReferences(ld.inputBlobsId);
-    blobManager.releaseReferences(pinsForInternalBlobs);
-
-    ld.flag = 1;
 }
 
 
@@ -572,8 +640,6 @@ void Net::Impl::allocateLayers(const std::vector<LayerPin>& blobsToKeep_)
         }
         inputShapes.push_back(shape(inp));
     }
-    LayersShapesMap layersShapes;
-    getLayersShapes(inputShapes, layersShapes);
 
     blobManager.reset();
     backendWrappers.clear();
@@ -586,28 +652,381 @@ void Net::Impl::allocateLayers(const std::vector<LayerPin>& blobsToKeep_)
         ld.internalBlobsWrappers.clear();
     }
 
-    // Fake references to input blobs.
-    for (int i = 0; i < layers[0].outputBlobs.size(); ++i)
-        blobManager.addReference(LayerPin(0, i));
+    if (!restoreShapePlan(inputShapes, blobsToKeep_))
+    {
+        LayersShapesMap layersShapes;
+        getLayersShapes(inputShapes, layersShapes);
+
+        // Fake references to input blobs.
+        for (int i = 0; i < layers[0].outputBlobs.size(); ++i)
+            blobManager.addReference(LayerPin(0, i));
+        for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
+        {
+            const LayerData& ld = it->second;
+            blobManager.addReferences(ld.inputBlobsId);
+        }
+
+        for (int i = 0; i < blobsToKeep_.size(); i++)
+        {
+            blobManager.addReference(blobsToKeep_[i]);
+        }
+
+        for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); it++)
+        {
+            int lid = it->first;
+            allocateLayer(lid, layersShapes);
+        }
+
+        storeShapePlan(inputShapes, blobsToKeep_);
+    }
+
+    layersTimings.resize(lastLayerId + 1, 0);
+    fuseLayers(blobsToKeep_);
+
+    if (useMemoryPlanner && preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget) &&
+        !getParam_DNN_DISABLE_MEMORY_OPTIMIZATIONS())
+    {
+        planMemory(blobsToKeep_);
+    }
+}
+
+
+void Net::Impl::setShapePlanCacheSize(int size)
+{
+    CV_CheckGE(size, 0, "");
+    shapePlanCacheSize = (size_t)size;
+    if (shapePlans.size() > shapePlanCacheSize)
+        shapePlans.resize(shapePlanCacheSize);
+}
+
+
+void Net::Impl::setThreadBudget(int numThreads, const std::vector<int>& cpus)
+{
+    CV_CheckGE(numThreads, 0, "");
+    if (numThreads == 0 && cpus.empty())
+        parallelPartition.release();
+    else
+        parallelPartition = ParallelPartition::create(numThreads, cpus);
+}
+
+
+bool Net::Impl::restoreShapePlan(const ShapesVec& inputShapes, const std::vector<LayerPin>& blobsToKeep_)
+{
+    if (shapePlanCacheSize == 0 || preferableBackend != DNN_BACKEND_OPENCV || !IS_DNN_CPU_TARGET(preferableTarget))
+        return false;
+
+    std::list<ShapePlan>::iterator planIt = shapePlans.begin();
+    for (; planIt != shapePlans.end(); ++planIt)
+    {
+        if (planIt->inputShapes == inputShapes && planIt->blobsToKeep == blobsToKeep_)
+            break;
+    }
+    if (planIt == shapePlans.end())
+        return false;
+    shapePlans.splice(shapePlans.begin(), shapePlans, planIt);
+    const ShapePlan& plan = shapePlans.front();
+    CV_TRACE_FUNCTION();
+
+    // Buffers are allocated as rows, so blobs are their continuous ranges
+    std::vector<Mat> hosts(plan.hosts.size());
+    for (size_t i = 0; i < hosts.size(); ++i)
+        hosts[i].create(1, plan.hosts[i].second, plan.hosts[i].first);
+    std::vector<Mat> inputs(layers[0].outputBlobs.size());
+    for (size_t i = 0; i < inputs.size(); ++i)
+        inputs[i] = layers[0].outputBlobs[i].reshape(1, 1);
+
+    // Network inputs are owned by the input layer, they are set by setInput()
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        if (ld.id == 0)
+            continue;
+        for (int k = 0; k < 2; ++k)
+        {
+            const std::map<int, std::vector<ShapePlan::Blob> >& planBlobs = k == 0 ? plan.outputBlobs : plan.internals;
+            std::map<int, std::vector<ShapePlan::Blob> >::const_iterator blobsIt = planBlobs.find(ld.id);
+            CV_Assert(blobsIt != planBlobs.end());
+            std::vector<Mat>& blobs = k == 0 ? ld.outputBlobs : ld.internals;
+            blobs.resize(blobsIt->second.size());
+            for (size_t i = 0; i < blobs.size(); ++i)
+            {
+                const ShapePlan::Blob& b = blobsIt->second[i];
+                if (b.shape.empty())
+                {
+                    blobs[i].release();
+                    continue;
+                }
+                const Mat& host = b.host >= 0 ? hosts[b.host] : inputs[-1 - b.host];
+                blobs[i] = host.colRange((int)b.offset, (int)(b.offset + total(b.shape))).reshape(1, b.shape);
+            }
+        }
+    }
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        bindLayerInputs(ld);
+        finalizeLayer(ld);
+        ld.flag = 1;
+    }
+    CV_LOG_DEBUG(NULL, "DNN: restored execution plan for input shapes " << inputShapes[0] << " (" << shapePlans.size() << " cached plans)");
+    return true;
+}
+
+
+void Net::Impl::storeShapePlan(const ShapesVec& inputShapes, const std::vector<LayerPin>& blobsToKeep_)
+{
+    if (shapePlanCacheSize == 0 || preferableBackend != DNN_BACKEND_OPENCV || !IS_DNN_CPU_TARGET(preferableTarget))
+        return;
+    CV_TRACE_FUNCTION();
+
+    ShapePlan plan;
+    plan.inputShapes = inputShapes;
+    plan.blobsToKeep = blobsToKeep_;
+    plan.footprint = sizeof(plan) + (inputShapes.size() * inputShapes[0].size() + blobsToKeep_.size() * 2) * sizeof(int);
+
+    std::map<const uchar*, int> hostIds;  // network inputs and the buffers shared by the blobs
+    for (size_t i = 0; i < layers[0].outputBlobs.size(); ++i)
+        hostIds[layers[0].outputBlobs[i].data] = -1 - (int)i;
     for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
     {
         const LayerData& ld = it->second;
-        blobManager.addReferences(ld.inputBlobsId);
+        if (ld.id == 0)
+            continue;
+        for (int k = 0; k < 2; ++k)
+        {
+            const std::vector<Mat>& blobs = k == 0 ? ld.outputBlobs : ld.internals;
+            std::vector<ShapePlan::Blob>& planBlobs = k == 0 ? plan.outputBlobs[ld.id] : plan.internals[ld.id];
+            planBlobs.resize(blobs.size());
+            for (size_t i = 0; i < blobs.size(); ++i)
+            {
+                const Mat& m = blobs[i];
+                ShapePlan::Blob& b = planBlobs[i];
+                b.host = 0;
+                b.offset = 0;
+                plan.footprint += sizeof(b) + m.dims * sizeof(int);
+                if (m.empty())
+                    continue;
+                // the blob is a continuous part of the network input or a buffer of the same type
+                const uchar* hostData = m.u ? m.u->data : NULL;
+                const Mat* input = NULL;
+                for (size_t j = 0; j < layers[0].outputBlobs.size() && !input; ++j)
+                {
+                    const Mat& inp = layers[0].outputBlobs[j];
+                    if (m.u && m.u == inp.u)
+                        input = &inp;
+                }
+                if (input)
+                    hostData = input->data;
+                if (!hostData || !m.isContinuous() || m.channels() != 1 || (m.data - hostData) % m.elemSize() != 0 ||
+                    (input && input->type() != m.type()))
+                {
+                    CV_LOG_DEBUG(NULL, "DNN: execution plan isn't stored: unsupported blob of layer " << ld.name);
+                    return;
+                }
+                std::map<const uchar*, int>::iterator hostIt = hostIds.find(hostData);
+                if (hostIt == hostIds.end())
+                {
+                    const size_t hostTotal = m.u->size / m.elemSize();
+                    if (hostTotal > (size_t)INT_MAX)
+                        return;
+                    hostIt = hostIds.insert(std::make_pair(hostData, (int)plan.hosts.size())).first;
+                    plan.hosts.push_back(std::make_pair(m.type(), (int)hostTotal));
+                }
+                else if (hostIt->second >= 0 && plan.hosts[hostIt->second].first != m.type())
+                    return;
+                b.shape = shape(m);
+                b.host = hostIt->second;
+                b.offset = (m.data - hostData) / m.elemSize();
+            }
+        }
     }
+    plan.footprint += plan.hosts.size() * sizeof(plan.hosts[0]);
 
-    for (int i = 0; i < blobsToKeep_.size(); i++)
+    shapePlans.push_front(plan);
+    // the most recent plan is kept regardless of its size
+    size_t footprint = 0;
+    const size_t maxBytes = getParam_DNN_SHAPE_PLAN_CACHE_MAX_BYTES();
+    std::list<ShapePlan>::iterator it = shapePlans.begin();
+    for (size_t n = 0; it != shapePlans.end(); ++it, ++n)
     {
-        blobManager.addReference(blobsToKeep_[i]);
+        footprint += it->footprint;
+        if (n > 0 && (n >= shapePlanCacheSize || footprint > maxBytes))
+            break;
     }
+    shapePlans.erase(it, shapePlans.end());
+}
 
-    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); it++)
+
+void Net::Impl::planMemory(const std::vector<LayerPin>& blobsToKeep_)
+{
+    CV_TRACE_FUNCTION();
+
+    // Each allocated buffer (host) may be shared by several blobs: in-place layers, fused layers
+    // and concatenation slices. Layers are executed in order of their ids, so a lifetime of a host
+    // is a range of execution steps which write or read any blob located in it.
+    struct HostInfo
     {
-        int lid = it->first;
-        allocateLayer(lid, layersShapes);
+        size_t size;
+        int first, last;
+        bool pinned;  // kept out of the arena: network inputs, outputs and blobs to keep
+        bool input;
+        size_t offset;
+    };
+    std::map<const UMatData*, HostInfo> hosts;
+
+    std::set<const Mat*> consumedBlobs;
+    std::set<LayerPin> consumedPins;
+    int step = 0;
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it, ++step)
+    {
+        LayerData& ld = it->second;
+        std::vector<const Mat*> blobs;
+        for (size_t i = 0; i < ld.outputBlobs.size(); ++i)
+            blobs.push_back(&ld.outputBlobs[i]);
+        for (size_t i = 0; i < ld.internals.size(); ++i)
+            blobs.push_back(&ld.internals[i]);
+        for (size_t i = 0; i < ld.inputBlobs.size(); ++i)
+        {
+            if (ld.inputBlobs[i])
+            {
+                blobs.push_back(ld.inputBlobs[i]);
+                consumedBlobs.insert(ld.inputBlobs[i]);
+            }
+        }
+        consumedPins.insert(ld.inputBlobsId.begin(), ld.inputBlobsId.end());
+        // inputs of a fused chain are read by its last layer
+        Ptr<FusedElementwiseLayer> fusedChain = ld.fusedLayer.dynamicCast<FusedElementwiseLayer>();
+        if (fusedChain)
+            blobs.insert(blobs.end(), fusedChain->inputs.begin(), fusedChain->inputs.end());
+
+        for (size_t i = 0; i < blobs.size(); ++i)
+        {
+            const Mat& m = *blobs[i];
+            if (m.empty() || !m.u)
+                continue;
+            std::map<const UMatData*, HostInfo>::iterator hostIt = hosts.find(m.u);
+            if (hostIt == hosts.end())
+            {
+                HostInfo info = { m.u->size, step, step, false, false, 0 };
+                hostIt = hosts.insert(std::make_pair(m.u, info)).first;
+            }
+            HostInfo& host = hostIt->second;
+            host.first = std::min(host.first, step);
+            host.last = std::max(host.last, step);
+            host.pinned = host.pinned || !m.isContinuous();
+        }
     }
 
-    layersTimings.resize(lastLayerId + 1, 0);
-    fuseLayers(blobsToKeep_);
+    // Network inputs, outputs and requested blobs are visible to the user and must not be overwritten.
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        for (int i = 0; i < (int)ld.outputBlobs.size(); ++i)
+        {
+            const Mat& m = ld.outputBlobs[i];
+            if (m.empty() || !m.u)
+                continue;
+            HostInfo& host = hosts[m.u];
+            if (ld.id == 0)
+                host.pinned = host.input = true;
+            else if (consumedBlobs.count(&m) == 0 && consumedPins.count(LayerPin(ld.id, i)) == 0)
+                host.pinned = true;
+        }
+    }
+    for (size_t i = 0; i < blobsToKeep_.size(); ++i)
+    {
+        const LayerPin& pin = blobsToKeep_[i];
+        MapIdToLayerData::iterator it = layers.find(pin.lid);
+        if (it == layers.end() || pin.oid >= (int)it->second.outputBlobs.size())
+            continue;
+        const Mat& m = it->second.outputBlobs[pin.oid];
+        if (!m.empty() && m.u)
+            hosts[m.u].pinned = true;
+    }
+
+    // Greedy by size offset assignment: the largest hosts are placed first into the best fitting gap
+    // between hosts which are alive at the same time.
+    const size_t alignment = 64;
+    std::vector<HostInfo*> order;
+    size_t plannedMemory = 0;
+    for (std::map<const UMatData*, HostInfo>::iterator it = hosts.begin(); it != hosts.end(); ++it)
+    {
+        HostInfo& host = it->second;
+        if (!host.pinned)
+            order.push_back(&host);
+        else if (!host.input)
+            plannedMemory += host.size;
+    }
+    std::stable_sort(order.begin(), order.end(), [](const HostInfo* a, const HostInfo* b) { return a->size > b->size; });
+
+    size_t arenaSize = 0;
+    std::vector<HostInfo*> placed;
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        HostInfo& host = *order[i];
+        const size_t size = alignSize(host.size, alignment);
+
+        std::vector<HostInfo*> alive;
+        for (size_t j = 0; j < placed.size(); ++j)
+        {
+            if (placed[j]->first <= host.last && host.first <= placed[j]->last)
+                alive.push_back(placed[j]);
+        }
+        std::sort(alive.begin(), alive.end(), [](const HostInfo* a, const HostInfo* b) { return a->offset < b->offset; });
+
+        size_t bestOffset = 0, bestGap = std::numeric_limits<size_t>::max(), end = 0;
+        bool found = false;
+        for (size_t j = 0; j < alive.size(); ++j)
+        {
+            if (alive[j]->offset > end)
+            {
+                size_t gap = alive[j]->offset - end;
+                if (gap >= size && gap < bestGap)
+                {
+                    bestOffset = end;
+                    bestGap = gap;
+                    found = true;
+                }
+            }
+            end = std::max(end, alive[j]->offset + alignSize(alive[j]->size, alignment));
+        }
+        host.offset = found ? bestOffset : end;
+        arenaSize = std::max(arenaSize, host.offset + size);
+        placed.push_back(&host);
+    }
+
+    // The arena is a continuous 2D buffer: size of a row is limited by INT_MAX, but not the total size
+    Mat arena;
+    if (arenaSize > 0)
+    {
+        const size_t rowSize = arenaSize <= (size_t)INT_MAX ? arenaSize : (size_t)1 << 20;
+        arena.create((int)divUp(arenaSize, (unsigned)rowSize), (int)rowSize, CV_8U);
+        CV_Assert(arena.isContinuous());
+    }
+    CV_LOG_DEBUG(NULL, "DNN: memory planner placed " << order.size() << " blobs into " << arenaSize << " bytes arena");
+
+    // Rebind blobs to the arena. Mat objects are modified in place, so pointers to them remain valid.
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        for (int k = 0; k < 2; ++k)
+        {
+            std::vector<Mat>& blobs = k == 0 ? ld.outputBlobs : ld.internals;
+            for (size_t i = 0; i < blobs.size(); ++i)
+            {
+                Mat& m = blobs[i];
+                if (m.empty() || !m.u)
+                    continue;
+                const HostInfo& host = hosts[m.u];
+                if (host.pinned)
+                    continue;
+                uchar* data = arena.ptr() + host.offset + (m.data - m.u->data);
+                m = Mat(m.dims, m.size.p, m.type(), data);
+            }
+        }
+    }
+
+    blobManager.setArena(arena, plannedMemory + arenaSize);
 }
 
 
@@ -724,7 +1143,10 @@ void Net::Impl::forwardLayer(LayerData& ld)
                 {
                     inps[i] = *ld.inputBlobs[i];
                 }
-                layer->forward(inps, ld.outputBlobs, ld.internals);
+                if (ld.fusedLayer)
+                    ld.fusedLayer->forward(inps, ld.outputBlobs, ld.internals);
+                else
+                    layer->forward(inps, ld.outputBlobs, ld.internals);
 
                 if (getParam_DNN_CHECK_NAN_INF())
                 {
@@ -844,6 +1266,8 @@ void Net::Impl::forwardLayer(LayerData& ld)
         tm.stop();
         int64 t = tm.getTimeTicks();
         layersTimings[ld.id] = (t > 0) ? t : t + 1;  // zero for skipped layers only
+        if (profilingEnabled)
+            recordLayerProfile(ld, t);
     }
     else
     {
@@ -862,6 +1286,8 @@ void Net::Impl::forwardToLayer(LayerData& ld, bool clearFlags)
     {
         for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); it++)
             it->second.flag = 0;
+        if (profilingEnabled)
+            profilingForwardId++;
     }
 
     // already was forwarded
@@ -924,11 +1350,14 @@ AsyncArray Net::Impl::forwardAsync(const String& outputName)
         layerName = layerNames.back();
     }
 
+    if (preferableBackend == DNN_BACKEND_OPENCV)
+        return forwardAsyncOpenCV(layerName);
+
     std::vector<LayerPin> pins(1, getPinByAlias(layerName));
     setUpNet(pins);
 
     if (preferableBackend != DNN_BACKEND_INFERENCE_ENGINE_NGRAPH)
-        CV_Error(Error::StsNotImplemented, "DNN: Asynchronous forward is supported for Inference Engine backend only");
+        CV_Error(Error::StsNotImplemented, "DNN: Asynchronous forward is supported for OpenCV and Inference Engine backends only");
 
     isAsync = true;
     forwardToLayer(getLayerData(layerName));
@@ -972,7 +1401,7 @@ void Net::Impl::forward(OutputArrayOfArrays outputBlobs, const String& outputNam
     }
     else if (outputBlobs.isMatVector())
     {
-        if (preferableTarget != DNN_TARGET_CPU)
+        if (!IS_DNN_CPU_TARGET(preferableTarget))
         {
             for (int i = 0; i < ld.outputBlobsWrappers.size(); ++i)
             {
@@ -1336,7 +1765,7 @@ Mat Net::Impl::getBlob(const LayerPin& pin) const
                                               "the #%d was requested",
                                                ld.name.c_str(), ld.outputBlobs.size(), pin.oid));
     }
-    if (preferableTarget != DNN_TARGET_CPU)
+    if (!IS_DNN_CPU_TARGET(preferableTarget))
     {
         CV_Assert(!ld.outputBlobsWrappers.empty() && !ld.outputBlobsWrappers[pin.oid].empty());
         // Transfer data to CPU if it's require.
@@ -1466,6 +1895,9 @@ void Net::Impl::setParam(int layer, int numParam, const Mat& blob)
     CV_Assert(numParam < (int)layerBlobs.size());
     // we don't make strong checks, use this function carefully
     layerBlobs[numParam] = blob;
+    if (numParam < (int)ld.params.blobs.size())
+        ld.params.blobs[numParam] = blob;  // used by clone()
+    asyncExecutor.release();
 }
 
 
@@ -1718,6 +2150,10 @@ string Net::Impl::dump(bool forceAllocation) const
             out << "CPU";
             colorId = layerBackend.empty() ? 0 : 5;
             break;
+        case DNN_TARGET_CPU_FP16:
+            out << "CPU_FP16";
+            colorId = layerBackend.empty() ? 0 : 5;
+            break;
         case DNN_TARGET_OPENCL:
             out << "OCL";
             colorId = 1;
@@ -1993,6 +2429,17 @@ void Net::Impl::getMemoryConsumption(
         weights += w[i];
         blobs += b[i];
     }
+
+    // Report the planned memory if the net has been allocated for the same input shapes
+    if (useMemoryPlanner && netWasAllocated && blobManager.getPlannedMemory() > 0)
+    {
+        const std::vector<Mat>& inputs = layers[0].outputBlobs;
+        bool sameShapes = inputs.size() == netInputShapes.size();
+        for (size_t i = 0; sameShapes && i < inputs.size(); ++i)
+            sameShapes = shape(inputs[i]) == netInputShapes[i];
+        if (sameShapes)
+            blobs = blobManager.getPlannedMemory();
+    }
 }
 
 
@@ -2071,6 +2518,16 @@ void Net::Impl::enableWinograd(bool useWinograd_)
 }
 
 
+void Net::Impl::enableMemoryPlanner(bool useMemoryPlanner_)
+{
+    if (useMemoryPlanner != useMemoryPlanner_)
+    {
+        useMemoryPlanner = useMemoryPlanner_;
+        clear();
+    }
+}
+
+
 // TODO drop?
 void Net::Impl::getLayerTypes(std::vector<String>& layersTypes) const
 {
@@ -21,6 +21,8 @@
 
 #include <opencv2/core/utils/logger.hpp>
 
+#include <list>
+
 #include "layer_internals.hpp"  // LayerPin LayerData DataLayer
 
 #include "legacy_backend.hpp"  // wrapMat BlobManager OpenCLBackendWrapper
@@ -65,8 +67,39 @@ struct Net::Impl : public detail::NetImplBase
     bool fusion;
     bool isAsync;  // FIXIT: drop
     bool useWinograd;
+    bool useMemoryPlanner;
     std::vector<int64> layersTimings;
 
+    bool profilingEnabled;
+    int profilingForwardId;
+    int64 profilingStartTicks;
+    std::vector<LayerProfile> profile;
+
+    // Execution plans of recently used input shapes, the most recently used plan is the first one.
+    // A plan keeps shapes of the blobs and their offsets in the memory buffers shared by the blobs,
+    // the buffers are allocated again on restore. Plans are stored before fusion and memory planning
+    // which are repeated after restoring of a plan.
+    struct ShapePlan
+    {
+        struct Blob
+        {
+            MatShape shape;  // empty for empty blobs
+            int host;        // index of the buffer, -1-i for the i-th network input
+            size_t offset;   // in elements
+        };
+        ShapesVec inputShapes;
+        std::vector<LayerPin> blobsToKeep;
+        std::vector<std::pair<int, int> > hosts;  // type and number of elements of the buffers
+        std::map<int, std::vector<Blob> > outputBlobs;
+        std::map<int, std::vector<Blob> > internals;
+        size_t footprint;  // memory used by the plan itself
+    };
+    std::list<ShapePlan> shapePlans;
+    size_t shapePlanCacheSize;
+
+    // Threads of the network, the global thread pool if empty
+    Ptr<ParallelPartition> parallelPartition;
+
 
     virtual bool empty() const;
     virtual void setPreferableBackend(Net& net, int backendId);
@@ -207,21 +240,44 @@ struct Net::Impl : public detail::NetImplBase
 #endif
 
     void allocateLayer(int lid, const LayersShapesMap& layersShapes);
+    void bindLayerInputs(LayerData& ld);
+    void finalizeLayer(LayerData& ld);
 
     // TODO add getter
     void enableFusion(bool fusion_);
 
     virtual void fuseLayers(const std::vector<LayerPin>& blobsToKeep_);
+    void fuseElementwiseChains(const std::set<LayerPin>& pinsToKeep);
+    void removeLayoutRoundTrips(const std::set<LayerPin>& pinsToKeep);
     void enableWinograd(bool useWinograd_);
+    void enableMemoryPlanner(bool useMemoryPlanner_);
 
     void allocateLayers(const std::vector<LayerPin>& blobsToKeep_);
 
+    void setShapePlanCacheSize(int size);
+    void setThreadBudget(int numThreads, const std::vector<int>& cpus);
+    // Returns false if there is no plan for the input shapes
+    bool restoreShapePlan(const ShapesVec& inputShapes, const std::vector<LayerPin>& blobsToKeep_);
+    void storeShapePlan(const ShapesVec& inputShapes, const std::vector<LayerPin>& blobsToKeep_);
+
+    // Packs intermediate blobs into a single arena using their lifetimes (see net_impl.cpp)
+    void planMemory(const std::vector<LayerPin>& blobsToKeep_);
+
     virtual void forwardLayer(LayerData& ld);
 
     void forwardToLayer(LayerData& ld, bool clearFlags = true);
 
     Mat forward(const String& outputName);
     AsyncArray forwardAsync(const String& outputName);
+
+    // Asynchronous execution on DNN_BACKEND_OPENCV with a pool of execution contexts (see net_impl_async.cpp)
+    struct AsyncExecutor;
+    Ptr<AsyncExecutor> asyncExecutor;
+    AsyncArray forwardAsyncOpenCV(const String& layerName);
+
+    // Creates a new network with the same layers and connections.
+    // Layer parameters (including weights) are shared, activation blobs are not.
+    Net clone() const;
     void forward(OutputArrayOfArrays outputBlobs, const String& outputName);
     void forward(OutputArrayOfArrays outputBlobs,
             const std::vector<String>& outBlobNames);
@@ -264,6 +320,10 @@ struct Net::Impl : public detail::NetImplBase
             std::vector<size_t>& blobs) /*const*/;
     int64 getPerfProfile(std::vector<double>& timings) const;
 
+    void enableProfiling(bool enable);
+    void recordLayerProfile(LayerData& ld, int64 ticks);
+    String dumpProfile() const;
+
     // TODO drop
     LayerPin getLatestLayerPin(const std::vector<LayerPin>& pins) const;
 
@@ -0,0 +1,171 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+#include <opencv2/core/detail/async_promise.hpp>
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+
+// Runs requests of Net::forwardAsync() on DNN_BACKEND_OPENCV.
+// Each worker thread owns an execution context: a clone of the network which shares weights
+// with the origin but has its own activation blobs. Requests are overlapped across the contexts.
+struct Net::Impl::AsyncExecutor
+{
+    struct Request
+    {
+        std::vector<Mat> inputs;
+        std::vector<String> inputNames;
+        std::vector<double> scaleFactors;
+        std::vector<Scalar> means;
+        String outputName;
+        AsyncPromise promise;
+    };
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque< Ptr<Request> > queue;
+    bool stopped;
+    std::vector<Net> contexts;
+    std::vector<std::thread> workers;
+
+    AsyncExecutor(const Net::Impl& net, int numContexts)
+        : stopped(false)
+    {
+        CV_TRACE_FUNCTION();
+        CV_Assert(numContexts > 0);
+        for (int i = 0; i < numContexts; ++i)
+            contexts.push_back(net.clone());
+        for (int i = 0; i < numContexts; ++i)
+            workers.push_back(std::thread(&AsyncExecutor::run, this, i));
+    }
+
+    ~AsyncExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        cond.notify_all();
+        for (size_t i = 0; i < workers.size(); ++i)
+            workers[i].join();
+    }
+
+    AsyncArray submit(const Ptr<Request>& request)
+    {
+        AsyncArray result = request->promise.getArrayResult();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(request);
+        }
+        cond.notify_one();
+        return result;
+    }
+
+    void run(int contextId)
+    {
+        Net& context = contexts[contextId];
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            cond.wait(lock, [this]() { return stopped || !queue.empty(); });
+            if (queue.empty())
+                return;  // stopped, all requests are processed
+            Ptr<Request> request = queue.front();
+            queue.pop_front();
+            lock.unlock();
+            process(context, *request);
+            lock.lock();
+        }
+    }
+
+    static void process(Net& context, Request& request)
+    {
+        CV_TRACE_FUNCTION();
+        try
+        {
+            for (size_t i = 0; i < request.inputs.size(); ++i)
+                context.setInput(request.inputs[i], request.inputNames[i], request.scaleFactors[i], request.means[i]);
+            // Output blob is reused by the next request of the context
+            request.promise.setValue(context.forward(request.outputName).clone());
+        }
+        catch (const cv::Exception& e)
+        {
+            request.promise.setException(e);
+        }
+#if CV__EXCEPTION_PTR
+        catch (...)
+        {
+            request.promise.setException(std::current_exception());
+        }
+#endif
+    }
+};
+
+#else  // OPENCV_DISABLE_THREAD_SUPPORT
+
+struct Net::Impl::AsyncExecutor
+{
+    // nothing
+};
+
+#endif  // OPENCV_DISABLE_THREAD_SUPPORT
+
+
+AsyncArray Net::Impl::forwardAsyncOpenCV(const String& layerName)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(preferableBackend == DNN_BACKEND_OPENCV);
+
+    LayerPin pin = getPinByAlias(layerName);
+    if (!pin.valid())
+        CV_Error(Error::StsObjectNotFound, "Requested layer \"" + layerName + "\" not found");
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+    const DataLayer& inputLayer = *netInputLayer;
+    Ptr<AsyncExecutor::Request> request = makePtr<AsyncExecutor::Request>();
+    request->inputs.resize(inputLayer.inputsData.size());
+    request->inputNames.resize(inputLayer.inputsData.size());
+    for (size_t i = 0; i < inputLayer.inputsData.size(); ++i)
+    {
+        if (inputLayer.inputsData[i].empty())
+            CV_Error(Error::StsError, cv::format("DNN: input #%d is not set", (int)i));
+        inputLayer.inputsData[i].copyTo(request->inputs[i]);  // the caller may set new inputs right after
+        if (i < inputLayer.outNames.size())
+            request->inputNames[i] = inputLayer.outNames[i];
+        else
+            CV_CheckEQ(i, (size_t)0, "DNN: inputs should be named");
+    }
+    request->scaleFactors = inputLayer.scaleFactors;
+    request->means = inputLayer.means;
+    request->outputName = layerName;
+
+    if (!asyncExecutor)
+        asyncExecutor = makePtr<AsyncExecutor>(*this, (int)std::max((size_t)1, getParam_DNN_ASYNC_CONTEXTS()));
+    return asyncExecutor->submit(request);
+#else
+    AsyncPromise promise;
+    AsyncArray result = promise.getArrayResult();
+    promise.setValue(forward(layerName).clone());
+    return result;
+#endif
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
@@ -17,7 +17,7 @@ CV__DNN_INLINE_NS_BEGIN
 
 Ptr<BackendWrapper> Net::Impl::wrap(Mat& host)
 {
-    if (preferableBackend == DNN_BACKEND_OPENCV && preferableTarget == DNN_TARGET_CPU)
+    if (preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget))
         return Ptr<BackendWrapper>();
 
     MatShape shape(host.dims);
@@ -100,7 +100,7 @@ void Net::Impl::initBackend(const std::vector<LayerPin>& blobsToKeep_)
     CV_TRACE_FUNCTION();
     if (preferableBackend == DNN_BACKEND_OPENCV)
     {
-        CV_Assert(preferableTarget == DNN_TARGET_CPU || IS_DNN_OPENCL_TARGET(preferableTarget));
+        CV_Assert(IS_DNN_CPU_TARGET(preferableTarget) || IS_DNN_OPENCL_TARGET(preferableTarget));
     }
     else if (preferableBackend == DNN_BACKEND_HALIDE)
     {
@@ -170,6 +170,7 @@ void Net::Impl::setPreferableBackend(Net& net, int backendId)
     if (preferableBackend != backendId)
     {
         clear();
+        shapePlans.clear();
         if (backendId == DNN_BACKEND_INFERENCE_ENGINE_NGRAPH)
         {
 #if defined(HAVE_INF_ENGINE)
@@ -190,7 +191,7 @@ void Net::Impl::setPreferableBackend(Net& net, int backendId)
 
 void Net::Impl::setPreferableTarget(int targetId)
 {
-    if (netWasQuantized && targetId != DNN_TARGET_CPU &&
+    if (netWasQuantized && !IS_DNN_CPU_TARGET(targetId) &&
         targetId != DNN_TARGET_OPENCL && targetId != DNN_TARGET_OPENCL_FP16 && targetId != DNN_TARGET_NPU)
     {
         CV_LOG_WARNING(NULL, "DNN: Only CPU, OpenCL/OpenCL FP16 and NPU targets are supported by quantized networks");
@@ -217,6 +218,7 @@ void Net::Impl::setPreferableTarget(int targetId)
 #endif
         }
         clear();
+        shapePlans.clear();
     }
 }
 
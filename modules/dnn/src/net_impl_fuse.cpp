@@ -5,6 +5,7 @@
 #include "precomp.hpp"
 
 #include "net_impl.hpp"
+#include "layers/fused_elementwise_layer.hpp"
 
 #ifdef HAVE_CUDA
 #include "cuda4dnn/primitives/eltwise.hpp"  // required by fuseLayers
@@ -773,8 +774,586 @@ void Net::Impl::fuseLayers(const std::vector<LayerPin>& blobsToKeep_)
             }
         }
     }
+
+    if (preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget))
+    {
+        removeLayoutRoundTrips(pinsToKeep);
+        fuseElementwiseChains(pinsToKeep);
+    }
+}
+
+
+// Returns order of axes of the layer if it's Permute which really moves the data
+static bool getPermuteOrder(const LayerData& ld, std::vector<int>& order)
+{
+    order.clear();
+    if (ld.layerInstance.dynamicCast<PermuteLayer>().empty() || !ld.params.has("order") ||
+        ld.inputBlobsId.size() != 1 || ld.outputBlobs.size() != 1)
+        return false;
+    const DictValue& param = ld.params.get("order");
+    bool identity = true;
+    for (int i = 0; i < param.size(); ++i)
+    {
+        order.push_back(param.get<int>(i));
+        identity = identity && order[i] == i;
+    }
+    return !identity;
+}
+
+static bool sharesData(const Mat& a, const Mat& b)
+{
+    return !a.empty() && !b.empty() && (a.u ? a.u == b.u : a.data == b.data);
+}
+
+// Activation fused into the previous layer: it's skipped and refers to output of that layer
+static bool isFusedActivation(Net::Impl::MapIdToLayerData& layers, const LayerData& ld)
+{
+    if (!ld.skip || ld.inputBlobsId.size() != 1 || ld.outputBlobs.size() != 1 ||
+        ld.layerInstance.dynamicCast<ActivationLayer>().empty())
+        return false;
+    const LayerData& prev = layers[ld.inputBlobsId[0].lid];
+    return prev.outputBlobs.size() == 1 && prev.consumers.size() == 1 &&
+           prev.outputBlobs[0].data == ld.outputBlobs[0].data;
+}
+
+// Returns the layer and the activations fused into it, all of them refer to the same output
+static void getOutputChain(Net::Impl::MapIdToLayerData& layers, LayerData& ld, std::vector<LayerData*>& chain)
+{
+    chain.assign(1, &ld);
+    while (chain.back()->consumers.size() == 1)
+    {
+        LayerData& next = layers[chain.back()->consumers[0].lid];
+        if (!isFusedActivation(layers, next))
+            break;
+        chain.push_back(&next);
+    }
+}
+
+// Returns true for layers which give the same result for data in any layout. Element-wise layers
+// must have inputs of the same shape (no broadcasting), Concat layer is recreated for another axis.
+static bool isLayoutAgnostic(const LayerData& ld)
+{
+    if (ld.skip || ld.dtype != CV_32F || ld.outputBlobs.size() != 1 || ld.inputBlobs.size() != ld.inputBlobsId.size())
+        return false;
+    const Mat& out = ld.outputBlobs[0];
+    if (out.type() != CV_32F || !out.isContinuous() || out.empty())
+        return false;
+    const Ptr<Layer>& layer = ld.layerInstance;
+    if (!layer.dynamicCast<ActivationLayer>().empty())
+        return ld.inputBlobsId.size() == 1 && layer->blobs.empty();
+    Ptr<ConcatLayer> concat = layer.dynamicCast<ConcatLayer>();
+    if (concat)
+        return !concat->padding;
+    if (layer.dynamicCast<EltwiseLayer>().empty() && layer.dynamicCast<NaryEltwiseLayer>().empty())
+        return false;
+    for (size_t i = 0; i < ld.inputBlobs.size(); ++i)
+    {
+        if (shape(*ld.inputBlobs[i]) != shape(out))
+            return false;
+    }
+    return true;
 }
 
+// Permute layers which convert data to another layout (entries), layers which don't depend on the layout
+// and Permute layers which convert the data back (exits). If the permutations are skipped, the layers
+// in between compute the same values for data in the original layout.
+struct LayoutRegion
+{
+    LayoutRegion(Net::Impl::MapIdToLayerData& layers_, const std::set<LayerPin>& pinsToKeep_, const std::vector<int>& order_)
+        : layers(layers_), pinsToKeep(pinsToKeep_), order(order_)
+    {}
+
+    bool isEntry(const LayerData& ld) const
+    {
+        std::vector<int> permutation;
+        if (ld.skip || ld.dtype != CV_32F || !getPermuteOrder(ld, permutation) || permutation != order ||
+            !ld.inputBlobs[0] || !ld.outputBlobs[0].isContinuous())
+            return false;
+        const Mat& inp = *ld.inputBlobs[0];
+        return inp.type() == CV_32F && inp.isContinuous() && !inp.empty() &&
+               shape(inp) == originalShape(shape(ld.outputBlobs[0]));
+    }
+
+    bool isExit(const LayerData& ld) const
+    {
+        std::vector<int> permutation;
+        if (ld.skip || ld.dtype != CV_32F || !getPermuteOrder(ld, permutation) || permutation.size() != order.size())
+            return false;
+        for (size_t i = 0; i < permutation.size(); ++i)
+        {
+            if (permutation[i] < 0 || permutation[i] >= (int)order.size() || order[permutation[i]] != (int)i)
+                return false;
+        }
+        const Mat& out = ld.outputBlobs[0];
+        return out.type() == CV_32F && out.isContinuous();
+    }
+
+    // Shape of the tensor before permutation
+    MatShape originalShape(const MatShape& permuted) const
+    {
+        MatShape result(permuted.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            result[order[i]] = permuted[i];
+        return result;
+    }
+
+    // Collects the layers reachable from the entry, returns false if the region isn't closed by the exits
+    bool collect(int entryId)
+    {
+        if (!addNode(entryId, true))
+            return false;
+        while (!queue.empty())
+        {
+            LayerData& ld = layers[queue.back()];
+            queue.pop_back();
+            if (std::find(entries.begin(), entries.end(), ld.id) == entries.end())
+            {
+                for (size_t i = 0; i < ld.inputBlobsId.size(); ++i)
+                {
+                    if (!addProducer(ld.inputBlobsId[i].lid))
+                        return false;
+                }
+            }
+            std::vector<LayerData*> chain;
+            getOutputChain(layers, ld, chain);
+            const std::vector<LayerPin>& consumers = chain.back()->consumers;
+            for (size_t i = 0; i < consumers.size(); ++i)
+            {
+                if (!addConsumer(consumers[i].lid))
+                    return false;
+            }
+        }
+        if (inner.empty())
+            return false;
+
+        // each exit writes output of its own layer from the inside of the region
+        std::set<int> producers;
+        for (size_t i = 0; i < exits.size(); ++i)
+        {
+            int producer = nodes[layers[exits[i]].inputBlobsId[0].lid];
+            if (std::find(entries.begin(), entries.end(), producer) != entries.end() ||
+                !producers.insert(producer).second)
+                return false;
+        }
+        return true;
+    }
+
+    // The layers are executed in the same order, but inputs of the entries are read by the layers
+    // inside of the region, and outputs of the exits are written by them. Buffers shared by the memory
+    // manager must not be used by other layers in between. Outputs of exits are reallocated if needed.
+    bool checkMemory()
+    {
+        for (size_t k = 0; k < entries.size(); ++k)
+        {
+            const Mat& inp = *layers[entries[k]].inputBlobs[0];
+            int lastReader = entries[k];
+            for (size_t j = 0; j < inner.size(); ++j)
+            {
+                const LayerData& ld = layers[inner[j]];
+                for (size_t i = 0; i < ld.inputBlobsId.size(); ++i)
+                {
+                    if (nodes[ld.inputBlobsId[i].lid] == entries[k])
+                        lastReader = std::max(lastReader, ld.id);
+                }
+            }
+            Net::Impl::MapIdToLayerData::iterator it = layers.upper_bound(entries[k]);
+            for (; it != layers.end() && it->first <= lastReader; ++it)
+            {
+                const LayerData& ld = it->second;
+                if (ld.skip)
+                    continue;
+                // the last reader may compute element-wise operation in place
+                bool inplace = ld.id == lastReader && ld.layerInstance.dynamicCast<ConcatLayer>().empty();
+                for (size_t i = 0; i < ld.outputBlobs.size() && !inplace; ++i)
+                {
+                    if (sharesData(ld.outputBlobs[i], inp))
+                        return false;
+                }
+                for (size_t i = 0; i < ld.internals.size(); ++i)
+                {
+                    if (sharesData(ld.internals[i], inp))
+                        return false;
+                }
+            }
+        }
+
+        for (size_t k = 0; k < exits.size(); ++k)
+        {
+            const LayerData& exit = layers[exits[k]];
+            const Mat& out = exit.outputBlobs[0];
+            int producer = nodes[exit.inputBlobsId[0].lid];
+            bool shared = false;
+            for (Net::Impl::MapIdToLayerData::iterator it = layers.find(producer); !shared && it->first < exit.id; ++it)
+            {
+                const LayerData& ld = it->second;
+                if (ld.skip)
+                    continue;
+                for (size_t i = 0; i < ld.inputBlobs.size(); ++i)
+                    shared = shared || (ld.inputBlobs[i] && sharesData(*ld.inputBlobs[i], out));
+                for (size_t i = 0; i < ld.outputBlobs.size() && ld.id != producer; ++i)
+                    shared = shared || sharesData(ld.outputBlobs[i], out);
+                for (size_t i = 0; i < ld.internals.size(); ++i)
+                    shared = shared || sharesData(ld.internals[i], out);
+            }
+            for (size_t i = 0; i < entries.size(); ++i)
+                shared = shared || sharesData(*layers[entries[i]].inputBlobs[0], out);
+            for (size_t i = 0; i < exits.size(); ++i)
+                shared = shared || (i != k && sharesData(layers[exits[i]].outputBlobs[0], out));
+            if (!shared)
+                continue;
+
+            // output of the exit may be a part of another buffer (e.g. of optimized out Concat layer)
+            for (size_t i = 0; i < exit.consumers.size(); ++i)
+            {
+                if (layers[exit.consumers[i].lid].skip)
+                    return false;
+            }
+            exitOutputs[exit.id] = Mat(shape(out), CV_32F);
+        }
+        return true;
+    }
+
+    void apply()
+    {
+        for (size_t k = 0; k < entries.size(); ++k)
+        {
+            LayerData& entry = layers[entries[k]];
+            entry.outputBlobs[0] = *entry.inputBlobs[0];
+            entry.skip = true;
+        }
+
+        std::map<int, int> exitOf;
+        for (size_t k = 0; k < exits.size(); ++k)
+            exitOf[nodes[layers[exits[k]].inputBlobsId[0].lid]] = exits[k];
+
+        // Mat objects are replaced in place, so the consumers refer to the new data
+        std::vector<std::vector<LayerData*> > chains(inner.size());
+        for (size_t k = 0; k < inner.size(); ++k)
+            getOutputChain(layers, layers[inner[k]], chains[k]);
+        for (size_t k = 0; k < inner.size(); ++k)
+        {
+            LayerData& ld = layers[inner[k]];
+            Mat out;
+            std::map<int, int>::iterator exitIt = exitOf.find(ld.id);
+            if (exitIt != exitOf.end())
+            {
+                LayerData& exit = layers[exitIt->second];
+                if (exitOutputs.count(exit.id) != 0)
+                    exit.outputBlobs[0] = exitOutputs[exit.id];
+                out = exit.outputBlobs[0];
+                exit.skip = true;
+            }
+            else
+                out = ld.outputBlobs[0].reshape(1, originalShape(shape(ld.outputBlobs[0])));
+            for (size_t i = 0; i < chains[k].size(); ++i)
+                chains[k][i]->outputBlobs[0] = out;
+        }
+
+        for (size_t k = 0; k < inner.size(); ++k)
+        {
+            LayerData& ld = layers[inner[k]];
+            std::vector<MatShape> inpShapes, outShapes, internalShapes;
+            for (size_t i = 0; i < ld.inputBlobs.size(); ++i)
+                inpShapes.push_back(shape(*ld.inputBlobs[i]));
+            Ptr<ConcatLayer> concat = ld.layerInstance.dynamicCast<ConcatLayer>();
+            if (concat)
+            {
+                // the copy of the layer concatenates the same axis of the tensor in the original layout
+                LayerParams params = ld.params;
+                params.set("axis", order[normalize_axis(concat->axis, (int)order.size())]);
+                ld.fusedLayer = ConcatLayer::create(params);
+                ld.fusedLayer->getMemoryShapes(inpShapes, 1, outShapes, internalShapes);
+            }
+            else
+            {
+                // updates the shapes cached by the layer (e.g. number of channels of Eltwise),
+                // they are computed for the permuted tensors again by the next setup of the network
+                ld.layerInstance->getMemoryShapes(inpShapes, 1, outShapes, internalShapes);
+            }
+            CV_Assert(outShapes.size() == 1 && outShapes[0] == shape(ld.outputBlobs[0]));
+        }
+    }
+
+    Net::Impl::MapIdToLayerData& layers;
+    const std::set<LayerPin>& pinsToKeep;
+    std::vector<int> order;
+    std::vector<int> entries, inner, exits;
+    std::map<int, int> nodes;  // entry or inner layer for each layer which refers to its output
+    std::map<int, Mat> exitOutputs;  // reallocated outputs of the exits
+    std::vector<int> queue;
+
+private:
+    bool addNode(int lid, bool entry)
+    {
+        LayerData& ld = layers[lid];
+        if (!entry && (!isLayoutAgnostic(ld) || ld.outputBlobs[0].dims != (int)order.size()))
+            return false;
+        std::vector<LayerData*> chain;
+        getOutputChain(layers, ld, chain);
+        // the fused activations would be lost by the copy of Concat layer
+        if (chain.size() > 1 && !ld.layerInstance.dynamicCast<ConcatLayer>().empty())
+            return false;
+        // permuted data is not visible outside of the region
+        if (chain.back()->consumers.empty())
+            return false;
+        for (size_t i = 0; i < chain.size(); ++i)
+        {
+            if (pinsToKeep.count(LayerPin(chain[i]->id, 0)) != 0)
+                return false;
+            nodes[chain[i]->id] = lid;
+        }
+        (entry ? entries : inner).push_back(lid);
+        queue.push_back(lid);
+        return true;
+    }
+
+    bool addProducer(int lid)
+    {
+        while (nodes.count(lid) == 0 && isFusedActivation(layers, layers[lid]))
+            lid = layers[lid].inputBlobsId[0].lid;
+        if (nodes.count(lid) != 0)
+            return true;
+        return addNode(lid, isEntry(layers[lid]));
+    }
+
+    bool addConsumer(int lid)
+    {
+        if (nodes.count(lid) != 0 || std::find(exits.begin(), exits.end(), lid) != exits.end())
+            return true;
+        if (isExit(layers[lid]))
+        {
+            exits.push_back(lid);
+            return true;
+        }
+        return addNode(lid, false);
+    }
+};
+
+// Models converted from frameworks with NHWC layout surround layout-agnostic layers with
+// Permute layers (NCHW -> NHWC -> ... -> NCHW). The pass finds regions of such layers which
+// are separated from the rest of the network by the permutations: element-wise layers (activations
+// without parameters, Eltwise and NaryEltwise without broadcasting) and Concat layers. Data of the region
+// are kept in the original layout, so the Permute layers are skipped: the layers inside of the region
+// read inputs of the entry permutations and write outputs of the exit ones. Concat layers are
+// computed for the corresponding axis of the original layout.
+//
+// Layout-dependent layers (convolution, pooling, per-channel parameters, etc.) are boundaries of
+// the regions, because their axes and weights would have to be rewritten. For example, in
+// T -> Add -> T' -> Pooling -> T -> Concat -> T' all of the permutations are removed.
+void Net::Impl::removeLayoutRoundTrips(const std::set<LayerPin>& pinsToKeep)
+{
+    CV_TRACE_FUNCTION();
+
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        std::vector<int> order;
+        if (!getPermuteOrder(it->second, order))
+            continue;
+        LayoutRegion region(layers, pinsToKeep, order);
+        if (!region.isEntry(it->second) || !region.collect(it->first) || !region.checkMemory())
+            continue;
+        region.apply();
+        printf_(("\tremoved layout conversions around %s: %d entries, %d layers, %d exits\n", it->second.name.c_str(),
+                 (int)region.entries.size(), (int)region.inner.size(), (int)region.exits.size()));
+    }
+}
+
+
+// Returns operation of the layer which can be computed by FusedElementwiseLayer
+static bool getFusedElementwiseOp(const LayerData& ld, FusedElementwiseLayer::OpType& op)
+{
+    const Ptr<Layer>& layer = ld.layerInstance;
+    if (!layer.dynamicCast<ActivationLayer>().empty())
+    {
+        op = FusedElementwiseLayer::OP_ACTIVATION;
+        return ld.inputBlobsId.size() == 1;
+    }
+    if (ld.inputBlobsId.size() != 2)
+        return false;
+
+    String operation;
+    if (!layer.dynamicCast<NaryEltwiseLayer>().empty())
+    {
+        operation = toLowerCase(ld.params.get<String>("operation", "sum"));
+        if (operation == "mul")
+            operation = "prod";
+        else if (operation == "add")
+            operation = "sum";
+    }
+    else if (!layer.dynamicCast<EltwiseLayer>().empty())
+    {
+        if (ld.params.has("coeff"))
+            return false;
+        operation = toLowerCase(ld.params.get<String>("operation", "sum"));
+        if (operation == "sub")
+            return false;  // not an Eltwise operation
+    }
+    else
+        return false;
+
+    if (operation == "sum")
+        op = FusedElementwiseLayer::OP_ADD;
+    else if (operation == "sub")
+        op = FusedElementwiseLayer::OP_SUB;
+    else if (operation == "prod")
+        op = FusedElementwiseLayer::OP_MUL;
+    else if (operation == "div")
+        op = FusedElementwiseLayer::OP_DIV;
+    else if (operation == "max")
+        op = FusedElementwiseLayer::OP_MAX;
+    else if (operation == "min")
+        op = FusedElementwiseLayer::OP_MIN;
+    else
+        return false;
+    return true;
+}
+
+// Returns the activation which was fused into the layer by fuseLayers(): it's skipped
+// and the layer writes its output.
+static LayerData* getFusedActivation(Net::Impl::MapIdToLayerData& layers, const LayerData& ld)
+{
+    if (ld.consumers.size() != 1)
+        return NULL;
+    LayerData& next = layers[ld.consumers[0].lid];
+    if (!next.skip || next.layerInstance.dynamicCast<ActivationLayer>().empty() ||
+        next.outputBlobs.size() != 1 || next.outputBlobs[0].data != ld.outputBlobs[0].data)
+        return NULL;
+    return &next;
+}
+
+// Merges chains of consecutive element-wise layers (activations, Eltwise and NaryEltwise
+// with operands of the same shape or single values) into a single pass over the data.
+// Intermediate layers are skipped and the last one computes the whole chain.
+void Net::Impl::fuseElementwiseChains(const std::set<LayerPin>& pinsToKeep)
+{
+    CV_TRACE_FUNCTION();
+
+    struct ChainLayer
+    {
+        LayerData* ld;
+        LayerData* activ;  // fused into ld, its output is the output of the layer
+        LayerData& output() const { return activ ? *activ : *ld; }
+    };
+
+    MapIdToLayerData::iterator it = layers.begin();
+    while (it != layers.end())
+    {
+        // collect consecutive layers which can be computed by FusedElementwiseLayer
+        std::vector<ChainLayer> chain;
+        std::set<int> chainIds;
+        for (; it != layers.end(); ++it)
+        {
+            LayerData& ld = it->second;
+            if (!chain.empty() && chain.back().activ == &ld)
+                continue;  // already a part of the chain
+            FusedElementwiseLayer::OpType op;
+            if (ld.id == 0 || ld.skip || ld.dtype != CV_32F || ld.outputBlobs.size() != 1 ||
+                ld.inputBlobs.size() != ld.inputBlobsId.size() || !getFusedElementwiseOp(ld, op))
+                break;
+            const Mat& out = ld.outputBlobs[0];
+            if (out.type() != CV_32F || !out.isContinuous() || out.empty())
+                break;
+            if (!chain.empty() && shape(out) != shape(chain[0].ld->outputBlobs[0]))
+                break;
+
+            ChainLayer layer = { &ld, getFusedActivation(layers, ld) };
+            bool fusable = true, connected = chain.empty();
+            const std::vector<LayerPin>& consumers = layer.output().consumers;
+            for (size_t i = 0; fusable && i < consumers.size(); ++i)
+                fusable = !layers[consumers[i].lid].skip;  // fused into another layer
+            for (size_t i = 0; fusable && i < ld.inputBlobs.size(); ++i)
+            {
+                const Mat& inp = *ld.inputBlobs[i];
+                connected = connected || chainIds.count(ld.inputBlobsId[i].lid) != 0;
+                fusable = inp.type() == CV_32F && inp.isContinuous() &&
+                          (shape(inp) == shape(out) ||
+                           (inp.total() == 1 && op != FusedElementwiseLayer::OP_ACTIVATION &&
+                            !ld.layerInstance.dynamicCast<NaryEltwiseLayer>().empty()));
+            }
+            if (!fusable || !connected)
+                break;
+            chain.push_back(layer);
+            chainIds.insert(layer.output().id);
+        }
+        if (chain.empty())
+        {
+            ++it;
+            continue;
+        }
+
+        // intermediate results must not be used outside of the chain
+        for (;;)
+        {
+            size_t length = chain.size();
+            for (size_t k = 0; k + 1 < chain.size() && length == chain.size(); ++k)
+            {
+                const LayerData& out = chain[k].output();
+                bool escapes = out.consumers.empty() || pinsToKeep.count(LayerPin(out.id, 0)) != 0;
+                for (size_t i = 0; !escapes && i < out.consumers.size(); ++i)
+                    escapes = chainIds.count(out.consumers[i].lid) == 0;
+                if (escapes)
+                    length = k + 1;
+            }
+            if (length == chain.size())
+                break;
+            for (size_t k = length; k < chain.size(); ++k)
+                chainIds.erase(chain[k].output().id);
+            chain.resize(length);
+        }
+        // the rest of layers may start a new chain
+        it = layers.find(chain.back().output().id);
+        ++it;
+        if (chain.size() < 2)
+            continue;
+
+        LayerData& last = *chain.back().ld;
+        LayerParams params;
+        params.name = last.name;
+        params.type = "FusedElementwise";
+        Ptr<FusedElementwiseLayer> fused = makePtr<FusedElementwiseLayer>(params);
+
+        // the first pass collects the inputs of the chain, operations are added by the second one
+        std::map<LayerPin, int> operands;
+        std::map<const Mat*, int> inputs;
+        for (size_t k = 0; k < chain.size(); ++k)
+        {
+            const LayerData& ld = *chain[k].ld;
+            for (size_t i = 0; i < ld.inputBlobsId.size(); ++i)
+            {
+                if (chainIds.count(ld.inputBlobsId[i].lid) != 0 || inputs.count(ld.inputBlobs[i]) != 0)
+                    continue;
+                inputs[ld.inputBlobs[i]] = (int)fused->inputs.size();
+                fused->inputs.push_back(ld.inputBlobs[i]);
+            }
+        }
+        for (size_t k = 0; k < chain.size(); ++k)
+        {
+            LayerData& ld = *chain[k].ld;
+            int src[2] = { -1, -1 };
+            for (size_t i = 0; i < ld.inputBlobsId.size(); ++i)
+            {
+                const LayerPin& pin = ld.inputBlobsId[i];
+                src[i] = chainIds.count(pin.lid) != 0 ? operands[pin] : inputs[ld.inputBlobs[i]];
+            }
+            FusedElementwiseLayer::OpType op = FusedElementwiseLayer::OP_ACTIVATION;
+            CV_Assert(getFusedElementwiseOp(ld, op));
+            int result;
+            if (op == FusedElementwiseLayer::OP_ACTIVATION)
+                result = fused->addActivation(ld.layerInstance.dynamicCast<ActivationLayer>(), src[0]);
+            else
+                result = fused->addBinary(op, src[0], src[1]);
+            if (chain[k].activ)
+                result = fused->addActivation(chain[k].activ->layerInstance.dynamicCast<ActivationLayer>(), result);
+            operands[LayerPin(chain[k].output().id, 0)] = result;
+            if (&ld != &last)
+            {
+                ld.skip = true;
+                printf_(("\tfused element-wise layer %s into %s\n", ld.name.c_str(), last.name.c_str()));
+            }
+        }
+        last.fusedLayer = fused;
+    }
+}
 
 CV__DNN_INLINE_NS_END
 }}  // namespace cv::dnn
@@ -0,0 +1,113 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+#include <sstream>
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+void Net::Impl::enableProfiling(bool enable)
+{
+    profilingEnabled = enable;
+    if (enable)
+    {
+        profile.clear();
+        profilingForwardId = -1;
+        profilingStartTicks = getTickCount();
+    }
+}
+
+static int64 totalBytes(const std::vector<Mat>& blobs)
+{
+    int64 bytes = 0;
+    for (size_t i = 0; i < blobs.size(); ++i)
+        bytes += (int64)(blobs[i].total() * blobs[i].elemSize());
+    return bytes;
+}
+
+void Net::Impl::recordLayerProfile(LayerData& ld, int64 ticks)
+{
+    const double tickToMs = 1e3 / getTickFrequency();
+    const int64 endTicks = getTickCount();
+
+    std::vector<Mat> inputs(ld.inputBlobs.size());
+    std::vector<MatShape> inputShapes(ld.inputBlobs.size()), outputShapes(ld.outputBlobs.size());
+    for (size_t i = 0; i < ld.inputBlobs.size(); ++i)
+    {
+        inputs[i] = *ld.inputBlobs[i];
+        inputShapes[i] = shape(inputs[i]);
+    }
+    for (size_t i = 0; i < ld.outputBlobs.size(); ++i)
+        outputShapes[i] = shape(ld.outputBlobs[i]);
+
+    LayerProfile record;
+    record.forwardId = std::max(profilingForwardId, 0);
+    record.layerId = ld.id;
+    record.name = ld.name;
+    record.type = ld.type;
+    record.timeMs = ticks * tickToMs;
+    record.startMs = (endTicks - ticks - profilingStartTicks) * tickToMs;
+    record.threads = getNumThreads();
+    record.flops = ld.layerInstance->getFLOPS(inputShapes, outputShapes);
+    record.inputBytes = totalBytes(inputs);
+    record.outputBytes = totalBytes(ld.outputBlobs);
+    profile.push_back(record);
+}
+
+static void writeJSONString(std::ostream& out, const std::string& str)
+{
+    out << '"';
+    for (size_t i = 0; i < str.size(); ++i)
+    {
+        const char c = str[i];
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if ((unsigned char)c < 0x20)
+            out << cv::format("\\u%04x", (int)c);
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+String Net::Impl::dumpProfile() const
+{
+    // https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    std::ostringstream out;
+    out.precision(3);
+    out << std::fixed;
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    for (size_t i = 0; i < profile.size(); ++i)
+    {
+        const LayerProfile& r = profile[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "{\"name\": ";
+        writeJSONString(out, r.name);
+        out << ", \"cat\": ";
+        writeJSONString(out, r.type);
+        out << ", \"ph\": \"X\", \"pid\": 0, \"tid\": 0"
+            << ", \"ts\": " << r.startMs * 1e3
+            << ", \"dur\": " << r.timeMs * 1e3
+            << ", \"args\": {\"forward\": " << r.forwardId
+            << ", \"layer_id\": " << r.layerId
+            << ", \"threads\": " << r.threads
+            << ", \"flops\": " << r.flops
+            << ", \"input_bytes\": " << r.inputBytes
+            << ", \"output_bytes\": " << r.outputBytes
+            << ", \"gflops_per_sec\": " << r.gflops()
+            << "}}";
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
@@ -9,6 +9,7 @@
 #include "nms.inl.hpp"
 
 #include <opencv2/imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
 
 namespace cv { namespace dnn {
 CV__DNN_INLINE_NS_BEGIN
@@ -19,13 +20,205 @@ static inline float rectOverlap(const T& a, const T& b)
     return 1.f - static_cast<float>(jaccardDistance(a, b));
 }
 
+namespace {
+
+// Boxes kept by NMS stored as struct of arrays: overlaps of a candidate with all of them
+// are checked by vector instructions.
+template<typename T>
+class KeptBoxes
+{
+public:
+    explicit KeptBoxes(size_t capacity)
+    {
+        x1.reserve(capacity); y1.reserve(capacity);
+        x2.reserve(capacity); y2.reserve(capacity);
+        area.reserve(capacity);
+    }
+
+    template<typename BoxType>
+    static void unpack(const BoxType& box, T& bx1, T& by1, T& bx2, T& by2, T& barea)
+    {
+        bx1 = (T)box.x;
+        by1 = (T)box.y;
+        bx2 = (T)(box.x + box.width);
+        by2 = (T)(box.y + box.height);
+        barea = (T)box.area();
+    }
+
+    void push(T bx1, T by1, T bx2, T by2, T barea)
+    {
+        x1.push_back(bx1); y1.push_back(by1);
+        x2.push_back(bx2); y2.push_back(by2);
+        area.push_back(barea);
+    }
+
+    // Same as jaccardDistance(): boxes with zero total area are equal
+    bool overlaps(T bx1, T by1, T bx2, T by2, T barea, T threshold) const;
+
+private:
+    std::vector<T> x1, y1, x2, y2, area;
+};
+
+template<typename T>
+bool KeptBoxes<T>::overlaps(T bx1, T by1, T bx2, T by2, T barea, T threshold) const
+{
+    const bool emptyOverlaps = threshold < 1;
+    for (size_t k = 0; k < area.size(); ++k)
+    {
+        T w = std::min(bx2, x2[k]) - std::max(bx1, x1[k]);
+        T h = std::min(by2, y2[k]) - std::max(by1, y1[k]);
+        T inter = w > 0 && h > 0 ? w * h : 0;
+        T sum = barea + area[k];
+        if (sum <= 0 ? emptyOverlaps : inter > threshold * (sum - inter))
+            return true;
+    }
+    return false;
+}
+
+#if CV_SIMD
+template<>
+bool KeptBoxes<float>::overlaps(float bx1, float by1, float bx2, float by2, float barea, float threshold) const
+{
+    const int n = (int)area.size();
+    int k = 0;
+    const int nlanes = v_float32::nlanes;
+    const v_float32 vx1 = vx_setall_f32(bx1), vy1 = vx_setall_f32(by1);
+    const v_float32 vx2 = vx_setall_f32(bx2), vy2 = vx_setall_f32(by2);
+    const v_float32 varea = vx_setall_f32(barea), vthr = vx_setall_f32(threshold);
+    const v_float32 zero = vx_setzero_f32();
+    const v_float32 emptyOverlaps = threshold < 1 ? zero == zero : zero;
+    for (; k <= n - nlanes; k += nlanes)
+    {
+        v_float32 w = v_max(v_min(vx2, vx_load(&x2[k])) - v_max(vx1, vx_load(&x1[k])), zero);
+        v_float32 h = v_max(v_min(vy2, vx_load(&y2[k])) - v_max(vy1, vx_load(&y1[k])), zero);
+        v_float32 inter = w * h;
+        v_float32 sum = varea + vx_load(&area[k]);
+        v_float32 mask = v_select(sum <= zero, emptyOverlaps, inter > vthr * (sum - inter));
+        if (v_check_any(mask))
+            return true;
+    }
+    for (; k < n; ++k)
+    {
+        float w = std::min(bx2, x2[k]) - std::max(bx1, x1[k]);
+        float h = std::min(by2, y2[k]) - std::max(by1, y1[k]);
+        float inter = w > 0 && h > 0 ? w * h : 0;
+        float sum = barea + area[k];
+        if (sum <= 0 ? threshold < 1 : inter > threshold * (sum - inter))
+            return true;
+    }
+    return false;
+}
+#endif
+
+// Greedy NMS of upright boxes, the same as NMSFast_() with rectOverlap().
+//    score_index_vec: candidates sorted by score.
+template<typename T, typename BoxType>
+static void NMSRects_(const std::vector<BoxType>& bboxes, const std::vector<std::pair<float, int> >& score_index_vec,
+                      const float nms_threshold, const float eta, std::vector<int>& indices)
+{
+    KeptBoxes<T> kept(score_index_vec.size());
+    float adaptive_threshold = nms_threshold;
+    indices.clear();
+    for (size_t i = 0; i < score_index_vec.size(); ++i)
+    {
+        const int idx = score_index_vec[i].second;
+        T x1, y1, x2, y2, area;
+        KeptBoxes<T>::unpack(bboxes[idx], x1, y1, x2, y2, area);
+        if (kept.overlaps(x1, y1, x2, y2, area, (T)adaptive_threshold))
+            continue;
+        kept.push(x1, y1, x2, y2, area);
+        indices.push_back(idx);
+        if (eta < 1 && adaptive_threshold > 0.5)
+            adaptive_threshold *= eta;
+    }
+}
+
+// Runs NMS for every class in parallel
+template<typename T, typename BoxType>
+class BatchedNMSInvoker : public ParallelLoopBody
+{
+public:
+    BatchedNMSInvoker(const std::vector<BoxType>& bboxes_, const std::vector<std::vector<std::pair<float, int> > >& candidates_,
+                      float nms_threshold_, float eta_, std::vector<std::vector<int> >& indices_)
+        : bboxes(bboxes_), candidates(candidates_), nms_threshold(nms_threshold_), eta(eta_), indices(indices_)
+    {
+        // nothing
+    }
+
+    void operator()(const Range& r) const CV_OVERRIDE
+    {
+        for (int i = r.start; i < r.end; ++i)
+            NMSRects_<T>(bboxes, candidates[i], nms_threshold, eta, indices[i]);
+    }
+
+private:
+    const std::vector<BoxType>& bboxes;
+    const std::vector<std::vector<std::pair<float, int> > >& candidates;
+    float nms_threshold, eta;
+    std::vector<std::vector<int> >& indices;
+};
+
+template<typename T, typename BoxType>
+static void NMSBoxesBatched_(const std::vector<BoxType>& bboxes, const std::vector<float>& scores,
+                             const std::vector<int>& class_ids, const float score_threshold,
+                             const float nms_threshold, std::vector<int>& indices,
+                             const float eta, const int top_k)
+{
+    CV_Assert_N(bboxes.size() == scores.size(), scores.size() == class_ids.size(),
+        score_threshold >= 0, nms_threshold >= 0, eta > 0);
+
+    std::vector<std::pair<float, int> > score_index_vec;
+    GetMaxScoreIndex(scores, score_threshold, top_k, score_index_vec);
+
+    // split candidates by classes keeping the order of scores
+    std::map<int, int> classes;
+    std::vector<std::vector<std::pair<float, int> > > candidates;
+    for (size_t i = 0; i < score_index_vec.size(); ++i)
+    {
+        const int classId = class_ids[score_index_vec[i].second];
+        std::map<int, int>::iterator it = classes.find(classId);
+        if (it == classes.end())
+        {
+            it = classes.insert(std::make_pair(classId, (int)candidates.size())).first;
+            candidates.push_back(std::vector<std::pair<float, int> >());
+        }
+        candidates[it->second].push_back(score_index_vec[i]);
+    }
+
+    std::vector<std::vector<int> > classIndices(candidates.size());
+    parallel_for_(Range(0, (int)candidates.size()),
+                  BatchedNMSInvoker<T, BoxType>(bboxes, candidates, nms_threshold, eta, classIndices));
+
+    // merge results of the classes in order of the candidates: it's stable sorted by scores,
+    // so the boxes with equal scores are in the same order as NMSBoxes() of offset boxes returns
+    std::vector<uchar> isKept(bboxes.size(), 0);
+    size_t numKept = 0;
+    for (size_t i = 0; i < classIndices.size(); ++i)
+    {
+        for (size_t j = 0; j < classIndices[i].size(); ++j)
+            isKept[classIndices[i][j]] = 1;
+        numKept += classIndices[i].size();
+    }
+    indices.clear();
+    indices.reserve(numKept);
+    for (size_t i = 0; i < score_index_vec.size(); ++i)
+    {
+        if (isKept[score_index_vec[i].second])
+            indices.push_back(score_index_vec[i].second);
+    }
+}
+
+}  // namespace
+
 void NMSBoxes(const std::vector<Rect>& bboxes, const std::vector<float>& scores,
                           const float score_threshold, const float nms_threshold,
                           std::vector<int>& indices, const float eta, const int top_k)
 {
     CV_Assert_N(bboxes.size() == scores.size(), score_threshold >= 0,
         nms_threshold >= 0, eta > 0);
-    NMSFast_(bboxes, scores, score_threshold, nms_threshold, eta, top_k, indices, rectOverlap);
+    std::vector<std::pair<float, int> > score_index_vec;
+    GetMaxScoreIndex(scores, score_threshold, top_k, score_index_vec);
+    NMSRects_<float>(bboxes, score_index_vec, nms_threshold, eta, indices);
 }
 
 void NMSBoxes(const std::vector<Rect2d>& bboxes, const std::vector<float>& scores,
@@ -34,11 +227,36 @@ void NMSBoxes(const std::vector<Rect2d>& bboxes, const std::vector<float>& score
 {
     CV_Assert_N(bboxes.size() == scores.size(), score_threshold >= 0,
         nms_threshold >= 0, eta > 0);
-    NMSFast_(bboxes, scores, score_threshold, nms_threshold, eta, top_k, indices, rectOverlap);
+    std::vector<std::pair<float, int> > score_index_vec;
+    GetMaxScoreIndex(scores, score_threshold, top_k, score_index_vec);
+    NMSRects_<double>(bboxes, score_index_vec, nms_threshold, eta, indices);
+}
+
+void NMSBoxesBatched(const std::vector<Rect>& bboxes, const std::vector<float>& scores,
+                     const std::vector<int>& class_ids, const float score_threshold,
+                     const float nms_threshold, std::vector<int>& indices,
+                     const float eta, const int top_k)
+{
+    NMSBoxesBatched_<float>(bboxes, scores, class_ids, score_threshold, nms_threshold, indices, eta, top_k);
+}
+
+void NMSBoxesBatched(const std::vector<Rect2d>& bboxes, const std::vector<float>& scores,
+                     const std::vector<int>& class_ids, const float score_threshold,
+                     const float nms_threshold, std::vector<int>& indices,
+                     const float eta, const int top_k)
+{
+    NMSBoxesBatched_<double>(bboxes, scores, class_ids, score_threshold, nms_threshold, indices, eta, top_k);
 }
 
 static inline float rotatedRectIOU(const RotatedRect& a, const RotatedRect& b)
 {
+    // cheap rejection: the boxes are too far from each other to intersect
+    const Point2f d = a.center - b.center;
+    const float r = 0.5f * (std::sqrt(a.size.width * a.size.width + a.size.height * a.size.height) +
+                            std::sqrt(b.size.width * b.size.width + b.size.height * b.size.height));
+    if (d.dot(d) > r * r)
+        return 0.0f;
+
     std::vector<Point2f> inter;
     int res = rotatedRectangleIntersection(a, b, inter);
     if (inter.empty() || res == INTERSECT_NONE)
@@ -43,6 +43,9 @@
 #endif
 
 #include "onnx_graph_simplifier.hpp"
+#include "../mapped_file.hpp"
+
+#include <google/protobuf/unknown_field_set.h>
 
 namespace cv {
 namespace dnn {
@@ -79,6 +82,8 @@ class ONNXImporter
 
     std::map<std::string, Mat> getGraphTensors(
                                     const opencv_onnx::GraphProto& graph_proto);
+    Mat getMatFromExternalTensor(const opencv_onnx::TensorProto& tensor_proto, const std::string& location,
+                                 size_t offset, size_t length);
     Mat getBlob(const opencv_onnx::NodeProto& node_proto, int index);
     Mat getBlob(const std::string& input_name);
     TensorInfo getBlobExtraInfo(const opencv_onnx::NodeProto& node_proto, int index);
@@ -214,6 +219,9 @@ private:
 
 
     bool useLegacyNames;
+
+    std::string modelDirectory;  // location of external data files, empty for in-memory models
+    std::map<std::string, Ptr<MappedFile> > externalDataFiles;
     bool getParamUseLegacyNames()
     {
         bool param = utils::getConfigurationParameterBool("OPENCV_DNN_ONNX_USE_LEGACY_NAMES", false);
@@ -263,16 +271,22 @@ ONNXImporter::ONNXImporter(Net& net, const char *onnxFile)
     CV_Assert(onnxFile);
     CV_LOG_DEBUG(NULL, "DNN/ONNX: processing ONNX model from file: " << onnxFile);
 
-    std::fstream input(onnxFile, std::ios::in | std::ios::binary);
-    if (!input)
     {
-        CV_Error(Error::StsBadArg, cv::format("Can't read ONNX file: %s", onnxFile));
+        Ptr<MappedFile> file = MappedFile::open(onnxFile);
+        if (!file)
+        {
+            CV_Error(Error::StsBadArg, cv::format("Can't read ONNX file: %s", onnxFile));
+        }
+        if (file->size() > (size_t)INT_MAX ||
+            !model_proto.ParseFromArray(file->data(), (int)file->size()))
+        {
+            CV_Error(Error::StsUnsupportedFormat, cv::format("Failed to parse ONNX model: %s", onnxFile));
+        }
     }
 
-    if (!model_proto.ParseFromIstream(&input))
-    {
-        CV_Error(Error::StsUnsupportedFormat, cv::format("Failed to parse ONNX model: %s", onnxFile));
-    }
+    std::string path(onnxFile);
+    size_t pos = path.find_last_of("/\\");
+    modelDirectory = pos == std::string::npos ? std::string(".") : path.substr(0, pos);
 
     populateNet();
 }
@@ -397,6 +411,118 @@ void runLayer(LayerParams& params, const std::vector<Mat>& inputs,
     layer->forward(inputs, outputs, internals);
 }
 
+static size_t parseExternalDataSize(const opencv_onnx::TensorProto& tensor_proto, const std::string& key, const std::string& value)
+{
+    // std::stoull() accepts leading spaces and a sign, and throws std exceptions
+    size_t result = 0;
+    bool ok = !value.empty();
+    for (size_t i = 0; ok && i < value.size(); i++)
+    {
+        const char c = value[i];
+        ok = c >= '0' && c <= '9' && result <= (std::numeric_limits<size_t>::max() - (c - '0')) / 10;
+        result = result * 10 + (c - '0');
+    }
+    if (!ok)
+        CV_Error(Error::StsUnsupportedFormat, "DNN/ONNX: invalid external data " + key + " '" + value + "' of tensor: " + tensor_proto.name());
+    return result;
+}
+
+// A relative path without '..' components, so it can't refer to a file outside of the model directory
+static bool isExternalDataLocationValid(const std::string& location)
+{
+    if (location.empty() || location[0] == '/' || location[0] == '\\' || location.find(':') != std::string::npos)
+        return false;
+    size_t start = 0;
+    while (start <= location.size())
+    {
+        size_t end = location.find_first_of("/\\", start);
+        if (end == std::string::npos)
+            end = location.size();
+        if (location.compare(start, end - start, "..") == 0)
+            return false;
+        start = end + 1;
+    }
+    return true;
+}
+
+// TensorProto.external_data (13) and TensorProto.data_location (14) are not declared in opencv-onnx.proto,
+// so these fields are preserved by protobuf as unknown ones.
+static bool getExternalDataInfo(const opencv_onnx::TensorProto& tensor_proto, std::string& location,
+                                size_t& offset, size_t& length)
+{
+    using google::protobuf::UnknownField;
+    const google::protobuf::UnknownFieldSet& fields = tensor_proto.unknown_fields();
+    bool isExternal = false;
+    for (int i = 0; i < fields.field_count(); i++)
+    {
+        const UnknownField& field = fields.field(i);
+        if (field.number() == 14 && field.type() == UnknownField::TYPE_VARINT)
+        {
+            isExternal = field.varint() == 1;  // DataLocation::EXTERNAL
+        }
+        else if (field.number() == 13 && field.type() == UnknownField::TYPE_LENGTH_DELIMITED)
+        {
+            opencv_onnx::StringStringEntryProto entry;
+            if (!entry.ParseFromString(field.length_delimited()))
+                CV_Error(Error::StsUnsupportedFormat, "DNN/ONNX: can't parse external data of tensor: " + tensor_proto.name());
+            if (entry.key() == "location")
+                location = entry.value();
+            else if (entry.key() == "offset")
+                offset = parseExternalDataSize(tensor_proto, entry.key(), entry.value());
+            else if (entry.key() == "length")
+                length = parseExternalDataSize(tensor_proto, entry.key(), entry.value());
+        }
+    }
+    if (isExternal && location.empty())
+        CV_Error(Error::StsUnsupportedFormat, "DNN/ONNX: external data location is not specified for tensor: " + tensor_proto.name());
+    return isExternal;
+}
+
+Mat ONNXImporter::getMatFromExternalTensor(const opencv_onnx::TensorProto& tensor_proto, const std::string& location,
+                                           size_t offset, size_t length)
+{
+    if (modelDirectory.empty())
+        CV_Error(Error::StsNotImplemented, "DNN/ONNX: external data requires loading of the model from file: " + tensor_proto.name());
+    if (!isExternalDataLocationValid(location))
+        CV_Error(Error::StsBadArg, "DNN/ONNX: external data location must be relative to the model directory: " + location);
+
+    Ptr<MappedFile>& file = externalDataFiles[location];
+    if (!file)
+    {
+        const std::string path = modelDirectory + "/" + location;
+        CV_LOG_DEBUG(NULL, "DNN/ONNX: loading external data: " << path);
+        file = MappedFile::open(path);
+        if (!file)
+            CV_Error(Error::StsBadArg, "DNN/ONNX: can't open external data file: " + path);
+    }
+    CV_CheckLE(offset, file->size(), "DNN/ONNX: external data offset is out of file");
+    if (length == 0)
+        length = file->size() - offset;
+    CV_CheckLE(length, file->size() - offset, "DNN/ONNX: external data length is out of file");
+
+    // FP32 weights are used as is: refer to the mapped file instead of copying
+    if (tensor_proto.data_type() == opencv_onnx::TensorProto_DataType_FLOAT && tensor_proto.dims_size() > 0 &&
+        file->isMapped() && offset % sizeof(float) == 0)
+    {
+        std::vector<int> sizes(tensor_proto.dims_size());
+        size_t total = 1;
+        for (int i = 0; i < tensor_proto.dims_size(); i++)
+        {
+            sizes[i] = (int)tensor_proto.dims(i);
+            total *= sizes[i];
+        }
+        CV_CheckEQ(total * sizeof(float), length, "DNN/ONNX: external data size mismatch");
+        if (total > 0)
+            return MappedFile::view(file, offset, (int)sizes.size(), sizes.data(), CV_32F);
+    }
+
+    // Other types are converted on load
+    opencv_onnx::TensorProto tensor = tensor_proto;
+    tensor.mutable_unknown_fields()->Clear();
+    tensor.set_raw_data(file->data() + offset, length);
+    return getMatFromTensor(tensor);
+}
+
 std::map<std::string, Mat> ONNXImporter::getGraphTensors(
                                         const opencv_onnx::GraphProto& graph_proto)
 {
@@ -406,7 +532,11 @@ std::map<std::string, Mat> ONNXImporter::getGraphTensors(
     {
         const opencv_onnx::TensorProto& tensor_proto = graph_proto.initializer(i);
         dumpTensorProto(i, tensor_proto, "initializer");
-        Mat mat = getMatFromTensor(tensor_proto);
+        std::string location;
+        size_t offset = 0, length = 0;
+        Mat mat = getExternalDataInfo(tensor_proto, location, offset, length) ?
+                  getMatFromExternalTensor(tensor_proto, location, offset, length) :
+                  getMatFromTensor(tensor_proto);
         releaseONNXTensor(const_cast<opencv_onnx::TensorProto&>(tensor_proto));  // drop already loaded data
 
         if (DNN_DIAGNOSTICS_RUN && mat.empty())
@@ -157,6 +157,49 @@ TEST_P(Test_Int8_layers, Convolution3D)
     testLayer("conv3d_bias", "ONNX", 0.00129, 0.00249);
 }
 
+TEST_P(Test_Int8_layers, Convolution2D_1x1)
+{
+    if (backend == DNN_BACKEND_TIMVX)
+        applyTestTag(CV_TEST_TAG_DNN_SKIP_TIMVX);
+
+    // odd number of input channels and plane size which is not a multiple of SIMD width
+    const int inpCn = 7, outCn = 6;
+    int weightsShape[] = {outCn, inpCn, 1, 1};
+    Mat weights(4, &weightsShape[0], CV_32F), bias(1, outCn, CV_32F);
+    randu(weights, -1, 1);
+    randu(bias, -1, 1);
+
+    LayerParams lp;
+    lp.name = "conv";
+    lp.type = "Convolution";
+    lp.set("kernel_size", 1);
+    lp.set("num_output", outCn);
+    lp.blobs.push_back(weights);
+    lp.blobs.push_back(bias);
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+    net.setPreferableBackend(backend);
+    net.setPreferableTarget(target);
+
+    int inpShape[] = {2, inpCn, 11, 13};
+    Mat inp(4, &inpShape[0], CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    Mat ref = net.forward().clone();
+
+    Net qnet = net.quantize(inp, CV_8S, CV_8S);
+    std::vector<float> inputScale, outputScale;
+    std::vector<int> inputZp, outputZp;
+    qnet.getInputDetails(inputScale, inputZp);
+    qnet.getOutputDetails(outputScale, outputZp);
+
+    Mat inp_int8, out;
+    inp.convertTo(inp_int8, CV_8S, 1.f/inputScale[0], inputZp[0]);
+    qnet.setInput(inp_int8);
+    qnet.forward().convertTo(out, CV_32F, outputScale[0], -(outputScale[0] * outputZp[0]));
+    normAssert(ref, out, "", outputScale[0], 4 * outputScale[0]);
+}
+
 TEST_P(Test_Int8_layers, Flatten)
 {
     testLayer("flatten", "TensorFlow", 0.0036, 0.0069, 1, 1, false, true, true);
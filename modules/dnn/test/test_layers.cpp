@@ -709,6 +709,111 @@ TEST(Layer_LSTM_Test_Accuracy_, Reverse)
     EXPECT_NEAR(std::tanh(2e-5f), data[1], 1e-10);
 }
 
+// Batch of samples is multiplied by the packed weights, a single sample uses the original ones
+typedef testing::TestWithParam<std::string> Layer_Recurrent_Test_batch;
+TEST_P(Layer_Recurrent_Test_batch, Accuracy)
+{
+    const bool isLSTM = GetParam() == "LSTM";
+    const int numTimeStamps = 3, numSamples = 6, numInp = 13, numOut = 10;
+    const int numGates = isLSTM ? 4 : 3;
+    Mat Wh(numGates * numOut, numOut, CV_32F), Wx(numGates * numOut, numInp, CV_32F);
+    Mat b(1, (isLSTM ? 1 : 2) * numGates * numOut, CV_32F);
+    randu(Wh, -1, 1);
+    randu(Wx, -1, 1);
+    randu(b, -1, 1);
+    int inpShape[] = {numTimeStamps, numSamples, numInp};
+    Mat inp(3, inpShape, CV_32F);
+    randu(inp, -1, 1);
+
+    std::vector<Mat> outputs;
+    for (int n = 0; n <= numSamples; n++)
+    {
+        // the first run processes the whole batch, then the samples one by one
+        const Range samples = n == 0 ? Range::all() : Range(n - 1, n);
+        const int batchSize = n == 0 ? numSamples : 1;
+
+        LayerParams lp;
+        lp.blobs.push_back(Wh);
+        lp.blobs.push_back(Wx);
+        lp.blobs.push_back(b);
+        lp.blobs.push_back(Mat::zeros(batchSize, numOut, CV_32F));
+        Ptr<Layer> layer;
+        if (isLSTM)
+        {
+            lp.blobs.push_back(Mat::zeros(batchSize, numOut, CV_32F));
+            lp.set("use_timestamp_dim", true);
+            layer = LSTMLayer::create(lp);
+        }
+        else
+            layer = GRULayer::create(lp);
+
+        const Range ranges[] = {Range::all(), samples, Range::all()};
+        std::vector<Mat> inputs(1, inp(ranges).clone()), outs;
+        runLayer(layer, inputs, outs);
+        if (n == 0)
+            outputs = outs;
+        else
+            normAssert(outputs[0](ranges), outs[0], cv::format("sample %d", n - 1).c_str());
+    }
+}
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Recurrent_Test_batch, Values("LSTM", "GRU"));
+
+TEST(Layer_InnerProduct_Test, batch)
+{
+    const int numSamples = 21, numInp = 67, numOut = 45;
+    LayerParams lp;
+    lp.set("num_output", numOut);
+    lp.blobs.push_back(Mat(numOut, numInp, CV_32F));
+    lp.blobs.push_back(Mat(1, numOut, CV_32F));
+    randu(lp.blobs[0], -1, 1);
+    randu(lp.blobs[1], -1, 1);
+    Ptr<Layer> layer = InnerProductLayer::create(lp);
+
+    std::vector<Mat> inputs(1, Mat(numSamples, numInp, CV_32F)), outputs;
+    randu(inputs[0], -1, 1);
+    Mat ref;
+    gemm(inputs[0], lp.blobs[0], 1, repeat(lp.blobs[1], numSamples, 1), 1, ref, GEMM_2_T);
+    runLayer(layer, inputs, outputs);
+    normAssert(ref, outputs[0]);
+}
+
+// Packed weights are shared by clones of the network and updated if the weights are replaced
+TEST(Layer_InnerProduct_Test, packedWeights)
+{
+    const int numInp = 67, numOut = 45;
+    LayerParams lp;
+    lp.name = "fc";
+    lp.type = "InnerProduct";
+    lp.set("num_output", numOut);
+    lp.blobs.push_back(Mat(numOut, numInp, CV_32F));
+    lp.blobs.push_back(Mat(1, numOut, CV_32F));
+    randu(lp.blobs[0], -1, 1);
+    randu(lp.blobs[1], -1, 1);
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+    Net clone = net.clone();
+
+    Mat newWeights(numOut, numInp, CV_32F);
+    randu(newWeights, -1, 1);
+    clone.setParam("fc", 0, newWeights);
+
+    // batch size is changed between the runs
+    const int batchSizes[] = {21, 5, 1, 8};
+    for (int i = 0; i < 4; ++i)
+    {
+        Mat inp(batchSizes[i], numInp, CV_32F), ref, newRef;
+        randu(inp, -1, 1);
+        Mat biases = repeat(lp.blobs[1], inp.rows, 1);
+        gemm(inp, lp.blobs[0], 1, biases, 1, ref, GEMM_2_T);
+        gemm(inp, newWeights, 1, biases, 1, newRef, GEMM_2_T);
+
+        net.setInput(inp);
+        normAssert(ref, net.forward(), cv::format("batch=%d", inp.rows).c_str());
+        clone.setInput(inp);
+        normAssert(newRef, clone.forward(), cv::format("clone, batch=%d", inp.rows).c_str());
+    }
+}
+
 
 class Layer_RNN_Test : public ::testing::Test
 {
@@ -9,6 +9,7 @@
 #include <opencv2/core/ocl.hpp>
 #include <opencv2/core/opencl/ocl_defs.hpp>
 #include <opencv2/dnn/layer.details.hpp>  // CV_DNN_REGISTER_LAYER_CLASS
+#include <thread>
 
 namespace opencv_test { namespace {
 
@@ -39,6 +40,100 @@ TEST(blobFromImage, allocated)
     ASSERT_EQ(blobData, blob.data);
 }
 
+typedef testing::TestWithParam<tuple<int, int> > blobFromImages_fused;
+TEST_P(blobFromImages_fused, Accuracy)
+{
+    const int depth = get<0>(GetParam()), cn = get<1>(GetParam());
+    const Scalar mean(10, 20, 30, 40);
+    const double scale = 0.5;
+
+    // width is not a multiple of any vector size to check the tails
+    std::vector<Mat> imgs(3);
+    for (size_t i = 0; i < imgs.size(); i++)
+    {
+        imgs[i].create(45, 67, CV_MAKETYPE(depth, cn));
+        randu(imgs[i], 0, 255);
+    }
+
+    for (int crop = 0; crop < 2; crop++)
+    {
+        for (int swapRB = 0; swapRB < 2; swapRB++)
+        {
+            const Size size(37, 29);
+            Mat blob = blobFromImages(imgs, scale, size, mean, swapRB != 0, crop != 0);
+            const int sz[] = {(int)imgs.size(), cn, size.height, size.width};
+            ASSERT_EQ(MatShape(sz, sz + 4), MatShape(blob.size.p, blob.size.p + blob.dims));
+
+            Scalar m = mean;
+            if (swapRB)
+                std::swap(m[0], m[2]);  // 1-channel images are affected too
+            for (size_t i = 0; i < imgs.size(); i++)
+            {
+                Mat img;
+                if (crop)
+                {
+                    const float factor = std::max(size.width / (float)imgs[i].cols, size.height / (float)imgs[i].rows);
+                    resize(imgs[i], img, Size(), factor, factor, INTER_LINEAR);
+                    img = img(Rect(Point(0.5 * (img.cols - size.width), 0.5 * (img.rows - size.height)), size));
+                }
+                else
+                    resize(imgs[i], img, size, 0, 0, INTER_LINEAR);
+                img.convertTo(img, CV_32F);
+                img -= m;
+                img *= scale;
+                std::vector<Mat> ch;
+                split(img, ch);
+                for (int c = 0; c < cn; c++)
+                {
+                    const int srcCh = swapRB && cn >= 3 && c != 1 && c != 3 ? 2 - c : c;
+                    Mat plane(size, CV_32F, blob.ptr<float>((int)i, c));
+                    EXPECT_LE(cvtest::norm(ch[srcCh], plane, NORM_INF), 1e-4)
+                        << "crop=" << crop << " swapRB=" << swapRB << " i=" << i << " c=" << c;
+                }
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, blobFromImages_fused, Combine(
+    Values(CV_8U, CV_32F, CV_16U),
+    Values(1, 3, 4)
+));
+
+TEST(blobFromImages, ddepth_CV_8U)
+{
+    for (int cn = 1; cn <= 4; cn++)
+    {
+        if (cn == 2)
+            continue;
+        std::vector<Mat> imgs(2);
+        for (size_t i = 0; i < imgs.size(); i++)
+        {
+            imgs[i].create(19, 67, CV_8UC(cn));
+            randu(imgs[i], 0, 256);
+        }
+        for (int swapRB = 0; swapRB < 2; swapRB++)
+        {
+            Mat blob = blobFromImages(imgs, 1.0, Size(), Scalar(), swapRB != 0, false, CV_8U);
+            ASSERT_EQ(CV_8U, blob.depth());
+            const int sz[] = {(int)imgs.size(), cn, imgs[0].rows, imgs[0].cols};
+            ASSERT_EQ(MatShape(sz, sz + 4), MatShape(blob.size.p, blob.size.p + blob.dims));
+            for (size_t i = 0; i < imgs.size(); i++)
+            {
+                std::vector<Mat> ch;
+                split(imgs[i], ch);
+                for (int c = 0; c < cn; c++)
+                {
+                    const int srcCh = swapRB && cn >= 3 && c != 1 && c != 3 ? 2 - c : c;
+                    Mat plane(imgs[i].size(), CV_8U, blob.ptr<uchar>((int)i, c));
+                    EXPECT_EQ(0, cvtest::norm(ch[srcCh], plane, NORM_INF))
+                        << "cn=" << cn << " swapRB=" << swapRB << " i=" << i << " c=" << c;
+                }
+            }
+        }
+    }
+}
+
 TEST(imagesFromBlob, Regression)
 {
     int nbOfImages = 8;
@@ -436,6 +531,832 @@ TEST(Net, forwardAndRetrieve)
     normAssert(outBlobs[0][1], inp.rowRange(2, 4), "second part");
 }
 
+TEST(Net, memoryPlanner)
+{
+    std::string prototxt =
+        "input: \"data\"\n"
+        "layer { name: \"pool1\" type: \"Pooling\" bottom: \"data\" top: \"pool1\"\n"
+        "  pooling_param { pool: MAX kernel_size: 3 stride: 1 pad: 1 } }\n"
+        "layer { name: \"relu1\" type: \"ReLU\" bottom: \"pool1\" top: \"pool1\" }\n"
+        "layer { name: \"scale\" type: \"Power\" bottom: \"pool1\" top: \"scale\" power_param { scale: 2 } }\n"
+        "layer { name: \"shift\" type: \"Power\" bottom: \"pool1\" top: \"shift\" power_param { shift: 1 } }\n"
+        "layer { name: \"sum\" type: \"Eltwise\" bottom: \"scale\" bottom: \"shift\" top: \"sum\" }\n"
+        "layer { name: \"concat\" type: \"Concat\" bottom: \"sum\" bottom: \"pool1\" top: \"concat\" }\n"
+        "layer { name: \"pool2\" type: \"Pooling\" bottom: \"concat\" top: \"pool2\"\n"
+        "  pooling_param { pool: AVE kernel_size: 3 stride: 1 pad: 1 } }\n";
+
+    int inpSize[] = {1, 4, 16, 16};
+    MatShape inpShape(inpSize, inpSize + 4);
+    Mat inp(inpShape, CV_32F);
+    randu(inp, -1, 1);
+
+    Net net = readNetFromCaffe(&prototxt[0], prototxt.size());
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setInput(inp);
+    Mat ref = net.forward().clone();
+    size_t weights = 0, refBlobs = 0;
+    net.getMemoryConsumption(inpShape, weights, refBlobs);
+
+    Net plannedNet = readNetFromCaffe(&prototxt[0], prototxt.size());
+    plannedNet.setPreferableBackend(DNN_BACKEND_OPENCV);
+    plannedNet.enableMemoryPlanner(true);
+    plannedNet.setInput(inp);
+    normAssert(plannedNet.forward(), ref, "first run");
+    normAssert(plannedNet.forward(), ref, "second run");
+
+    size_t plannedBlobs = 0;
+    plannedNet.getMemoryConsumption(inpShape, weights, plannedBlobs);
+    EXPECT_GT(plannedBlobs, (size_t)0);
+    EXPECT_LE(plannedBlobs, refBlobs);
+
+    // Reallocation for a new input shape
+    inpSize[2] = inpSize[3] = 24;
+    Mat inp2(4, &inpSize[0], CV_32F);
+    randu(inp2, -1, 1);
+    net.setInput(inp2);
+    plannedNet.setInput(inp2);
+    normAssert(plannedNet.forward(), net.forward(), "new shape");
+}
+
+TEST(Net, memoryPlanner_squeezenet)
+{
+    const std::string proto = findDataFile("dnn/squeezenet_v1.1.prototxt", false);
+    const std::string model = findDataFile("dnn/squeezenet_v1.1.caffemodel", false);
+    int inpSize[] = {2, 3, 227, 227};
+    Mat inp(4, &inpSize[0], CV_32F);
+    randu(inp, 0, 255);
+
+    // outputs of the network and an intermediate blob requested by user
+    const std::vector<String> outNames = {"fire5/concat", "prob"};
+    std::vector<Mat> refs, outs;
+    Net net = readNetFromCaffe(proto, model);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setInput(inp);
+    net.forward(refs, outNames);
+
+    Net plannedNet = readNetFromCaffe(proto, model);
+    plannedNet.setPreferableBackend(DNN_BACKEND_OPENCV);
+    plannedNet.enableMemoryPlanner(true);
+    for (int iter = 0; iter < 2; ++iter)
+    {
+        plannedNet.setInput(inp);
+        plannedNet.forward(outs, outNames);
+        ASSERT_EQ(refs.size(), outs.size());
+        for (size_t i = 0; i < outs.size(); ++i)
+            normAssert(refs[i], outs[i], cv::format("%s, iter=%d", outNames[i].c_str(), iter).c_str());
+    }
+    size_t weights = 0, blobs = 0, plannedBlobs = 0;
+    MatShape inpShape(inp.size.p, inp.size.p + inp.dims);
+    net.getMemoryConsumption(inpShape, weights, blobs);
+    plannedNet.getMemoryConsumption(inpShape, weights, plannedBlobs);
+    EXPECT_LT(plannedBlobs, blobs);
+}
+
+TEST(BatchingExecutor, forward)
+{
+    std::string prototxt =
+        "input: \"data\"\n"
+        "layer { name: \"pool\" type: \"Pooling\" bottom: \"data\" top: \"pool\"\n"
+        "  pooling_param { pool: MAX kernel_size: 2 stride: 2 } }\n"
+        "layer { name: \"scale\" type: \"Power\" bottom: \"pool\" top: \"scale\" power_param { scale: 2 shift: 1 } }\n";
+
+    Net refNet = readNetFromCaffe(&prototxt[0], prototxt.size());
+    refNet.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    Net net = readNetFromCaffe(&prototxt[0], prototxt.size());
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    BatchingExecutor executor(net, 4, 100000);
+
+    const int numRequests = 6;
+    std::vector<Mat> inputs;
+    std::vector<AsyncArray> results;
+    for (int i = 0; i < numRequests; ++i)
+    {
+        int inpSize[] = {1, 3, 8, 8 + 2 * (i % 2)};  // two groups of compatible requests
+        Mat inp(4, &inpSize[0], CV_32F);
+        randu(inp, -1, 1);
+        inputs.push_back(inp);
+        results.push_back(executor.forwardAsync(inp));
+    }
+
+    for (int i = 0; i < numRequests; ++i)
+    {
+        Mat out;
+        results[i].get(out);
+        refNet.setInput(inputs[i]);
+        normAssert(out, refNet.forward(), cv::format("request %d", i).c_str());
+    }
+
+    refNet.setInput(inputs[0]);
+    normAssert(executor.forward(inputs[0], "pool"), refNet.forward("pool"), "sync");
+
+    int badSize[] = {2, 3, 8, 8};
+    Mat badInp(4, &badSize[0], CV_32F, Scalar(0));
+    EXPECT_THROW(executor.forwardAsync(badInp), cv::Exception);
+}
+
+static Net createConvReluNet(const Mat& weights)
+{
+    Net net;
+    LayerParams lp;
+    lp.name = "conv";
+    lp.type = "Convolution";
+    lp.set("kernel_size", 3);
+    lp.set("num_output", weights.size[0]);
+    lp.set("pad", 1);
+    lp.set("bias_term", false);
+    lp.blobs.push_back(weights);
+    net.addLayerToPrev(lp.name, lp.type, lp);
+
+    LayerParams relu;
+    relu.name = "relu";
+    relu.type = "ReLU";
+    net.addLayerToPrev(relu.name, relu.type, relu);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    return net;
+}
+
+TEST(Net, forwardAsync_OpenCV)
+{
+    int weightsShape[] = {4, 3, 3, 3};
+    Mat weights(4, &weightsShape[0], CV_32F);
+    randu(weights, -1, 1);
+    Net net = createConvReluNet(weights);
+
+    const int numInputs = 5;
+    std::vector<Mat> inputs, refs;
+    for (int i = 0; i < numInputs; ++i)
+    {
+        int inpShape[] = {1, 3, 10, 10 + i};
+        Mat inp(4, &inpShape[0], CV_32F);
+        randu(inp, -1, 1);
+        inputs.push_back(inp);
+        net.setInput(inp);
+        refs.push_back(net.forward().clone());
+    }
+
+    std::vector<AsyncArray> outs(numInputs);
+    for (int i = 0; i < numInputs; ++i)
+    {
+        net.setInput(inputs[i]);
+        outs[i] = net.forwardAsync();
+    }
+    for (int i = 0; i < numInputs; ++i)
+    {
+        Mat out;
+        outs[i].get(out);
+        normAssert(out, refs[i], cv::format("request %d", i).c_str());
+    }
+
+    // Execution contexts are recreated after changes of the weights
+    Mat newWeights = weights * 2;
+    net.setParam("conv", 0, newWeights);
+    Net refNet = createConvReluNet(newWeights);
+    refNet.setInput(inputs[0]);
+    net.setInput(inputs[0]);
+    Mat out;
+    net.forwardAsync().get(out);
+    normAssert(out, refNet.forward(), "new weights");
+}
+
+TEST(Net, clone)
+{
+    int weightsShape[] = {4, 3, 3, 3};
+    Mat weights(4, &weightsShape[0], CV_32F);
+    randu(weights, -1, 1);
+    Net net = createConvReluNet(weights);
+
+    int inpShape[] = {1, 3, 10, 12};
+    Mat inp(4, &inpShape[0], CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    Mat ref = net.forward().clone();
+
+    Net clone = net.clone();
+    ASSERT_FALSE(clone.empty());
+    EXPECT_EQ(net.getLayerNames(), clone.getLayerNames());
+    EXPECT_EQ(net.getParam("conv").data, clone.getParam("conv").data);
+
+    clone.setInput(inp);
+    normAssert(clone.forward(), ref, "clone");
+
+    // Both networks produce outputs when used together
+    net.setInput(inp);
+    Mat out = net.forward();
+    normAssert(out, ref, "origin");
+
+    // Constant blobs are still shared after both networks are initialized
+    EXPECT_EQ(net.getParam("conv").data, clone.getParam("conv").data);
+    EXPECT_EQ(net.getLayer("conv")->blobs[0].data, clone.getLayer("conv")->blobs[0].data);
+
+    // The clone gets its own blob on modification
+    clone.setParam("conv", 0, weights * 2);
+    EXPECT_NE(net.getParam("conv").data, clone.getParam("conv").data);
+    net.setInput(inp);
+    normAssert(net.forward(), ref, "origin after setParam of clone");
+}
+
+TEST(Net, profiling)
+{
+    int weightsShape[] = {4, 3, 3, 3};
+    Mat weights(4, &weightsShape[0], CV_32F);
+    randu(weights, -1, 1);
+    Net net = createConvReluNet(weights);
+
+    int inpShape[] = {1, 3, 10, 12};
+    Mat inp(4, &inpShape[0], CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    net.forward();
+    EXPECT_TRUE(net.getProfile().empty());  // disabled by default
+
+    net.enableProfiling();
+    for (int i = 0; i < 2; ++i)
+    {
+        net.setInput(inp);
+        net.forward();
+    }
+    net.enableProfiling(false);
+    net.setInput(inp);
+    net.forward();
+
+    std::vector<LayerProfile> profile = net.getProfile();
+    ASSERT_FALSE(profile.empty());
+    EXPECT_EQ(0, profile.front().forwardId);
+    EXPECT_EQ(1, profile.back().forwardId);
+    int numConv = 0;
+    for (size_t i = 0; i < profile.size(); ++i)
+    {
+        const LayerProfile& r = profile[i];
+        EXPECT_GE(r.timeMs, 0);
+        EXPECT_GE(r.startMs, 0);
+        EXPECT_GE(r.threads, 1);
+        if (r.name != "conv")
+            continue;
+        numConv++;
+        EXPECT_EQ("Convolution", r.type);
+        EXPECT_EQ(net.getLayerId("conv"), r.layerId);
+        EXPECT_EQ(net.getFLOPS(net.getLayerId("conv"), MatShape(inpShape, inpShape + 4)), r.flops);
+        EXPECT_EQ((int64)(inp.total() * sizeof(float)), r.inputBytes);
+        EXPECT_EQ((int64)(4 * 10 * 12 * sizeof(float)), r.outputBytes);
+    }
+    EXPECT_EQ(2, numConv);
+
+    std::string trace = net.dumpProfile();
+    EXPECT_NE(std::string::npos, trace.find("\"traceEvents\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\": \"conv\", \"cat\": \"Convolution\""));
+
+    EXPECT_THROW(net.dumpProfileToFile("/nonexistent_dir/profile.json"), cv::Exception);
+}
+
+TEST(Net, CPU_FP16)
+{
+    int weightsShape[] = {6, 5, 3, 3};
+    Mat weights(4, &weightsShape[0], CV_32F);
+    randu(weights, -1, 1);
+    Net net = createConvReluNet(weights);
+
+    // 6*7*7 inputs of fully connected layer aren't aligned to the vector size
+    Mat fcWeights(13, 6 * 7 * 7, CV_32F), fcBias(1, 13, CV_32F);
+    randu(fcWeights, -0.1, 0.1);
+    randu(fcBias, -1, 1);
+    LayerParams fc;
+    fc.name = "fc";
+    fc.type = "InnerProduct";
+    fc.set("num_output", 13);
+    fc.blobs.push_back(fcWeights);
+    fc.blobs.push_back(fcBias);
+    net.addLayerToPrev(fc.name, fc.type, fc);
+
+    int inpShape[] = {2, 5, 7, 7};
+    Mat inp(4, &inpShape[0], CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    Mat ref = net.forward().clone();
+
+    net.setPreferableTarget(DNN_TARGET_CPU_FP16);
+    net.setInput(inp);
+    Mat out = net.forward().clone();
+    normAssert(out, ref, "FP16", 4e-3, 2e-2);
+    EXPECT_GT(cvtest::norm(out, ref, NORM_INF), 0);  // weights are really rounded
+
+    // FP32 parameters are not replaced
+    EXPECT_EQ(CV_32F, net.getParam("conv", 0).depth());
+    EXPECT_EQ(CV_32F, net.getParam("fc", 0).depth());
+    EXPECT_EQ(fcWeights.data, net.getParam("fc", 0).data);
+
+    // Clones share FP32 parameters and produce the same results
+    Net clone = net.clone();
+    clone.setInput(inp);
+    normAssert(clone.forward(), out, "FP16 clone", 0, 0);
+    EXPECT_EQ(net.getParam("conv", 0).data, clone.getParam("conv", 0).data);
+    EXPECT_EQ(net.getParam("fc", 0).data, clone.getParam("fc", 0).data);
+
+    net.setPreferableTarget(DNN_TARGET_CPU);
+    net.setInput(inp);
+    normAssert(net.forward(), ref, "FP32 after FP16", 0, 0);
+}
+
+TEST(Net, CPU_FP16_quantized)
+{
+    // Quantized networks are computed on DNN_TARGET_CPU_FP16 as on DNN_TARGET_CPU,
+    // including layers which are limited by CPU (3D pooling)
+    Net net;
+    LayerParams lp;
+    lp.name = "pool";
+    lp.type = "Pooling";
+    lp.set("pool", "max");
+    int kernel[] = {2, 2, 2};
+    lp.set("kernel_size", DictValue::arrayInt(&kernel[0], 3));
+    lp.set("stride", DictValue::arrayInt(&kernel[0], 3));
+    net.addLayerToPrev(lp.name, lp.type, lp);
+
+    Mat fcWeights(5, 3 * 2 * 3 * 3, CV_32F), fcBias(1, 5, CV_32F);
+    randu(fcWeights, -0.1, 0.1);
+    randu(fcBias, -1, 1);
+    lp = LayerParams();
+    lp.name = "fc";
+    lp.type = "InnerProduct";
+    lp.set("num_output", 5);
+    lp.blobs.push_back(fcWeights);
+    lp.blobs.push_back(fcBias);
+    net.addLayerToPrev(lp.name, lp.type, lp);
+
+    int inpShape[] = {2, 3, 4, 6, 6};
+    Mat inp(5, &inpShape[0], CV_32F);
+    randu(inp, -1, 1);
+    Net qnet = net.quantize(inp, CV_32F, CV_32F);
+
+    qnet.setInput(inp);
+    Mat ref = qnet.forward().clone();
+
+    qnet.setPreferableTarget(DNN_TARGET_CPU_FP16);
+    qnet.setInput(inp);
+    normAssert(qnet.forward(), ref, "CPU_FP16", 0, 0);
+}
+
+static Net createConvBatchNormReluNet(const Mat& weights, const Mat& mean, const Mat& var)
+{
+    Net net;
+    LayerParams lp;
+    lp.set("kernel_size", 3);
+    lp.set("num_output", weights.size[0]);
+    lp.set("pad", 1);
+    lp.set("bias_term", false);
+    lp.blobs.push_back(weights.clone());
+    net.addLayerToPrev("conv", "Convolution", lp);
+
+    lp = LayerParams();
+    lp.blobs.push_back(mean.clone());
+    lp.blobs.push_back(var.clone());
+    net.addLayerToPrev("bn", "BatchNorm", lp);
+
+    lp = LayerParams();
+    net.addLayerToPrev("relu", "ReLU", lp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    return net;
+}
+
+// Identity layer which counts shape inference calls
+class ShapeCountingLayer CV_FINAL : public Layer
+{
+public:
+    ShapeCountingLayer(const LayerParams &params) : Layer(params) {}
+
+    static Ptr<Layer> create(LayerParams& params)
+    {
+        return Ptr<Layer>(new ShapeCountingLayer(params));
+    }
+
+    virtual bool getMemoryShapes(const std::vector<MatShape> &inputs, const int,
+                                 std::vector<MatShape> &outputs, std::vector<MatShape> &) const CV_OVERRIDE
+    {
+        calls++;
+        outputs = inputs;
+        return false;
+    }
+
+    virtual void forward(InputArrayOfArrays inputs, OutputArrayOfArrays outputs, OutputArrayOfArrays) CV_OVERRIDE
+    {
+        std::vector<Mat> inps, outs;
+        inputs.getMatVector(inps);
+        outputs.getMatVector(outs);
+        inps[0].copyTo(outs[0]);
+    }
+
+    static int calls;
+};
+int ShapeCountingLayer::calls = 0;
+
+TEST(Net, shapePlanCache)
+{
+    int weightsShape[] = {4, 3, 3, 3};
+    Mat weights(4, &weightsShape[0], CV_32F), mean(1, 4, CV_32F), var(1, 4, CV_32F);
+    randu(weights, -1, 1);
+    randu(mean, -1, 1);
+    randu(var, 0.5, 2);
+    Net net = createConvBatchNormReluNet(weights, mean, var);
+    CV_DNN_REGISTER_LAYER_CLASS(ShapeCounting, ShapeCountingLayer);
+    LayerParams lp;
+    net.addLayerToPrev("counter", "ShapeCounting", lp);
+    net.setShapePlanCacheSize(2);
+
+    int shapes[][4] = { {1, 3, 10, 12}, {1, 3, 16, 8}, {2, 3, 5, 5} };
+    // the third plan is restored, the first one is evicted by the last shape
+    int order[] = {0, 1, 0, 2, 1};
+    bool restored[] = {false, false, true, false, false};
+    for (int i = 0; i < 5; ++i)
+    {
+        Mat inp(4, shapes[order[i]], CV_32F);
+        randu(inp, -1, 1);
+        net.setInput(inp);
+        const int calls = ShapeCountingLayer::calls;
+        Mat out = net.forward();
+        // shapes of the restored plan aren't inferred again
+        EXPECT_EQ(restored[i], ShapeCountingLayer::calls == calls) << "step " << i;
+
+        Net refNet = createConvBatchNormReluNet(weights, mean, var);
+        refNet.setInput(inp);
+        normAssert(out, refNet.forward(), cv::format("step %d", i).c_str());
+    }
+    LayerFactory::unregisterLayer("ShapeCounting");
+}
+
+TEST(Net, threadBudget)
+{
+    int weightsShape[] = {8, 3, 3, 3};
+    Mat weights(4, &weightsShape[0], CV_32F), mean(1, 8, CV_32F), var(1, 8, CV_32F);
+    randu(weights, -1, 1);
+    randu(mean, -1, 1);
+    randu(var, 0.5, 2);
+    int inpShape[] = {1, 3, 32, 40};
+    Mat inp(4, &inpShape[0], CV_32F);
+    randu(inp, -1, 1);
+
+    Net refNet = createConvBatchNormReluNet(weights, mean, var);
+    refNet.setInput(inp);
+    Mat ref = refNet.forward().clone();
+
+    // concurrent networks run on their own threads
+    const int numNets = 3;
+    std::vector<Mat> outs(numNets);
+    std::vector<std::thread> runners;
+    for (int i = 0; i < numNets; ++i)
+    {
+        runners.push_back(std::thread([&, i]() {
+            Net net = createConvBatchNormReluNet(weights, mean, var);
+            net.setThreadBudget(2);
+            for (int iter = 0; iter < 5; ++iter)
+            {
+                net.setInput(inp);
+                outs[i] = net.forward().clone();
+            }
+        }));
+    }
+    for (size_t i = 0; i < runners.size(); ++i)
+        runners[i].join();
+    for (int i = 0; i < numNets; ++i)
+        normAssert(outs[i], ref, cv::format("net %d", i).c_str());
+
+    // clones of the network run concurrently on the threads of its budget
+    {
+        Net net = createConvBatchNormReluNet(weights, mean, var);
+        net.setThreadBudget(2);
+        runners.clear();
+        for (int i = 0; i < numNets; ++i)
+        {
+            Net clone = net.clone();
+            runners.push_back(std::thread([&, i, clone]() mutable {
+                for (int iter = 0; iter < 5; ++iter)
+                {
+                    clone.setInput(inp);
+                    outs[i] = clone.forward().clone();
+                }
+            }));
+        }
+        for (size_t i = 0; i < runners.size(); ++i)
+            runners[i].join();
+        for (int i = 0; i < numNets; ++i)
+            normAssert(outs[i], ref, cv::format("clone %d", i).c_str());
+    }
+
+    Net net = createConvBatchNormReluNet(weights, mean, var);
+    net.setThreadBudget(1);
+    net.setInput(inp);
+    normAssert(net.forward(), ref, "single thread");
+    net.setThreadBudget(0);
+    net.setInput(inp);
+    normAssert(net.forward(), ref, "global pool");
+    EXPECT_THROW(net.setThreadBudget(-1), cv::Exception);
+}
+
+TEST(Net, fuseElementwiseChains)
+{
+    // out = min(max(x * sigmoid(x) + y, 0), 6) * 0.5
+    Net net;
+    net.setInputsNames({"x", "y"});
+
+    LayerParams lp;
+    lp.blobs.push_back(Mat(std::vector<int>(4, 1), CV_32F, Scalar(0.5)));
+    int scaleId = net.addLayer("scale", "Const", lp);
+
+    lp = LayerParams();
+    int sigmoidId = net.addLayer("sigmoid", "Sigmoid", lp);
+    net.connect(0, 0, sigmoidId, 0);
+
+    lp.set("operation", "mul");
+    int siluId = net.addLayer("silu", "NaryEltwise", lp);
+    net.connect(0, 0, siluId, 0);
+    net.connect(sigmoidId, 0, siluId, 1);
+
+    lp = LayerParams();
+    int addId = net.addLayer("add", "Eltwise", lp);
+    net.connect(siluId, 0, addId, 0);
+    net.connect(0, 1, addId, 1);
+
+    int clipId = net.addLayer("clip", "ReLU6", lp);
+    net.connect(addId, 0, clipId, 0);
+
+    lp.set("operation", "mul");
+    int outId = net.addLayer("out", "NaryEltwise", lp);
+    net.connect(clipId, 0, outId, 0);
+    net.connect(scaleId, 0, outId, 1);
+
+    // 2 planes of 2000 elements: tiles are not aligned to planes
+    int inpShape[] = {2, 1, 40, 50};
+    Mat x(4, &inpShape[0], CV_32F), y(4, &inpShape[0], CV_32F);
+    randu(x, -8, 8);
+    randu(y, -2, 2);
+    Mat ref(4, &inpShape[0], CV_32F);
+    for (size_t i = 0; i < x.total(); ++i)
+    {
+        float v = x.ptr<float>()[i];
+        v = v / (1.f + std::exp(-v)) + y.ptr<float>()[i];
+        ref.ptr<float>()[i] = std::min(std::max(v, 0.f), 6.f) * 0.5f;
+    }
+
+    net.enableProfiling();
+    net.setInput(x, "x");
+    net.setInput(y, "y");
+    normAssert(net.forward("out"), ref, "fused");
+
+    // only the last layer of the chain is computed
+    std::vector<LayerProfile> profile = net.getProfile();
+    std::set<int> computed;
+    for (size_t i = 0; i < profile.size(); ++i)
+        computed.insert(profile[i].layerId);
+    EXPECT_EQ(0u, computed.count(sigmoidId));
+    EXPECT_EQ(0u, computed.count(addId));
+    EXPECT_EQ(1u, computed.count(outId));
+
+    // intermediate output requested by user is not fused
+    std::vector<Mat> outs;
+    net.setInput(x, "x");
+    net.setInput(y, "y");
+    net.forward(outs, std::vector<String>{"add", "out"});
+    ASSERT_EQ(2u, outs.size());
+    normAssert(outs[1], ref, "fused with kept blob");
+
+    net.enableFusion(false);
+    net.setInput(x, "x");
+    net.setInput(y, "y");
+    normAssert(net.forward("out"), ref, "not fused");
+    net.setInput(x, "x");
+    net.setInput(y, "y");
+    normAssert(net.forward("add"), outs[0], "intermediate");
+}
+
+TEST(Net, fuseElementwiseChains_smallPlanes)
+{
+    // Tiles consist of several planes (channels) of different samples
+    const std::vector<std::vector<int> > shapes = {{37, 300}, {3, 5, 2, 3}, {4, 7, 10, 10}};
+    for (size_t s = 0; s < shapes.size(); ++s)
+    {
+        const std::vector<int>& shape = shapes[s];
+        const int channels = shape[1];
+        const size_t planeSize = shape.size() > 2 ? (size_t)shape[2] * shape[3] : 1;
+
+        // out = sigmoid(prelu(x + y)), slopes of PReLU are per channel
+        Net net;
+        net.setInputsNames({"x", "y"});
+        LayerParams lp;
+        int addId = net.addLayer("add", "Eltwise", lp);
+        net.connect(0, 0, addId, 0);
+        net.connect(0, 1, addId, 1);
+        Mat slopes(1, channels, CV_32F);
+        randu(slopes, 0, 1);
+        lp.blobs.push_back(slopes);
+        int preluId = net.addLayerToPrev("prelu", "PReLU", lp);
+        LayerParams sigmoid;
+        int outId = net.addLayerToPrev("out", "Sigmoid", sigmoid);
+
+        Mat x(shape, CV_32F), y(shape, CV_32F), ref(shape, CV_32F);
+        randu(x, -1, 1);
+        randu(y, -1, 1);
+        for (size_t i = 0; i < x.total(); ++i)
+        {
+            float v = x.ptr<float>()[i] + y.ptr<float>()[i];
+            if (v < 0)
+                v *= slopes.at<float>((int)(i / planeSize % channels));
+            ref.ptr<float>()[i] = 1.f / (1.f + std::exp(-v));
+        }
+
+        net.enableProfiling();
+        net.setInput(x, "x");
+        net.setInput(y, "y");
+        normAssert(net.forward("out"), ref, cv::format("shape %zu", s).c_str());
+
+        std::vector<LayerProfile> profile = net.getProfile();
+        std::set<int> computed;
+        for (size_t i = 0; i < profile.size(); ++i)
+            computed.insert(profile[i].layerId);
+        EXPECT_EQ(0u, computed.count(preluId)) << s;
+        EXPECT_EQ(1u, computed.count(outId)) << s;
+    }
+}
+
+TEST(Net, removeLayoutRoundTrips)
+{
+    // NCHW -> NHWC -> sigmoid -> relu6 -> NCHW
+    Net net;
+    LayerParams lp;
+    int toNHWC[] = {0, 2, 3, 1}, toNCHW[] = {0, 3, 1, 2};
+    lp.set("order", DictValue::arrayInt(&toNHWC[0], 4));
+    int firstId = net.addLayerToPrev("to_nhwc", "Permute", lp);
+    lp = LayerParams();
+    net.addLayerToPrev("sigmoid", "Sigmoid", lp);
+    net.addLayerToPrev("clip", "ReLU6", lp);
+    lp.set("order", DictValue::arrayInt(&toNCHW[0], 4));
+    int lastId = net.addLayerToPrev("to_nchw", "Permute", lp);
+    lp = LayerParams();
+    lp.set("negative_slope", 0.1);
+    net.addLayerToPrev("out", "ReLU", lp);
+
+    int inpShape[] = {2, 3, 5, 7};
+    Mat x(4, &inpShape[0], CV_32F);
+    randu(x, -8, 8);
+    Mat ref(4, &inpShape[0], CV_32F);
+    for (size_t i = 0; i < x.total(); ++i)
+        ref.ptr<float>()[i] = std::min(1.f / (1.f + std::exp(-x.ptr<float>()[i])), 6.f);
+
+    net.enableProfiling();
+    net.setInput(x);
+    normAssert(net.forward(), ref, "fused");
+
+    std::vector<LayerProfile> profile = net.getProfile();
+    std::set<int> computed;
+    for (size_t i = 0; i < profile.size(); ++i)
+        computed.insert(profile[i].layerId);
+    EXPECT_EQ(0u, computed.count(firstId));
+    EXPECT_EQ(0u, computed.count(lastId));
+
+    // permuted blob requested by user is kept
+    std::vector<Mat> outs;
+    net.setInput(x);
+    net.forward(outs, std::vector<String>{"clip", "out"});
+    ASSERT_EQ(2u, outs.size());
+    EXPECT_EQ(7, outs[0].size[2]);
+    normAssert(outs[1], ref, "with kept blob");
+
+    net.enableFusion(false);
+    net.setInput(x);
+    normAssert(net.forward(), ref, "not fused");
+}
+
+TEST(Net, removeLayoutRoundTrips_layoutDependentLayer)
+{
+    // NCHW -> NHWC -> sigmoid -> <layer which depends on layout> -> NCHW
+    int inpShape[] = {2, 3, 5, 7};
+    const char* middleTypes[] = {"Softmax", "PReLU"};
+    for (int k = 0; k < 2; ++k)
+    {
+        Net net;
+        LayerParams lp;
+        int toNHWC[] = {0, 2, 3, 1}, toNCHW[] = {0, 3, 1, 2};
+        lp.set("order", DictValue::arrayInt(&toNHWC[0], 4));
+        int firstId = net.addLayerToPrev("to_nhwc", "Permute", lp);
+        lp = LayerParams();
+        net.addLayerToPrev("sigmoid", "Sigmoid", lp);
+        if (std::string(middleTypes[k]) == "Softmax")
+            lp.set("axis", 3);  // over channels of NHWC
+        else
+        {
+            Mat slopes(1, inpShape[2], CV_32F);  // per channel of permuted tensor
+            randu(slopes, 0, 1);
+            lp.blobs.push_back(slopes);
+        }
+        int middleId = net.addLayerToPrev("middle", middleTypes[k], lp);
+        lp = LayerParams();
+        lp.set("order", DictValue::arrayInt(&toNCHW[0], 4));
+        int lastId = net.addLayerToPrev("to_nchw", "Permute", lp);
+
+        Mat x(4, &inpShape[0], CV_32F);
+        randu(x, -8, 8);
+        net.enableFusion(false);
+        net.setInput(x);
+        Mat ref = net.forward().clone();
+
+        net.enableFusion(true);
+        net.enableProfiling();
+        net.setInput(x);
+        normAssert(net.forward(), ref, middleTypes[k]);
+
+        // the permutations are kept
+        std::vector<LayerProfile> profile = net.getProfile();
+        std::set<int> computed;
+        for (size_t i = 0; i < profile.size(); ++i)
+            computed.insert(profile[i].layerId);
+        EXPECT_EQ(1u, computed.count(firstId)) << middleTypes[k];
+        EXPECT_EQ(1u, computed.count(middleId)) << middleTypes[k];
+        EXPECT_EQ(1u, computed.count(lastId)) << middleTypes[k];
+    }
+}
+
+TEST(Net, removeLayoutRoundTrips_region)
+{
+    // x -> NHWC -> sigmoid ----------> add -> relu -> concat(C, with sigmoid) -> NCHW -> pool
+    // x -> tanh -> NHWC -------------/             `-> NCHW -> out
+    Net net;
+    LayerParams lp;
+    int toNHWC[] = {0, 2, 3, 1}, toNCHW[] = {0, 3, 1, 2};
+    lp.set("order", DictValue::arrayInt(&toNHWC[0], 4));
+    int entryId = net.addLayer("to_nhwc", "Permute", lp);
+    net.connect(0, 0, entryId, 0);
+    LayerParams empty;
+    int sigmoidId = net.addLayer("sigmoid", "Sigmoid", empty);
+    net.connect(entryId, 0, sigmoidId, 0);
+    int tanhId = net.addLayer("tanh", "TanH", empty);
+    net.connect(0, 0, tanhId, 0);
+    int entry2Id = net.addLayer("tanh_nhwc", "Permute", lp);
+    net.connect(tanhId, 0, entry2Id, 0);
+    int addId = net.addLayer("add", "Eltwise", empty);  // caches the number of channels
+    net.connect(sigmoidId, 0, addId, 0);
+    net.connect(entry2Id, 0, addId, 1);
+    int reluId = net.addLayer("relu", "ReLU", empty);  // fused into Eltwise
+    net.connect(addId, 0, reluId, 0);
+    lp = LayerParams();
+    lp.set("axis", 3);
+    int concatId = net.addLayer("concat", "Concat", lp);
+    net.connect(reluId, 0, concatId, 0);
+    net.connect(sigmoidId, 0, concatId, 1);
+    lp = LayerParams();
+    lp.set("order", DictValue::arrayInt(&toNCHW[0], 4));
+    int exitId = net.addLayer("to_nchw", "Permute", lp);
+    net.connect(concatId, 0, exitId, 0);
+    int exit2Id = net.addLayer("relu_nchw", "Permute", lp);
+    net.connect(reluId, 0, exit2Id, 0);
+    lp = LayerParams();
+    lp.set("pool", "max");
+    lp.set("kernel_size", 2);
+    lp.set("stride", 2);
+    int poolId = net.addLayer("pool", "Pooling", lp);
+    net.connect(exitId, 0, poolId, 0);
+    lp = LayerParams();
+    lp.set("negative_slope", 0.1);
+    int outId = net.addLayer("out", "ReLU", lp);
+    net.connect(exit2Id, 0, outId, 0);
+
+    int inpShape[] = {2, 4, 6, 10};
+    Mat x(4, &inpShape[0], CV_32F);
+    randu(x, -4, 4);
+    std::vector<String> outNames{"pool", "out"};
+    std::vector<Mat> refs, outs;
+    net.enableFusion(false);
+    net.setInput(x);
+    net.forward(refs, outNames);
+    ASSERT_EQ(2u, refs.size());
+    int poolShape[] = {2, 8, 3, 5};
+    EXPECT_EQ(MatShape(poolShape, poolShape + 4), MatShape(refs[0].size.p, refs[0].size.p + refs[0].dims));
+
+    net.enableFusion(true);
+    net.enableProfiling();
+    for (int iter = 0; iter < 2; ++iter)
+    {
+        net.setInput(x);
+        net.forward(outs, outNames);
+        ASSERT_EQ(2u, outs.size());
+        normAssert(outs[0], refs[0], "pool");
+        normAssert(outs[1], refs[1], "out");
+    }
+
+    std::vector<LayerProfile> profile = net.getProfile();
+    std::set<int> computed;
+    for (size_t i = 0; i < profile.size(); ++i)
+        computed.insert(profile[i].layerId);
+    EXPECT_EQ(0u, computed.count(entryId));
+    EXPECT_EQ(0u, computed.count(entry2Id));
+    EXPECT_EQ(0u, computed.count(exitId));
+    EXPECT_EQ(0u, computed.count(exit2Id));
+    EXPECT_EQ(1u, computed.count(concatId));
+    EXPECT_EQ(1u, computed.count(poolId));
+
+    // blob in NHWC layout requested by user
+    net.setInput(x);
+    net.forward(outs, std::vector<String>{"pool", "concat"});
+    normAssert(outs[0], refs[0], "pool with kept blob");
+    EXPECT_EQ(8, outs[1].size[3]);
+}
+
 #ifdef HAVE_INF_ENGINE
 static const std::chrono::milliseconds async_timeout(10000);
 
@@ -37,6 +37,98 @@ TEST(NMS, Accuracy)
         ASSERT_EQ(indices[i], ref_indices[i]);
 }
 
+static void referenceNMS(const std::vector<Rect>& bboxes, const std::vector<float>& scores,
+                         float score_thresh, float nms_thresh, std::vector<int>& indices)
+{
+    std::vector<std::pair<float, int> > candidates;
+    for (size_t i = 0; i < scores.size(); i++)
+    {
+        if (scores[i] > score_thresh)
+            candidates.push_back(std::make_pair(scores[i], (int)i));
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; });
+    indices.clear();
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+        const int idx = candidates[i].second;
+        bool keep = true;
+        for (size_t k = 0; k < indices.size() && keep; k++)
+            keep = 1.f - (float)jaccardDistance(bboxes[idx], bboxes[indices[k]]) <= nms_thresh;
+        if (keep)
+            indices.push_back(idx);
+    }
+}
+
+TEST(NMS, random_boxes)
+{
+    RNG& rng = theRNG();
+    const int numBoxes = 1000;
+    std::vector<Rect> bboxes(numBoxes);
+    std::vector<float> scores(numBoxes);
+    std::vector<int> classIds(numBoxes);
+    for (int i = 0; i < numBoxes; i++)
+    {
+        // quite a lot of overlapped boxes and a few empty ones
+        bboxes[i] = Rect(rng.uniform(0, 200), rng.uniform(0, 200), rng.uniform(0, 50), rng.uniform(0, 50));
+        scores[i] = rng.uniform(0, 20) * 0.05f;  // many equal scores
+        classIds[i] = rng.uniform(0, 5);
+    }
+
+    const float score_thresh = 0.1f, nms_thresh = 0.4f;
+    std::vector<int> indices, ref;
+    cv::dnn::NMSBoxes(bboxes, scores, score_thresh, nms_thresh, indices);
+    referenceNMS(bboxes, scores, score_thresh, nms_thresh, ref);
+    EXPECT_EQ(ref, indices);
+
+    // boxes of different classes don't suppress each other
+    cv::dnn::NMSBoxesBatched(bboxes, scores, classIds, score_thresh, nms_thresh, indices);
+    std::vector<std::pair<float, int> > refBatched;
+    for (int c = 0; c < 5; c++)
+    {
+        std::vector<Rect> classBoxes;
+        std::vector<float> classScores;
+        std::vector<int> classIndices;
+        for (int i = 0; i < numBoxes; i++)
+        {
+            if (classIds[i] != c)
+                continue;
+            classBoxes.push_back(bboxes[i]);
+            classScores.push_back(scores[i]);
+            classIndices.push_back(i);
+        }
+        referenceNMS(classBoxes, classScores, score_thresh, nms_thresh, ref);
+        for (size_t i = 0; i < ref.size(); i++)
+            refBatched.push_back(std::make_pair(classScores[ref[i]], classIndices[ref[i]]));
+    }
+    std::sort(refBatched.begin(), refBatched.end(), [](const std::pair<float, int>& a, const std::pair<float, int>& b)
+    {
+        return a.first == b.first ? a.second < b.second : a.first > b.first;
+    });
+    ASSERT_EQ(refBatched.size(), indices.size());
+    for (size_t i = 0; i < indices.size(); i++)
+        EXPECT_EQ(refBatched[i].second, indices[i]) << i;
+
+    // the same as NMSBoxes() of boxes shifted apart by classes, including the order of equal scores.
+    // Empty boxes are skipped: they suppress each other in NMSBoxes() regardless of the position.
+    std::vector<Rect> shifted(bboxes);
+    std::vector<float> nonEmptyScores(scores);
+    for (int i = 0; i < numBoxes; i++)
+    {
+        shifted[i].x += classIds[i] * 1000;
+        if (bboxes[i].empty())
+            nonEmptyScores[i] = 0;
+    }
+    cv::dnn::NMSBoxes(shifted, nonEmptyScores, score_thresh, nms_thresh, ref);
+    std::vector<int> nonEmptyIndices;
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+        if (!bboxes[indices[i]].empty())
+            nonEmptyIndices.push_back(indices[i]);
+    }
+    EXPECT_EQ(ref, nonEmptyIndices);
+}
+
 TEST(SoftNMS, Accuracy)
 {
     //reference results are obtained using TF v2.7 tf.image.non_max_suppression_with_scores
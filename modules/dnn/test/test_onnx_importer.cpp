@@ -2474,4 +2474,96 @@ TEST_P(Test_ONNX_layers, YOLOv7)
 
 INSTANTIATE_TEST_CASE_P(/**/, Test_ONNX_nets, dnnBackendsAndTargets());
 
+// Minimal protobuf wire format writer to generate models with external data
+static std::string pbVarint(uint64 v)
+{
+    std::string out;
+    for (; v >= 0x80; v >>= 7)
+        out.push_back((char)((v & 0x7f) | 0x80));
+    out.push_back((char)v);
+    return out;
+}
+static std::string pbInt(int field, uint64 v) { return pbVarint((uint64)field << 3) + pbVarint(v); }
+static std::string pbBytes(int field, const std::string& v) { return pbVarint(((uint64)field << 3) | 2) + pbVarint(v.size()) + v; }
+
+static std::string pbValueInfo(const std::string& name, const std::vector<int>& shape)
+{
+    std::string dims;
+    for (size_t i = 0; i < shape.size(); i++)
+        dims += pbBytes(1, pbInt(1, shape[i]));  // TensorShapeProto.dim.dim_value
+    std::string tensorType = pbInt(1, 1) + pbBytes(2, dims);  // elem_type: FLOAT
+    return pbBytes(1, name) + pbBytes(2, pbBytes(1, tensorType));
+}
+
+// Add(x, W) model, W is stored in external data file
+static std::string createExternalDataModel(int n, const std::string& location, const std::string& offset)
+{
+    std::string tensor = pbInt(1, 1) + pbInt(1, n) + pbInt(2, 1) + pbBytes(8, "W") +
+                         pbBytes(13, pbBytes(1, "location") + pbBytes(2, location)) +
+                         pbBytes(13, pbBytes(1, "offset") + pbBytes(2, offset)) +
+                         pbBytes(13, pbBytes(1, "length") + pbBytes(2, std::to_string(n * sizeof(float)))) +
+                         pbInt(14, 1);  // data_location: EXTERNAL
+    std::string node = pbBytes(1, "x") + pbBytes(1, "W") + pbBytes(2, "y") + pbBytes(3, "add") + pbBytes(4, "Add");
+    std::vector<int> shape = {1, n};
+    std::string graph = pbBytes(1, node) + pbBytes(2, "external_data") + pbBytes(5, tensor) +
+                        pbBytes(11, pbValueInfo("x", shape)) + pbBytes(12, pbValueInfo("y", shape));
+    return pbInt(1, 7) + pbBytes(8, pbInt(2, 13)) + pbBytes(7, graph);
+}
+
+static void writeFile(const std::string& path, const std::string& data)
+{
+    std::ofstream f(path.c_str(), std::ios::binary);
+    f << data;
+}
+
+TEST(Test_ONNX_ExternalData, Add)
+{
+    const int n = 16;
+    Mat weights(1, n, CV_32F), inp(1, n, CV_32F);
+    randu(weights, -1, 1);
+    randu(inp, -1, 1);
+
+    const std::string modelPath = cv::tempfile(".onnx");
+    const std::string dataPath = cv::tempfile("..data");  // '..' is allowed as a part of the file name
+    const size_t pos = dataPath.find_last_of("/\\");
+    const std::string dataLocation = pos == std::string::npos ? dataPath : dataPath.substr(pos + 1);
+    ASSERT_EQ(modelPath.substr(0, modelPath.find_last_of("/\\")), dataPath.substr(0, pos));
+
+    const size_t offset = 64;  // some leading data before the tensor
+    writeFile(dataPath, std::string(offset, '\0') + std::string((const char*)weights.data, n * sizeof(float)));
+
+    std::string model = createExternalDataModel(n, dataLocation, std::to_string(offset));
+    writeFile(modelPath, model);
+
+    Net net = readNetFromONNX(modelPath);
+    ASSERT_FALSE(net.empty());
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setInput(inp);
+    Mat out = net.forward();
+    Mat ref = inp + weights;
+    normAssert(out.reshape(1, 1), ref);
+
+    // External data is not available for in-memory models
+    EXPECT_ANY_THROW(readNetFromONNX(model.data(), model.size()));
+
+    // Malformed offsets
+    const char* offsets[] = {"", "-64", " 64", "64x", "99999999999999999999999"};
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++)
+    {
+        writeFile(modelPath, createExternalDataModel(n, dataLocation, offsets[i]));
+        EXPECT_THROW(readNetFromONNX(modelPath), cv::Exception) << "offset: '" << offsets[i] << "'";
+    }
+
+    // Locations outside of the model directory
+    const char* locations[] = {"..", "../w.bin", "a/../../w.bin", "a\\..\\w.bin", "/tmp/w.bin", "C:w.bin"};
+    for (size_t i = 0; i < sizeof(locations) / sizeof(locations[0]); i++)
+    {
+        writeFile(modelPath, createExternalDataModel(n, locations[i], std::to_string(offset)));
+        EXPECT_THROW(readNetFromONNX(modelPath), cv::Exception) << "location: " << locations[i];
+    }
+
+    remove(modelPath.c_str());
+    remove(dataPath.c_str());
+}
+
 }} // namespace
@@ -146,6 +146,27 @@ struct GFluidParallelFor
     // - and a function to be called on the range items, designated by item index
     std::function<void(std::size_t size, std::function<void(std::size_t index)>)> parallel_for;
 };
+
+/**
+ * @brief This structure makes Fluid backend split the graph output into
+ * horizontal bands which are processed in parallel.
+ *
+ * Every band is processed as an independent region, input rows required
+ * by kernels' borders are computed by each of the neighbouring bands.
+ * Bands are executed with the GFluidParallelFor functor if specified,
+ * or with cv::parallel_for_ otherwise.
+ *
+ * The feature is applied to one-island graphs which outputs have the
+ * same height and can't be combined with GFluidOutputRois or
+ * GFluidParallelOutputRois.
+ */
+struct GFluidParallelBands
+{
+    /// Number of bands, 0 means the number of threads of cv::getNumThreads()
+    int num_bands = 0;
+    /// Bands are not made smaller, so the rows computed twice stay a small fraction of work
+    int min_band_height = 32;
+};
 /** @} gapi_compile_args */
 
 namespace detail
@@ -165,6 +186,11 @@ template<> struct CompileArgTag<GFluidParallelOutputRois>
     static const char* tag() { return "gapi.fluid.parallelOutputRois"; }
 };
 
+template<> struct CompileArgTag<GFluidParallelBands>
+{
+    static const char* tag() { return "gapi.fluid.parallelBands"; }
+};
+
 } // namespace detail
 
 namespace detail
@@ -21,6 +21,12 @@ namespace cv {
 
 template<class T> using optional = cv::util::optional<T>;
 
+namespace gapi {
+namespace streaming {
+struct latency_stats;
+} // namespace streaming
+} // namespace gapi
+
 namespace detail {
 template<typename T> struct wref_spec {
     using type = T;
@@ -350,6 +356,19 @@ public:
      */
     GAPI_WRAP bool running() const;
 
+    /**
+     * @brief Get frame statistics of the latency-bounded mode.
+     *
+     * The statistics is collected for the current stream since the
+     * last setSource() call and remains available after the stream is
+     * over or stopped.
+     *
+     * @return numbers of processed and dropped frames for every graph
+     * input. Empty if the pipeline is not compiled with
+     * cv::gapi::streaming::latency_bound.
+     */
+    cv::gapi::streaming::latency_stats latencyStats() const;
+
     /// @private
     Priv& priv();
 
@@ -413,6 +432,52 @@ struct GAPI_EXPORTS_W_SIMPLE queue_capacity
     GAPI_PROP_RW
     size_t capacity;
 };
+
+/**
+ * @brief Specify the kind of queues for streaming execution.
+ *
+ * Blocking queues take a lock on every push and pop. Lock-free queues
+ * spin for a short time before they put the waiting thread to sleep,
+ * this reduces the per-frame overhead of pipelines with many small
+ * steps at the cost of some CPU time spent in waiting.
+ */
+enum class queue_kind
+{
+    blocking,  //!< Queues with a mutex and condition variables (default)
+    lock_free  //!< Bounded lock-free ring buffers with spin-then-park waiting
+};
+
+/**
+ * @brief Run the streaming pipeline in the latency-bounded mode.
+ *
+ * By default every frame of a video source is processed, so if some
+ * pipeline step is slower than the source, frames wait in the queues
+ * and the latency grows. In the latency-bounded mode at most
+ * max_in_flight frames of every video source are in the pipeline at a
+ * time; a frame leaves the pipeline when its result is pulled. Frames
+ * produced by the source while the pipeline is full are dropped, so
+ * the pipeline always takes the latest frame for processing.
+ *
+ * This mode can't be combined with cv::gapi::streaming::sync_policy::drop.
+ *
+ * @sa cv::GStreamingCompiled::latencyStats()
+ */
+struct GAPI_EXPORTS latency_bound
+{
+    explicit latency_bound(size_t max_frames = 1) : max_in_flight(max_frames) { };
+    size_t max_in_flight;
+};
+
+/**
+ * @brief Frame statistics of the latency-bounded mode.
+ *
+ * Vectors are indexed as graph inputs, constant inputs have zeros.
+ */
+struct GAPI_EXPORTS latency_stats
+{
+    std::vector<size_t> emitted; //!< Frames taken into processing
+    std::vector<size_t> dropped; //!< Frames dropped since the pipeline was full
+};
 /** @} */
 } // namespace streaming
 } // namespace gapi
@@ -423,6 +488,16 @@ template<> struct CompileArgTag<cv::gapi::streaming::queue_capacity>
 {
     static const char* tag() { return "gapi.queue_capacity"; }
 };
+
+template<> struct CompileArgTag<cv::gapi::streaming::queue_kind>
+{
+    static const char* tag() { return "gapi.streaming.queue_kind"; }
+};
+
+template<> struct CompileArgTag<cv::gapi::streaming::latency_bound>
+{
+    static const char* tag() { return "gapi.streaming.latency_bound"; }
+};
 }
 
 }
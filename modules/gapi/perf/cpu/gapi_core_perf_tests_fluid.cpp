@@ -222,7 +222,7 @@ INSTANTIATE_TEST_CASE_P(IntegralPerfTestFluid, IntegralPerfTest,
 INSTANTIATE_TEST_CASE_P(ThresholdPerfTestFluid, ThresholdPerfTest,
     Combine(Values(AbsExact().to_compare_f()),
             Values(szSmall128, szVGA, sz720p, sz1080p),
-            Values(CV_8UC1, CV_8UC3, CV_16UC1, CV_16SC1),
+            Values(CV_8UC1, CV_8UC3, CV_16UC1, CV_16SC1, CV_32FC1),
             Values(cv::THRESH_BINARY, cv::THRESH_BINARY_INV, cv::THRESH_TRUNC,
                    cv::THRESH_TOZERO, cv::THRESH_TOZERO_INV),
             Values(cv::compile_args(CORE_FLUID))));
@@ -144,6 +144,11 @@ INSTANTIATE_TEST_CASE_P(SobelXYPerfTestFluid32F, SobelXYPerfTest,
             Values(1, 2),
             Values(cv::compile_args(IMGPROC_FLUID))));
 
+INSTANTIATE_TEST_CASE_P(BGR2RGBPerfTestFluid, BGR2RGBPerfTest,
+    Combine(Values(AbsExact().to_compare_f()),
+            Values(szVGA, sz720p, sz1080p),
+            Values(cv::compile_args(IMGPROC_FLUID))));
+
 INSTANTIATE_TEST_CASE_P(RGB2GrayPerfTestFluid, RGB2GrayPerfTest,
     Combine(Values(ToleranceColor(1e-3).to_compare_f()),
             Values(szVGA, sz720p, sz1080p),
@@ -202,7 +207,7 @@ INSTANTIATE_TEST_CASE_P(RGB2LabPerfTestFluid, RGB2LabPerfTest,
 INSTANTIATE_TEST_CASE_P(ResizePerfTestFluid, ResizePerfTest,
     Combine(Values(Tolerance_FloatRel_IntAbs(1e-5, 1).to_compare_f()),
             Values(CV_8UC3, CV_32FC1),
-            Values(cv::INTER_LINEAR),
+            Values(cv::INTER_LINEAR, cv::INTER_NEAREST),
             Values(szSmall128, szVGA, sz720p, sz1080p),
             Values(cv::Size(64, 64),
                    cv::Size(30, 30)),
@@ -226,7 +231,7 @@ INSTANTIATE_TEST_CASE_P(ResizeInSimpleGraphPerfTestFluid, ResizeInSimpleGraphPer
 INSTANTIATE_TEST_CASE_P(ResizeFxFyPerfTestFluid, ResizeFxFyPerfTest,
     Combine(Values(Tolerance_FloatRel_IntAbs(1e-5, 1).to_compare_f()),
             Values(CV_8UC3, CV_32FC1),
-            Values(cv::INTER_LINEAR),
+            Values(cv::INTER_LINEAR, cv::INTER_NEAREST),
             Values(szSmall128, szVGA, sz720p, sz1080p),
             Values(0.5, 0.25, 2),
             Values(0.5, 0.25, 2),
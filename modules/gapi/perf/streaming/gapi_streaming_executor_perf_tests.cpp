@@ -0,0 +1,85 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../perf_precomp.hpp"
+#include "../../test/common/gapi_tests_common.hpp"
+
+#include <opencv2/gapi/streaming/source.hpp>
+
+namespace opencv_test
+{
+using namespace perf;
+
+namespace {
+// Small frames, so the time is spent on passing data between the islands
+class FramesSource : public cv::gapi::wip::IStreamSource {
+public:
+    explicit FramesSource(const int num_frames)
+        : m_num_frames(num_frames), m_curr_frame_id(0), m_mat(8, 8, CV_8UC1, cv::Scalar(0)) {
+    }
+
+    bool pull(cv::gapi::wip::Data& d) override {
+        if (m_curr_frame_id++ == m_num_frames) {
+            return false;
+        }
+        d = m_mat.clone();
+        return true;
+    }
+
+    cv::GMetaArg descr_of() const override {
+        return cv::GMetaArg{cv::descr_of(m_mat)};
+    }
+
+private:
+    int m_num_frames;
+    int m_curr_frame_id;
+    cv::Mat m_mat;
+};
+} // anonymous namespace
+
+using queue_kind_t = cv::gapi::streaming::queue_kind;
+
+inline std::ostream& operator<<(std::ostream& os, queue_kind_t kind)
+{
+    return os << (kind == queue_kind_t::lock_free ? "LOCK_FREE" : "BLOCKING");
+}
+
+class StreamingExecutorPerfTest : public TestPerfParams<tuple<int, queue_kind_t>> {};
+
+PERF_TEST_P_(StreamingExecutorPerfTest, TestPerformance)
+{
+    constexpr int num_frames = 1000;
+    int num_steps = 0;
+    queue_kind_t kind = queue_kind_t::blocking;
+    std::tie(num_steps, kind) = GetParam();
+
+    cv::GMat in;
+    cv::GMat out = in;
+    for (int i = 0; i < num_steps; i++) {
+        cv::GMat step_in = out;
+        out = cv::gapi::bitwise_not(step_in);
+        cv::gapi::island("step" + std::to_string(i), cv::GIn(step_in), cv::GOut(out));
+    }
+
+    auto pipeline = cv::GComputation(in, out).compileStreaming(
+        cv::compile_args(cv::gapi::core::cpu::kernels(),
+                         kind));
+
+    cv::Mat out_mat;
+    TEST_CYCLE()
+    {
+        pipeline.setSource(std::make_shared<FramesSource>(num_frames));
+        pipeline.start();
+        while (pipeline.pull(cv::gout(out_mat))) {
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(Streaming, StreamingExecutorPerfTest,
+                        Combine(Values(1, 4, 8),
+                                Values(queue_kind_t::blocking,
+                                       queue_kind_t::lock_free)));
+} // namespace opencv_test
@@ -18,9 +18,12 @@
 #include <opencv2/gapi/gcommon.hpp>
 #include <opencv2/gapi/util/any.hpp>
 #include <opencv2/gapi/gtype_traits.hpp>
+#include <opencv2/gapi/cpu/core.hpp>
+#include <opencv2/gapi/cpu/imgproc.hpp>
 
 #include "compiler/gobjref.hpp"
 #include "compiler/gmodel.hpp"
+#include "compiler/passes/buffer_reuse.hpp"
 
 #include "backends/cpu/gcpubackend.hpp"
 
@@ -168,6 +171,33 @@ void cv::gimpl::GCPUExecutable::setupKernelStates()
     }
 }
 
+namespace {
+// In-place execution is allowed only for the kernels of cv::gapi::core::cpu::kernels()
+// and cv::gapi::imgproc::cpu::kernels(): user kernels of the same operations may not support it.
+// Kernels are compared by their entry points.
+bool isBuiltinKernel(const std::string &id, const cv::GCPUKernel &kernel) {
+    using RunPtr = void(*)(cv::GCPUContext &);
+    static const std::unordered_map<std::string, RunPtr> builtins = []() {
+        std::unordered_map<std::string, RunPtr> runs;
+        const auto pkg = cv::gapi::combine(cv::gapi::core::cpu::kernels(),
+                                           cv::gapi::imgproc::cpu::kernels());
+        for (const auto &kernel_id : pkg.get_kernel_ids()) {
+            const auto impl = pkg.lookup(kernel_id).second;
+            const auto &cpu_kernel = cv::util::any_cast<cv::GCPUKernel>(impl.opaque);
+            const auto *run = cpu_kernel.m_runF.target<RunPtr>();
+            if (run != nullptr) {
+                runs[kernel_id] = *run;
+            }
+        }
+        return runs;
+    }();
+
+    const auto it = builtins.find(id);
+    const auto *run = kernel.m_runF.target<RunPtr>();
+    return it != builtins.end() && run != nullptr && *run == it->second;
+}
+} // anonymous namespace
+
 void cv::gimpl::GCPUExecutable::makeReshape() {
     // Prepare the execution script
     m_script.clear();
@@ -175,13 +205,28 @@ void cv::gimpl::GCPUExecutable::makeReshape() {
         m_script.push_back({nh, GModel::collectOutputMeta(m_gm, nh)});
     }
 
-    // Preallocate internal mats
+    // Preallocate internal mats.
+    // Mats which are never in use at the same time share the memory
+    GConstGCPUModel gcm(m_g);
+    const auto reuse = passes::reuseBuffers(m_g, m_opNodes, [&](const ade::NodeHandle &nh) {
+        return isBuiltinKernel(m_gm.metadata(nh).get<Op>().k.name, gcm.metadata(nh).get<CPUUnit>().k);
+    });
+    std::vector<cv::Mat> buffers(reuse.buffers.size());
+    for (std::size_t i = 0; i < buffers.size(); i++) {
+        createMat(reuse.buffers[i], buffers[i]);
+    }
+
     for (auto& nh : m_dataNodes) {
         const auto& desc = m_gm.metadata(nh).get<Data>();
         if (desc.storage == Data::Storage::INTERNAL && desc.shape == GShape::GMAT) {
-            const auto mat_desc = util::get<cv::GMatDesc>(desc.meta);
             auto& mat = m_res.slot<cv::Mat>()[desc.rc];
-            createMat(mat_desc, mat);
+            auto it = reuse.buffer_of.find(desc.rc);
+            if (it != reuse.buffer_of.end()) {
+                mat = buffers[it->second];
+            } else {
+                const auto mat_desc = util::get<cv::GMatDesc>(desc.meta);
+                createMat(mat_desc, mat);
+            }
         }
     }
 }
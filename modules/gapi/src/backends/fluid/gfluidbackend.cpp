@@ -13,6 +13,7 @@
 #include <set>
 #include <unordered_set>
 #include <stack>
+#include <limits>
 
 #include <ade/util/algorithm.hpp>
 #include <ade/util/chain_range.hpp>
@@ -95,6 +96,9 @@ namespace
             auto graph_data = fluidExtractInputDataFromGraph(graph, nodes);
             const auto parallel_out_rois = cv::gapi::getCompileArg<cv::GFluidParallelOutputRois>(args);
             const auto gpfor             = cv::gapi::getCompileArg<cv::GFluidParallelFor>(args);
+            const auto parallel_bands    = cv::gapi::getCompileArg<cv::GFluidParallelBands>(args);
+            if (parallel_bands.has_value() && (out_rois.has_value() || parallel_out_rois.has_value()))
+                cv::util::throw_error(std::logic_error("GFluidParallelBands can't be combined with GFluidOutputRois or GFluidParallelOutputRois"));
 
 #if !defined(GAPI_STANDALONE)
             auto default_pfor = [](std::size_t count, std::function<void(std::size_t)> f){
@@ -121,6 +125,13 @@ namespace
 
             auto pfor  = gpfor.has_value() ? gpfor.value().parallel_for : default_pfor;
 
+            if (parallel_bands.has_value() && num_islands == 1)
+            {
+                auto band_rois = fluidBandRois(graph, parallel_bands.value(), std::numeric_limits<std::size_t>::max());
+                if (band_rois.size() > 1)
+                    return EPtr{new cv::gimpl::GParallelFluidExecutable(graph, graph_data, parallel_bands.value(), band_rois, pfor)};
+            }
+
             return parallel_out_rois.has_value() ?
                        EPtr{new cv::gimpl::GParallelFluidExecutable (graph, graph_data, std::move(parallel_out_rois.value().parallel_rois), pfor)}
                      : EPtr{new cv::gimpl::GFluidExecutable         (graph, graph_data, std::move(rois.rois))}
@@ -744,6 +755,55 @@ void cv::gimpl::GFluidExecutable::initBufferRois(std::vector<int>& readStarts,
     } // while (!nodesToVisit.empty())
 }
 
+std::vector<cv::GFluidOutputRois> cv::gimpl::fluidBandRois(const ade::Graph &g,
+                                                          const cv::GFluidParallelBands &bands,
+                                                          std::size_t max_bands)
+{
+    GModel::ConstGraph gm(g);
+    const auto &proto = gm.metadata().get<Protocol>();
+
+    // Output rois are inferred into the graph independently, so bands of
+    // all the outputs must be the same rows to produce consistent rois of inputs
+    std::vector<int> widths;
+    int height = -1;
+    for (const auto &nh : proto.out_nhs)
+    {
+        const auto &d = gm.metadata(nh).get<Data>();
+        if (d.shape != GShape::GMAT)
+            return {};
+        const auto &desc = util::get<GMatDesc>(d.meta);
+        if (height != -1 && height != desc.size.height)
+            return {};
+        height = desc.size.height;
+        widths.push_back(desc.size.width);
+    }
+    if (height <= 0)
+        return {};
+
+#if !defined(GAPI_STANDALONE)
+    const int default_bands = cv::getNumThreads();
+#else
+    const int default_bands = 1;
+#endif
+    // Band boundaries are even, so 4:2:0 kernels' inputs stay aligned
+    const int min_height = std::max(bands.min_band_height, 2);
+    std::size_t num = static_cast<std::size_t>(bands.num_bands > 0 ? bands.num_bands : default_bands);
+    num = std::min(num, max_bands);
+    num = std::max<std::size_t>(std::min(num, static_cast<std::size_t>(height / min_height)), 1u);
+
+    std::vector<cv::GFluidOutputRois> band_rois(num);
+    for (std::size_t i = 0; i < num; ++i)
+    {
+        const int y0 = i == 0       ? 0      : static_cast<int>(height * i / num) & ~1;
+        const int y1 = i == num - 1 ? height : static_cast<int>(height * (i + 1) / num) & ~1;
+        for (int w : widths)
+        {
+            band_rois[i].rois.emplace_back(0, y0, w, y1 - y0);
+        }
+    }
+    return band_rois;
+}
+
 cv::gimpl::FluidGraphInputData cv::gimpl::fluidExtractInputDataFromGraph(const ade::Graph &g, const std::vector<ade::NodeHandle> &nodes)
 {
     decltype(FluidGraphInputData::m_agents_data)       agents_data;
@@ -1382,19 +1442,45 @@ cv::gimpl::GParallelFluidExecutable::GParallelFluidExecutable(const ade::Graph
     for (auto&& rois : parallelOutputRois){
         tiles.emplace_back(new GFluidExecutable(g, graph_data, rois.rois));
     }
+    active_tiles = tiles.size();
 }
 
+cv::gimpl::GParallelFluidExecutable::GParallelFluidExecutable(const ade::Graph                      &g,
+                                                              const FluidGraphInputData             &graph_data,
+                                                              const GFluidParallelBands             &parallelBands,
+                                                              const std::vector<GFluidOutputRois>   &bandRois,
+                                                              const decltype(parallel_for)          &pfor)
+: GParallelFluidExecutable(g, graph_data, bandRois, pfor)
+{
+    bands = parallelBands;
+}
 
-void cv::gimpl::GParallelFluidExecutable::reshape(ade::Graph&, const GCompileArgs& )
+
+void cv::gimpl::GParallelFluidExecutable::reshape(ade::Graph& g, const GCompileArgs& args)
 {
-    //TODO: implement ?
-    GAPI_Assert(false && "Not Implemented;");
+    // Only bands made by the backend can be rebuilt for the new metadata,
+    // number of tiles is not increased since they are created at compile time
+    GAPI_Assert(bands.has_value() && "Reshape is not supported with GFluidParallelOutputRois");
+    const auto band_rois = fluidBandRois(g, bands.value(), tiles.size());
+    if (band_rois.empty())
+    {
+        tiles.front()->reshape(g, args);
+        active_tiles = 1u;
+        return;
+    }
+    for (auto it : ade::util::indexed(band_rois))
+    {
+        auto tile_args = args;
+        tile_args += cv::compile_args(ade::util::value(it));
+        tiles[ade::util::index(it)]->reshape(g, tile_args);
+    }
+    active_tiles = band_rois.size();
 }
 
 void cv::gimpl::GParallelFluidExecutable::run(std::vector<InObj>  &&input_objs,
                                               std::vector<OutObj> &&output_objs)
 {
-    parallel_for(tiles.size(), [&, this](std::size_t index){
+    parallel_for(active_tiles, [&, this](std::size_t index){
         GAPI_Assert((bool)tiles[index]);
         tiles[index]->run(input_objs, output_objs);
     });
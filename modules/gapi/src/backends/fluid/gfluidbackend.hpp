@@ -116,6 +116,9 @@ struct FluidGraphInputData {
 };
 //local helper function to traverse the graph once and pass the results to multiple instances of GFluidExecutable
 FluidGraphInputData fluidExtractInputDataFromGraph(const ade::Graph &m_g, const std::vector<ade::NodeHandle> &nodes);
+//local helper function to split outputs of the graph into at most max_bands horizontal bands,
+//returns an empty vector if outputs of the graph can't be split (e.g. they have different heights)
+std::vector<GFluidOutputRois> fluidBandRois(const ade::Graph &g, const GFluidParallelBands &bands, std::size_t max_bands);
 
 class GFluidExecutable final: public GIslandExecutable
 {
@@ -169,15 +172,23 @@ class GParallelFluidExecutable final: public GIslandExecutable {
     GParallelFluidExecutable(const GParallelFluidExecutable&) = delete;  // due std::unique_ptr in members list
 
     std::vector<std::unique_ptr<GFluidExecutable>> tiles;
+    std::size_t active_tiles;  // tiles beyond this number are not used with the current metadata
     decltype(GFluidParallelFor::parallel_for) parallel_for;
+    cv::util::optional<GFluidParallelBands> bands;  // set if tiles are bands made by the backend
 public:
     GParallelFluidExecutable(const ade::Graph                       &g,
                              const FluidGraphInputData              &graph_data,
                              const std::vector<GFluidOutputRois>    &parallelOutputRois,
                              const decltype(parallel_for)           &pfor);
 
+    GParallelFluidExecutable(const ade::Graph                       &g,
+                             const FluidGraphInputData              &graph_data,
+                             const GFluidParallelBands              &parallelBands,
+                             const std::vector<GFluidOutputRois>    &bandRois,
+                             const decltype(parallel_for)           &pfor);
+
 
-    virtual inline bool canReshape() const override { return false; }
+    virtual inline bool canReshape() const override { return bands.has_value(); }
     virtual void reshape(ade::Graph& g, const GCompileArgs& args) override;
 
     virtual void run(std::vector<InObj>  &&input_objs,
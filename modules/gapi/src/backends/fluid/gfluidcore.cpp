@@ -2034,26 +2034,32 @@ static void run_threshold(Buffer &dst, const View &src, const cv::Scalar &thresh
     DST threshd = saturate<DST>(thresh[0], roundd);
     DST maxvald = saturate<DST>(maxval[0], roundd);
 
+    int l = 0;
+
+#if CV_SIMD
+    l = threshold_simd(in, out, length, thresh_, threshd, maxvald, type);
+#endif
+
     switch (type)
     {
     case cv::THRESH_BINARY:
-        for (int l=0; l < length; l++)
+        for (; l < length; l++)
             out[l] = in[l] > thresh_? maxvald: 0;
         break;
     case cv::THRESH_BINARY_INV:
-        for (int l=0; l < length; l++)
+        for (; l < length; l++)
             out[l] = in[l] > thresh_? 0: maxvald;
         break;
     case cv::THRESH_TRUNC:
-        for (int l=0; l < length; l++)
+        for (; l < length; l++)
             out[l] = in[l] > thresh_? threshd: in[l];
         break;
     case cv::THRESH_TOZERO:
-        for (int l=0; l < length; l++)
+        for (; l < length; l++)
             out[l] = in[l] > thresh_? in[l]: 0;
         break;
     case cv::THRESH_TOZERO_INV:
-        for (int l=0; l < length; l++)
+        for (; l < length; l++)
             out[l] = in[l] > thresh_? 0: in[l];
         break;
     default: CV_Error(cv::Error::StsBadArg, "unsupported threshold type");
@@ -2073,6 +2079,7 @@ GAPI_FLUID_KERNEL(GFluidThreshold, cv::gapi::core::GThreshold, false)
         UNARY_(uchar , uchar , run_threshold, dst, src, thresh, maxval, type);
         UNARY_(ushort, ushort, run_threshold, dst, src, thresh, maxval, type);
         UNARY_( short,  short, run_threshold, dst, src, thresh, maxval, type);
+        UNARY_( float,  float, run_threshold, dst, src, thresh, maxval, type);
 
         CV_Error(cv::Error::StsBadArg, "unsupported combination of types");
     }
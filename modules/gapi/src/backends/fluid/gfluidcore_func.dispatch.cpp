@@ -291,6 +291,21 @@ int merge4_simd(const uchar in1[], const uchar in2[], const uchar in3[],
                     CV_CPU_DISPATCH_MODES_ALL);
 }
 
+#define THRESHOLD_SIMD(T)                                                        \
+int threshold_simd(const T in[], T out[], const int length, const T thresh,      \
+                   const T threshd, const T maxval, const int type)              \
+{                                                                                \
+    CV_CPU_DISPATCH(threshold_simd, (in, out, length, thresh, threshd, maxval,   \
+                                     type), CV_CPU_DISPATCH_MODES_ALL);          \
+}
+
+THRESHOLD_SIMD(uchar)
+THRESHOLD_SIMD(ushort)
+THRESHOLD_SIMD(short)
+THRESHOLD_SIMD(float)
+
+#undef THRESHOLD_SIMD
+
 #define ADD_SIMD(SRC, DST)                                                    \
 int add_simd(const SRC in1[], const SRC in2[], DST out[], const int length)   \
 {                                                                             \
@@ -12,6 +12,7 @@
 #include "opencv2/gapi/own/saturate.hpp"
 
 #include "opencv2/core.hpp"
+#include "opencv2/imgproc.hpp"
 #include <opencv2/core/hal/intrin.hpp>
 #include <opencv2/core/hal/hal.hpp>
 
@@ -328,6 +329,17 @@ int merge3_simd(const uchar in1[], const uchar in2[], const uchar in3[],
 int merge4_simd(const uchar in1[], const uchar in2[], const uchar in3[],
                 const uchar in4[], uchar out[], const int width);
 
+#define THRESHOLD_SIMD(T)                                                       \
+int threshold_simd(const T in[], T out[], const int length, const T thresh,     \
+                   const T threshd, const T maxval, const int type);
+
+THRESHOLD_SIMD(uchar)
+THRESHOLD_SIMD(ushort)
+THRESHOLD_SIMD(short)
+THRESHOLD_SIMD(float)
+
+#undef THRESHOLD_SIMD
+
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
 #define SRC_SHORT_OR_USHORT std::is_same<SRC, short>::value || std::is_same<SRC, ushort>::value
@@ -3132,6 +3144,84 @@ CONVERTTO_SCALED_SIMD(float, float)
 
 #undef CONVERTTO_SCALED_SIMD
 
+//-------------------------
+//
+// Fluid kernels: Threshold
+//
+//-------------------------
+
+template<typename T, typename Op>
+CV_ALWAYS_INLINE int threshold_simd_loop(const T in[], T out[], const int length, const Op& op)
+{
+    constexpr int nlanes = vector_type_of_t<T>::nlanes;
+
+    int x = 0;
+    for (;;)
+    {
+        for (; x <= length - nlanes; x += nlanes)
+        {
+            vx_store(&out[x], op(vx_load(&in[x])));
+        }
+        if (x < length)
+        {
+            x = length - nlanes;
+            continue;
+        }
+        break;
+    }
+    return x;
+}
+
+template<typename T>
+CV_ALWAYS_INLINE int threshold_simd_impl(const T in[], T out[], const int length,
+                                         const T thresh, const T threshd,
+                                         const T maxval, const int type)
+{
+    using vec_t = vector_type_of_t<T>;
+    if (length < vec_t::nlanes)
+        return 0;
+
+    const vec_t v_thresh  = vx_setall<T>(thresh);
+    const vec_t v_threshd = vx_setall<T>(threshd);
+    const vec_t v_maxval  = vx_setall<T>(maxval);
+    const vec_t v_zero    = vx_setall<T>(0);
+
+    switch (type)
+    {
+    case cv::THRESH_BINARY:
+        return threshold_simd_loop(in, out, length, [&](const vec_t& a)
+                                   { return v_select(a > v_thresh, v_maxval, v_zero); });
+    case cv::THRESH_BINARY_INV:
+        return threshold_simd_loop(in, out, length, [&](const vec_t& a)
+                                   { return v_select(a > v_thresh, v_zero, v_maxval); });
+    case cv::THRESH_TRUNC:
+        return threshold_simd_loop(in, out, length, [&](const vec_t& a)
+                                   { return v_select(a > v_thresh, v_threshd, a); });
+    case cv::THRESH_TOZERO:
+        return threshold_simd_loop(in, out, length, [&](const vec_t& a)
+                                   { return v_select(a > v_thresh, a, v_zero); });
+    case cv::THRESH_TOZERO_INV:
+        return threshold_simd_loop(in, out, length, [&](const vec_t& a)
+                                   { return v_select(a > v_thresh, v_zero, a); });
+    default:
+        return 0;  // the caller reports unsupported types
+    }
+}
+
+#define THRESHOLD_SIMD(T)                                                         \
+int threshold_simd(const T in[], T out[], const int length, const T thresh,       \
+                   const T threshd, const T maxval, const int type)               \
+{                                                                                 \
+    return threshold_simd_impl(in, out, length, thresh, threshd, maxval, type);   \
+}
+
+THRESHOLD_SIMD(uchar)
+THRESHOLD_SIMD(ushort)
+THRESHOLD_SIMD(short)
+THRESHOLD_SIMD(float)
+
+#undef THRESHOLD_SIMD
+
 #endif  // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
 CV_CPU_OPTIMIZATION_NAMESPACE_END
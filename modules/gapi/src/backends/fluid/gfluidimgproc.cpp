@@ -119,7 +119,7 @@ GAPI_FLUID_KERNEL(GFluidBGR2Gray, cv::gapi::imgproc::GBGR2Gray, false)
 //
 //--------------------------------------
 
-static void run_rgb2yuv(Buffer &dst, const View &src, const float coef[5])
+static void run_rgb2yuv(Buffer &dst, const View &src, const float coef[5], bool bgr = false)
 {
     GAPI_Assert(src.meta().depth == CV_8U);
     GAPI_Assert(dst.meta().depth == CV_8U);
@@ -132,10 +132,13 @@ static void run_rgb2yuv(Buffer &dst, const View &src, const float coef[5])
 
     int width = dst.length();
 
-    run_rgb2yuv_impl(out, in, width, coef);
+    if (bgr)
+        run_bgr2yuv_impl(out, in, width, coef);
+    else
+        run_rgb2yuv_impl(out, in, width, coef);
 }
 
-static void run_yuv2rgb(Buffer &dst, const View &src, const float coef[4])
+static void run_yuv2rgb(Buffer &dst, const View &src, const float coef[4], bool bgr = false)
 {
     GAPI_Assert(src.meta().depth == CV_8U);
     GAPI_Assert(dst.meta().depth == CV_8U);
@@ -148,7 +151,10 @@ static void run_yuv2rgb(Buffer &dst, const View &src, const float coef[4])
 
     int width = dst.length();
 
-    run_yuv2rgb_impl(out, in, width, coef);
+    if (bgr)
+        run_yuv2bgr_impl(out, in, width, coef);
+    else
+        run_yuv2rgb_impl(out, in, width, coef);
 }
 
 GAPI_FLUID_KERNEL(GFluidRGB2YUV, cv::gapi::imgproc::GRGB2YUV, false)
@@ -171,6 +177,51 @@ GAPI_FLUID_KERNEL(GFluidYUV2RGB, cv::gapi::imgproc::GYUV2RGB, false)
     }
 };
 
+GAPI_FLUID_KERNEL(GFluidBGR2YUV, cv::gapi::imgproc::GBGR2YUV, false)
+{
+    static const int Window = 1;
+
+    static void run(const View &src, Buffer &dst)
+    {
+        run_rgb2yuv(dst, src, coef_rgb2yuv_bt601, true);
+    }
+};
+
+GAPI_FLUID_KERNEL(GFluidYUV2BGR, cv::gapi::imgproc::GYUV2BGR, false)
+{
+    static const int Window = 1;
+
+    static void run(const View &src, Buffer &dst)
+    {
+        run_yuv2rgb(dst, src, coef_yuv2rgb_bt601, true);
+    }
+};
+
+//--------------------------------------
+//
+// Fluid kernels: BGR-to-RGB
+//
+//--------------------------------------
+
+GAPI_FLUID_KERNEL(GFluidBGR2RGB, cv::gapi::imgproc::GBGR2RGB, false)
+{
+    static const int Window = 1;
+
+    static void run(const View &src, Buffer &dst)
+    {
+        GAPI_Assert(src.meta().depth == CV_8U);
+        GAPI_Assert(dst.meta().depth == CV_8U);
+        GAPI_Assert(src.meta().chan == 3);
+        GAPI_Assert(dst.meta().chan == 3);
+        GAPI_Assert(src.length() == dst.length());
+
+        const auto *in  = src.InLine<uchar>(0);
+              auto *out = dst.OutLine<uchar>();
+
+        run_bgr2rgb_impl(out, in, dst.length());
+    }
+};
+
 //--------------------------------------
 //
 // Fluid kernels: RGB-to-Lab, BGR-to-LUV
@@ -2175,6 +2226,65 @@ CV_ALWAYS_INLINE void calcRowLinear(const cv::gapi::fluid::View& in,
     }
 }
 
+// Nearest neighbor takes the row floor(y * vRatio), it's inside of the window which the
+// mappers of Resize kind compute for the same ratio of the sizes. As in the linear case, the ratio
+// is computed from the sizes, so the result equals to cv::resize() if fx and fy give integer sizes.
+static void initScratchNearest(const cv::GMatDesc& in, const Size& outSz, cv::gapi::fluid::Buffer& scratch)
+{
+    cv::GMatDesc desc;
+    desc.chan = 1;
+    desc.depth = CV_8UC1;
+    desc.size = Size{static_cast<int>(outSz.width * sizeof(int)), 1};
+
+    cv::gapi::fluid::Buffer buffer(desc);
+    scratch = std::move(buffer);
+
+    // offsets of the source pixels in elements
+    int* mapsx = scratch.OutLine<int>();
+    double hRatio = ratio(in.size.width, outSz.width);
+    for (int x = 0; x < outSz.width; x++)
+        mapsx[x] = std::min(cvFloor(x * hRatio), in.size.width - 1) * in.chan;
+}
+
+template<typename T>
+static void calcRowNearest(const cv::gapi::fluid::View& in, cv::gapi::fluid::Buffer& out,
+                           cv::gapi::fluid::Buffer& scratch)
+{
+    const int* mapsx = scratch.OutLine<int>();
+    const int inH = in.meta().size.height;
+    const double vRatio = ratio(inH, out.meta().size.height);
+    const int chan = in.meta().chan;
+    const int length = out.length();
+    const int inY = in.y(), outY = out.y();
+
+    for (int l = 0; l < out.lpi(); l++)
+    {
+        int sy = std::min(cvFloor((outY + l) * vRatio), inH - 1);
+        const T* src = in.InLine<T>(sy - inY);
+        T* dst = out.OutLine<T>(l);
+
+        if (chan == 1)
+        {
+            for (int x = 0; x < length; x++)
+                dst[x] = src[mapsx[x]];
+        }
+        else if (chan == 3)
+        {
+            for (int x = 0; x < length; x++, dst += 3)
+            {
+                const T* p = src + mapsx[x];
+                dst[0] = p[0]; dst[1] = p[1]; dst[2] = p[2];
+            }
+        }
+        else
+        {
+            for (int x = 0; x < length; x++, dst += chan)
+                for (int c = 0; c < chan; c++)
+                    dst[c] = src[mapsx[x] + c];
+        }
+    }
+}
+
 GAPI_FLUID_KERNEL(GFluidResize, cv::gapi::imgproc::GResize, true)
 {
     static const int Window = 1;
@@ -2189,9 +2299,13 @@ GAPI_FLUID_KERNEL(GFluidResize, cv::gapi::imgproc::GResize, true)
                            cv::Size outSz, double fx, double fy, int interp,
                            cv::gapi::fluid::Buffer &scratch)
    {
-       GAPI_Assert((in.depth == CV_8U && in.chan == 3) ||
-                   (in.depth == CV_32F && in.chan == 1));
-       GAPI_Assert(interp == cv::INTER_LINEAR);
+       GAPI_Assert(interp == cv::INTER_LINEAR || interp == cv::INTER_NEAREST);
+       if (interp == cv::INTER_LINEAR)
+           GAPI_Assert((in.depth == CV_8U && in.chan == 3) ||
+                       (in.depth == CV_32F && in.chan == 1));
+       else
+           GAPI_Assert((in.depth == CV_8U || in.depth == CV_16U || in.depth == CV_16S ||
+                        in.depth == CV_32F) && in.chan <= 4);
 
        int outSz_w;
        int outSz_h;
@@ -2207,7 +2321,11 @@ GAPI_FLUID_KERNEL(GFluidResize, cv::gapi::imgproc::GResize, true)
        }
        cv::Size outSize(outSz_w, outSz_h);
 
-       if (in.depth == CV_8U && in.chan == 3)
+       if (interp == cv::INTER_NEAREST)
+       {
+           initScratchNearest(in, outSize, scratch);
+       }
+       else if (in.depth == CV_8U && in.chan == 3)
        {
            initScratchLinear<uchar, linear::Mapper, 3>(in, outSize, scratch, LPI);
        }
@@ -2228,13 +2346,26 @@ GAPI_FLUID_KERNEL(GFluidResize, cv::gapi::imgproc::GResize, true)
                     double /*fy*/, int interp, cv::gapi::fluid::Buffer& out,
                     cv::gapi::fluid::Buffer& scratch)
     {
-        GAPI_Assert((in.meta().depth == CV_8U && in.meta().chan == 3) ||
-                    (in.meta().depth == CV_32F && in.meta().chan == 1));
-        GAPI_Assert(interp == cv::INTER_LINEAR);
-
         const int channels = in.meta().chan;
         const int depth = in.meta().depth;
 
+        if (interp == cv::INTER_NEAREST)
+        {
+            switch (depth)
+            {
+            case CV_8U:  calcRowNearest<uchar>(in, out, scratch);  break;
+            case CV_16U:
+            case CV_16S: calcRowNearest<ushort>(in, out, scratch); break;
+            case CV_32F: calcRowNearest<float>(in, out, scratch);  break;
+            default: CV_Error(cv::Error::StsBadArg, "unsupported depth");
+            }
+            return;
+        }
+
+        GAPI_Assert((depth == CV_8U && channels == 3) ||
+                    (depth == CV_32F && channels == 1));
+        GAPI_Assert(interp == cv::INTER_LINEAR);
+
         if (depth == CV_8U && channels == 3)
         {
             calcRowLinearC<uint8_t, linear::Mapper, 3>(in, out, scratch);
@@ -2265,6 +2396,9 @@ cv::GKernelPackage cv::gapi::imgproc::fluid::kernels()
       , GFluidRGB2GrayCustom
       , GFluidRGB2YUV
       , GFluidYUV2RGB
+      , GFluidBGR2YUV
+      , GFluidYUV2BGR
+      , GFluidBGR2RGB
       , GFluidRGB2Lab
       , GFluidBGR2LUV
       , GFluidBlur
@@ -85,11 +85,32 @@ void run_yuv2rgb_impl(uchar out[], const uchar in[], int width, const float coef
     CV_CPU_DISPATCH(run_yuv2rgb_impl, (out, in, width, coef), CV_CPU_DISPATCH_MODES_ALL);
 }
 
+void run_bgr2yuv_impl(uchar out[], const uchar in[], int width, const float coef[5])
+{
+    CV_CPU_DISPATCH(run_bgr2yuv_impl, (out, in, width, coef), CV_CPU_DISPATCH_MODES_ALL);
+}
+
+void run_yuv2bgr_impl(uchar out[], const uchar in[], int width, const float coef[4])
+{
+    CV_CPU_DISPATCH(run_yuv2bgr_impl, (out, in, width, coef), CV_CPU_DISPATCH_MODES_ALL);
+}
+
 void run_rgb2yuv422_impl(uchar out[], const uchar in[], int width)
 {
     CV_CPU_DISPATCH(run_rgb2yuv422_impl, (out, in, width), CV_CPU_DISPATCH_MODES_ALL);
 }
 
+//--------------------------------------
+//
+// Fluid kernels: BGR-to-RGB
+//
+//--------------------------------------
+
+void run_bgr2rgb_impl(uchar out[], const uchar in[], int width)
+{
+    CV_CPU_DISPATCH(run_bgr2rgb_impl, (out, in, width), CV_CPU_DISPATCH_MODES_ALL);
+}
+
 //-------------------------
 //
 // Fluid kernels: sepFilter
@@ -52,8 +52,20 @@ void run_rgb2yuv_impl(uchar out[], const uchar in[], int width, const float coef
 
 void run_yuv2rgb_impl(uchar out[], const uchar in[], int width, const float coef[4]);
 
+void run_bgr2yuv_impl(uchar out[], const uchar in[], int width, const float coef[5]);
+
+void run_yuv2bgr_impl(uchar out[], const uchar in[], int width, const float coef[4]);
+
 void run_rgb2yuv422_impl(uchar out[], const uchar in[], int width);
 
+//--------------------------------------
+//
+// Fluid kernels: BGR-to-RGB
+//
+//--------------------------------------
+
+void run_bgr2rgb_impl(uchar out[], const uchar in[], int width);
+
 //-------------------------
 //
 // Fluid kernels: sepFilter
@@ -74,8 +74,20 @@ void run_rgb2yuv_impl(uchar out[], const uchar in[], int width, const float coef
 
 void run_yuv2rgb_impl(uchar out[], const uchar in[], int width, const float coef[4]);
 
+void run_bgr2yuv_impl(uchar out[], const uchar in[], int width, const float coef[5]);
+
+void run_yuv2bgr_impl(uchar out[], const uchar in[], int width, const float coef[4]);
+
 void run_rgb2yuv422_impl(uchar out[], const uchar in[], int width);
 
+//--------------------------------------
+//
+// Fluid kernels: BGR-to-RGB
+//
+//--------------------------------------
+
+void run_bgr2rgb_impl(uchar out[], const uchar in[], int width);
+
 //-------------------------
 //
 // Fluid kernels: sepFilter
@@ -739,7 +751,9 @@ void run_bayergr2rgb_gr_impl(uchar out[], const uchar **in, int width)
 //
 //--------------------------------------
 
-void run_rgb2yuv_impl(uchar out[], const uchar in[], int width, const float coef[5])
+// RGB and BGR orders differ by positions of R and B only, bidx is the index of B channel
+template<int bidx>
+CV_ALWAYS_INLINE void run_rgb2yuv_impl_(uchar out[], const uchar in[], int width, const float coef[5])
 {
     ushort c0 = static_cast<ushort>(coef[0]*(1 << 16) + 0.5f);  // Q0.0.16 un-signed
     ushort c1 = static_cast<ushort>(coef[1]*(1 << 16) + 0.5f);
@@ -754,7 +768,7 @@ void run_rgb2yuv_impl(uchar out[], const uchar in[], int width, const float coef
     for ( ; w <= width - nlanes; w += nlanes)
     {
         v_uint8 r, g, b;
-        v_load_deinterleave(&in[3*w], r, g, b);
+        v_load_deinterleave(&in[3*w], bidx ? r : b, g, bidx ? b : r);
 
         v_uint16 _r0, _r1, _g0, _g1, _b0, _b1;
         v_expand(r, _r0, _r1);
@@ -804,9 +818,9 @@ void run_rgb2yuv_impl(uchar out[], const uchar in[], int width, const float coef
 
     for ( ; w < width; w++)
     {
-        short r = in[3*w    ] << 7;                            // Q1.8.7 signed
+        short r = in[3*w + (bidx ^ 2)] << 7;                   // Q1.8.7 signed
         short g = in[3*w + 1] << 7;
-        short b = in[3*w + 2] << 7;
+        short b = in[3*w +  bidx     ] << 7;
         short y = (c0*r + c1*g + c2*b) >> 16;                  // Q1.8.7
         short u =  c3*(b - y) >> 16;                           // Q1.12.3
         short v =  c4*(r - y) >> 16;
@@ -816,7 +830,8 @@ void run_rgb2yuv_impl(uchar out[], const uchar in[], int width, const float coef
     }
 }
 
-void run_yuv2rgb_impl(uchar out[], const uchar in[], int width, const float coef[4])
+template<int bidx>
+CV_ALWAYS_INLINE void run_yuv2rgb_impl_(uchar out[], const uchar in[], int width, const float coef[4])
 {
     short c0 = static_cast<short>(coef[0] * (1 << 12) + 0.5f);  // Q1.3.12
     short c1 = static_cast<short>(coef[1] * (1 << 12) + 0.5f);
@@ -870,7 +885,7 @@ void run_yuv2rgb_impl(uchar out[], const uchar in[], int width, const float coef
         b = v_pack_u((b0 + vx_setall_s16(1 << 2)) >> 3,
                      (b1 + vx_setall_s16(1 << 2)) >> 3);
 
-        v_store_interleave(&out[3*w], r, g, b);
+        v_store_interleave(&out[3*w], bidx ? r : b, g, bidx ? b : r);
     }
 #endif
 
@@ -882,12 +897,32 @@ void run_yuv2rgb_impl(uchar out[], const uchar in[], int width, const float coef
         short r = y + (        c0*v  >> 16); // Q1.12.3
         short g = y + ((c1*u + c2*v) >> 16);
         short b = y + ((c3*u       ) >> 16);
-        out[3*w    ] = saturate<uchar>((r + (1 << 2)) >> 3);
-        out[3*w + 1] = saturate<uchar>((g + (1 << 2)) >> 3);
-        out[3*w + 2] = saturate<uchar>((b + (1 << 2)) >> 3);
+        out[3*w + (bidx ^ 2)] = saturate<uchar>((r + (1 << 2)) >> 3);
+        out[3*w + 1         ] = saturate<uchar>((g + (1 << 2)) >> 3);
+        out[3*w +  bidx     ] = saturate<uchar>((b + (1 << 2)) >> 3);
     }
 }
 
+void run_rgb2yuv_impl(uchar out[], const uchar in[], int width, const float coef[5])
+{
+    run_rgb2yuv_impl_<2>(out, in, width, coef);
+}
+
+void run_yuv2rgb_impl(uchar out[], const uchar in[], int width, const float coef[4])
+{
+    run_yuv2rgb_impl_<2>(out, in, width, coef);
+}
+
+void run_bgr2yuv_impl(uchar out[], const uchar in[], int width, const float coef[5])
+{
+    run_rgb2yuv_impl_<0>(out, in, width, coef);
+}
+
+void run_yuv2bgr_impl(uchar out[], const uchar in[], int width, const float coef[4])
+{
+    run_yuv2rgb_impl_<0>(out, in, width, coef);
+}
+
 // Y' = 0.299*R' + 0.587*G' + 0.114*B'
 // U' = (B' - Y')*0.492
 // V' = (R' - Y')*0.877
@@ -995,6 +1030,37 @@ void run_rgb2yuv422_impl(uchar out[], const uchar in[], int width)
     }
 }
 
+//--------------------------------------
+//
+// Fluid kernels: BGR-to-RGB
+//
+//--------------------------------------
+
+void run_bgr2rgb_impl(uchar out[], const uchar in[], int width)
+{
+    int w = 0;
+
+#if CV_SIMD
+    static const int nlanes = v_uint8::nlanes;
+    for ( ; w <= width - nlanes; w += nlanes)
+    {
+        v_uint8 b, g, r;
+        v_load_deinterleave(&in[3*w], b, g, r);
+        v_store_interleave(&out[3*w], r, g, b);
+    }
+#endif
+
+    for ( ; w < width; w++)
+    {
+        uchar b = in[3*w    ];
+        uchar g = in[3*w + 1];
+        uchar r = in[3*w + 2];
+        out[3*w    ] = r;
+        out[3*w + 1] = g;
+        out[3*w + 2] = b;
+    }
+}
+
 //-----------------------------
 //
 // Fluid kernels: sepFilter 3x3
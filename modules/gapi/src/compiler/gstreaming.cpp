@@ -95,6 +95,11 @@ bool cv::GStreamingCompiled::Priv::running() const
     return m_exec->running();
 }
 
+cv::gapi::streaming::latency_stats cv::GStreamingCompiled::Priv::latencyStats() const
+{
+    return m_exec->latencyStats();
+}
+
 // GStreamingCompiled public implementation ////////////////////////////////////
 cv::GStreamingCompiled::GStreamingCompiled()
     : m_priv(new Priv())
@@ -153,6 +158,11 @@ bool cv::GStreamingCompiled::running() const
     return m_priv->running();
 }
 
+cv::gapi::streaming::latency_stats cv::GStreamingCompiled::latencyStats() const
+{
+    return m_priv->latencyStats();
+}
+
 cv::GStreamingCompiled::operator bool() const
 {
     return !m_priv->isEmpty();
@@ -51,6 +51,7 @@ public:
     void stop();
 
     bool running() const;
+    cv::gapi::streaming::latency_stats latencyStats() const;
 
     void setOutInfo(const GTypesInfo& info) { m_out_info = std::move(info); }
     const GTypesInfo& outInfo() const { return m_out_info; }
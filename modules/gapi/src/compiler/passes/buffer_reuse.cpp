@@ -0,0 +1,178 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+
+#include "precomp.hpp"
+
+#include <algorithm> // max, find_if
+#include <unordered_set>
+
+#include "compiler/gmodel.hpp"
+#include "compiler/passes/buffer_reuse.hpp"
+
+bool cv::gimpl::passes::isInplaceOp(const std::string &op_name)
+{
+    static const std::unordered_set<std::string> inplace_ops =
+    {
+        "org.opencv.core.math.add",
+        "org.opencv.core.math.addC",
+        "org.opencv.core.math.sub",
+        "org.opencv.core.math.subC",
+        "org.opencv.core.math.subRC",
+        "org.opencv.core.math.mul",
+        "org.opencv.core.math.mulC",
+        "org.opencv.core.math.mulCOld",
+        "org.opencv.core.math.muls",
+        "org.opencv.core.math.div",
+        "org.opencv.core.math.divC",
+        "org.opencv.core.math.divRC",
+        "org.opencv.core.math.sqrt",
+        "org.opencv.core.pixelwise.bitwise_and",
+        "org.opencv.core.pixelwise.bitwise_andS",
+        "org.opencv.core.pixelwise.bitwise_or",
+        "org.opencv.core.pixelwise.bitwise_orS",
+        "org.opencv.core.pixelwise.bitwise_xor",
+        "org.opencv.core.pixelwise.bitwise_xorS",
+        "org.opencv.core.pixelwise.bitwise_not",
+        "org.opencv.core.matrixop.min",
+        "org.opencv.core.matrixop.max",
+        "org.opencv.core.matrixop.absdiff",
+        "org.opencv.core.matrixop.absdiffC",
+        "org.opencv.core.matrixop.addweighted",
+        "org.opencv.core.matrixop.threshold",
+        "org.opencv.core.matrixop.inrange",
+        // Per-pixel conversions between 3-channel formats
+        "org.opencv.imgproc.colorconvert.bgr2rgb",
+        "org.opencv.imgproc.colorconvert.rgb2yuv",
+        "org.opencv.imgproc.colorconvert.yuv2rgb",
+        "org.opencv.imgproc.colorconvert.bgr2yuv",
+        "org.opencv.imgproc.colorconvert.yuv2bgr",
+    };
+    return inplace_ops.count(op_name) != 0u;
+}
+
+cv::gimpl::BufferReuse
+cv::gimpl::passes::reuseBuffers(const ade::Graph                   &g,
+                                const std::vector<ade::NodeHandle> &ops,
+                                const InplaceKernelF               &is_inplace_kernel)
+{
+    using NodeMap = std::unordered_map<ade::NodeHandle, int, ade::HandleHasher<ade::Node>>;
+    GModel::ConstGraph gm(g);
+
+    NodeMap op_pos;
+    for (std::size_t i = 0; i < ops.size(); i++)
+    {
+        GAPI_Assert(gm.metadata(ops[i]).get<NodeType>().t == NodeType::OP);
+        op_pos[ops[i]] = static_cast<int>(i);
+    }
+
+    // Find the last use of every internal GMat object which is produced
+    // and consumed by the given operations only. Objects which go outside
+    // (e.g. to other Islands) are not touched.
+    NodeMap last_use;
+    for (const auto &op_nh : ops)
+    {
+        for (const auto &data_nh : op_nh->outNodes())
+        {
+            const auto &d = gm.metadata(data_nh).get<Data>();
+            if (   d.storage != Data::Storage::INTERNAL
+                || d.shape   != GShape::GMAT
+                || !util::holds_alternative<cv::GMatDesc>(d.meta))
+            {
+                continue;
+            }
+
+            int last = op_pos.at(op_nh);
+            bool is_local = true;
+            for (const auto &reader_nh : data_nh->outNodes())
+            {
+                auto it = op_pos.find(reader_nh);
+                if (it == op_pos.end())
+                {
+                    is_local = false;
+                    break;
+                }
+                last = std::max(last, it->second);
+            }
+            if (is_local)
+            {
+                last_use[data_nh] = last;
+            }
+        }
+    }
+
+    // Walk through the operations and assign buffers to their outputs.
+    // Buffers of objects which are not used after an operation are returned
+    // to the pool after all its outputs are assigned, so an operation never
+    // writes over its input unless it is in-place.
+    BufferReuse result;
+    NodeMap buffer_of_node;
+    std::vector<std::size_t> free_buffers;
+    for (const auto &op_nh : ops)
+    {
+        const int pos = op_pos.at(op_nh);
+
+        std::vector<std::size_t> released;
+        for (const auto &in_nh : op_nh->inNodes())
+        {
+            auto it = last_use.find(in_nh);
+            if (it != last_use.end() && it->second == pos)
+            {
+                // Note: the same object may be passed to multiple inputs
+                const auto b = static_cast<std::size_t>(buffer_of_node.at(in_nh));
+                if (std::find(released.begin(), released.end(), b) == released.end())
+                {
+                    released.push_back(b);
+                }
+            }
+        }
+
+        std::vector<std::size_t> unused;
+        const bool inplace = is_inplace_kernel
+                          && isInplaceOp(gm.metadata(op_nh).get<Op>().k.name)
+                          && is_inplace_kernel(op_nh);
+        for (const auto &out_nh : op_nh->outNodes())
+        {
+            auto it = last_use.find(out_nh);
+            if (it == last_use.end())
+            {
+                continue;
+            }
+            const auto &d    = gm.metadata(out_nh).get<Data>();
+            const auto &desc = util::get<cv::GMatDesc>(d.meta);
+            auto same_format = [&](std::size_t b) { return result.buffers[b] == desc; };
+
+            std::size_t b = 0u;
+            auto in_it   = inplace ? std::find_if(released.begin(), released.end(), same_format)
+                                   : released.end();
+            auto free_it = std::find_if(free_buffers.begin(), free_buffers.end(), same_format);
+            if (in_it != released.end())
+            {
+                b = *in_it;
+                released.erase(in_it);
+            }
+            else if (free_it != free_buffers.end())
+            {
+                b = *free_it;
+                free_buffers.erase(free_it);
+            }
+            else
+            {
+                b = result.buffers.size();
+                result.buffers.push_back(desc);
+            }
+            buffer_of_node[out_nh] = static_cast<int>(b);
+            result.buffer_of[d.rc] = b;
+
+            if (it->second == pos)
+            {
+                // Nobody reads this object
+                unused.push_back(b);
+            }
+        }
+        free_buffers.insert(free_buffers.end(), released.begin(), released.end());
+        free_buffers.insert(free_buffers.end(), unused.begin(), unused.end());
+    }
+    return result;
+}
@@ -0,0 +1,60 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+
+#ifndef OPENCV_GAPI_COMPILER_PASSES_BUFFER_REUSE_HPP
+#define OPENCV_GAPI_COMPILER_PASSES_BUFFER_REUSE_HPP
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ade/graph.hpp>
+
+#include <opencv2/gapi/gmat.hpp>
+
+namespace cv {
+namespace gimpl {
+
+// Result of the buffer reuse analysis (see reuseBuffers())
+struct BufferReuse
+{
+    // Buffer index for every internal GMat object (by its resource id).
+    // Objects with the same buffer never hold useful data at the same time.
+    std::unordered_map<int, std::size_t> buffer_of;
+
+    // Formats of the buffers
+    std::vector<cv::GMatDesc> buffers;
+};
+
+namespace passes {
+
+// Returns true if the operation can write its output over its input
+// (all elementwise operations and some colour conversions).
+// It doesn't mean that every kernel of the operation supports it.
+GAPI_EXPORTS bool isInplaceOp(const std::string &op_name);
+
+// Tells if the kernel of the given operation node supports in-place execution
+using InplaceKernelF = std::function<bool(const ade::NodeHandle &)>;
+
+// Liveness-based buffer assignment for the internal GMat objects of an
+// Island. Objects produced and consumed only by the given (topologically
+// sorted) operations share the buffers of the same format if their
+// lifetimes don't overlap. In-place operations (see isInplaceOp())
+// may also take the buffer of the input which is not used after this
+// operation, if the backend confirms it for their kernels by
+// is_inplace_kernel. In-place execution is disabled without it.
+//
+// Metadata of the objects must be known at this point, so it is
+// called by backends at Island compile/reshape time.
+GAPI_EXPORTS BufferReuse reuseBuffers(const ade::Graph                   &g,
+                                      const std::vector<ade::NodeHandle> &ops,
+                                      const InplaceKernelF               &is_inplace_kernel = {});
+
+} // namespace passes
+} // namespace gimpl
+} // namespace cv
+
+#endif // OPENCV_GAPI_COMPILER_PASSES_BUFFER_REUSE_HPP
@@ -11,6 +11,8 @@
 
 #include <ade/graph.hpp>
 
+#include <opencv2/gapi/gstreaming.hpp>
+
 #include "backends/common/gbackend.hpp"
 
 namespace cv {
@@ -41,6 +43,7 @@ public:
     virtual bool try_pull(cv::GRunArgsP &&outs) = 0;
     virtual void stop() = 0;
     virtual bool running() const = 0;
+    virtual cv::gapi::streaming::latency_stats latencyStats() const = 0;
 };
 
 } // namespace gimpl
@@ -76,11 +76,11 @@ struct DataQueue {
     static const char *name() { return "StreamingDataQueue"; }
     enum tag { DESYNC }; // Enum of 1 element: purely a syntax sugar
 
-    explicit DataQueue(std::size_t capacity) {
+    explicit DataQueue(std::size_t capacity, bool lock_free = false) {
         // Note: `ptr` is shared<SyncQueue>, while the `q` is a shared<Q>
         auto ptr = std::make_shared<cv::gimpl::stream::SyncQueue>();
         if (capacity != 0) {
-            ptr->set_capacity(capacity);
+            ptr->set_capacity(capacity, lock_free);
         }
         q = std::move(ptr);
     }
@@ -548,9 +548,12 @@ QueueReader::V QueueReader::getResultsVector(std::vector<Q*>        &in_queues,
 // - Check input queue (the only one) for a control command
 // - Depending on the state, obtains next data object and pushes it to the
 //   pipeline.
+// - In the latency-bounded mode, drops the data object if the pipeline
+//   is full (there's no frame budget left).
 void emitterActorThread(std::shared_ptr<cv::gimpl::GIslandEmitter> emitter,
                         Q& in_queue,
                         std::vector<Q*> out_queues,
+                        std::shared_ptr<FrameBudget> budget,
                         std::function<void()> cb_completion)
 {
     // Wait for the explicit Start command.
@@ -605,6 +608,12 @@ void emitterActorThread(std::shared_ptr<cv::gimpl::GIslandEmitter> emitter,
            continue;
        }
 
+        if (result && budget && !budget->acquire())
+        {
+            // The pipeline is full - drop this frame and take the next one
+            continue;
+        }
+
         if (result)
         {
             GAPI_ITT_AUTO_TRACE_GUARD(emitter_push_hndl);
@@ -1210,6 +1219,7 @@ class cv::gimpl::GStreamingExecutor::Synchronizer final {
     ade::Graph& m_island_graph;
     cv::gimpl::GIslandModel::Graph m_gim;
     std::size_t m_queue_capacity = 0u;
+    bool m_lock_free_queues = false;
     std::thread m_thread;
 
     std::vector<ade::NodeHandle> m_synchronized_emitters;
@@ -1217,17 +1227,19 @@ class cv::gimpl::GStreamingExecutor::Synchronizer final {
 
     std::vector<stream::Q*> newSyncQueue() {
         m_sync_queues.emplace_back(SyncQueue{});
-        m_sync_queues.back().set_capacity(m_queue_capacity);
+        m_sync_queues.back().set_capacity(m_queue_capacity, m_lock_free_queues);
         return std::vector<Q*>{&m_sync_queues.back()};
     }
 public:
     Synchronizer(gapi::streaming::sync_policy sync_policy,
                  ade::Graph& island_graph,
-                 std::size_t queue_capacity)
+                 std::size_t queue_capacity,
+                 bool lock_free_queues)
         : m_sync_policy(sync_policy)
         , m_island_graph(island_graph)
         , m_gim(m_island_graph)
-        , m_queue_capacity(queue_capacity) {
+        , m_queue_capacity(queue_capacity)
+        , m_lock_free_queues(lock_free_queues) {
     }
 
     void registerVideoEmitters(std::vector<ade::NodeHandle>&& emitters) {
@@ -1320,7 +1332,27 @@ cv::gimpl::GStreamingExecutor::GStreamingExecutor(std::unique_ptr<ade::Graph> &&
 
     auto sync_policy = cv::gimpl::getCompileArg<cv::gapi::streaming::sync_policy>(m_comp_args)
                        .value_or(cv::gapi::streaming::sync_policy::dont_sync);
-    m_sync.reset(new Synchronizer(sync_policy, *m_island_graph, queue_capacity));
+    const bool lock_free_queues =
+        cv::gimpl::getCompileArg<cv::gapi::streaming::queue_kind>(m_comp_args)
+        .value_or(cv::gapi::streaming::queue_kind::blocking) == cv::gapi::streaming::queue_kind::lock_free;
+    m_sync.reset(new Synchronizer(sync_policy, *m_island_graph, queue_capacity, lock_free_queues));
+
+    if (auto latency = cv::gapi::getCompileArg<cv::gapi::streaming::latency_bound>(m_comp_args))
+    {
+        if (latency->max_in_flight == 0u)
+        {
+            util::throw_error(std::logic_error("latency_bound must allow "
+                                               "at least one frame in flight"));
+        }
+        if (sync_policy == cv::gapi::streaming::sync_policy::drop)
+        {
+            // Frames dropped by the synchronizer never reach the output
+            // so their budget would never be released
+            util::throw_error(std::logic_error("latency_bound can't be used "
+                                               "with sync_policy::drop"));
+        }
+        m_max_in_flight = util::make_optional(latency->max_in_flight);
+    }
 
     // If metadata was not passed to compileStreaming, Islands are not compiled at this point.
     // It is fine -- Islands are then compiled in setSource (at the first valid call).
@@ -1409,7 +1441,7 @@ cv::gimpl::GStreamingExecutor::GStreamingExecutor(std::unique_ptr<ade::Graph> &&
                             // Limit queue size to 1 in this case
                             qgr.metadata(eh).set(DataQueue(1u));
                         } else {
-                            qgr.metadata(eh).set(DataQueue(queue_capacity));
+                            qgr.metadata(eh).set(DataQueue(queue_capacity, lock_free_queues));
                         }
                         m_internal_queues.insert(qgr.metadata(eh).get<DataQueue>().q.get());
                     }
@@ -1467,7 +1499,7 @@ cv::gimpl::GStreamingExecutor::GStreamingExecutor(std::unique_ptr<ade::Graph> &&
                 // Also initialize Sink's input queue
                 ade::TypedGraph<DataQueue> qgr(*m_island_graph);
                 GAPI_Assert(nh->inEdges().size() == 1u);
-                qgr.metadata(nh->inEdges().front()).set(DataQueue(queue_capacity));
+                qgr.metadata(nh->inEdges().front()).set(DataQueue(queue_capacity, lock_free_queues));
                 m_sink_queues[sink_idx] = qgr.metadata(nh->inEdges().front()).get<DataQueue>().q.get();
 
                 // Assign a desync tag
@@ -1499,7 +1531,7 @@ cv::gimpl::GStreamingExecutor::GStreamingExecutor(std::unique_ptr<ade::Graph> &&
     // of desync parts (they can generate output individually
     // per the same input frame, so the output traffic multiplies)
     GAPI_Assert(m_collector_map.size() > 0u);
-    m_out_queue.set_capacity(queue_capacity * m_collector_map.size());
+    m_out_queue.set_capacity(queue_capacity * m_collector_map.size(), lock_free_queues);
 
     // FIXME: The code duplicates logic of collectGraphInfo()
     cv::gimpl::GModel::ConstGraph cgr(*m_orig_graph);
@@ -1596,6 +1628,7 @@ void cv::gimpl::GStreamingExecutor::setSource(GRunArgs &&ins)
     // There's a 1:1 mapping between emitters and corresponding data inputs.
     // Also collect video emitter nodes to use them later in synchronization
     std::vector<ade::NodeHandle> video_emitters;
+    std::vector<std::shared_ptr<FrameBudget>> budgets(m_emitters.size());
     for (auto it : ade::util::zip(ade::util::toRange(m_emitters),
                                   ade::util::toRange(ins),
                                   ade::util::iota(m_emitters.size())))
@@ -1616,6 +1649,9 @@ void cv::gimpl::GStreamingExecutor::setSource(GRunArgs &&ins)
             // Currently all video inputs are synchronized if sync policy is to drop,
             // there is no different fps branches etc, so all video emitters are registered
             video_emitters.emplace_back(emit_nh);
+            if (m_max_in_flight.has_value()) {
+                budgets[emit_idx] = std::make_shared<FrameBudget>(m_max_in_flight.value());
+            }
 #else
             util::throw_error(std::logic_error("Video is not supported in the "
                                                "standalone mode"));
@@ -1657,6 +1693,7 @@ void cv::gimpl::GStreamingExecutor::setSource(GRunArgs &&ins)
     {
         stop();
     }
+    m_budgets = std::move(budgets);
 
     for (auto it : ade::util::indexed(m_emitters))
     {
@@ -1673,6 +1710,7 @@ void cv::gimpl::GStreamingExecutor::setSource(GRunArgs &&ins)
                                emitter,
                                std::ref(m_emitter_queues[id]),
                                out_queues,
+                               m_budgets[id],
                                real_video_completion_cb);
     }
 
@@ -1811,11 +1849,13 @@ bool cv::gimpl::GStreamingExecutor::pull(cv::GRunArgsP &&outs)
             return false;
         case Cmd::index_of<Result>(): {
             GAPI_Assert(cv::util::holds_alternative<Result>(cmd));
+            release_budgets(cmd);
             cv::GRunArgs &this_result = cv::util::get<Result>(cmd).args;
             sync_data(this_result, outs);
             return true;
         }
         case Cmd::index_of<Exception>(): {
+            release_budgets(cmd);
             std::rethrow_exception(cv::util::get<Exception>(cmd).eptr);
             return true;
         }
@@ -1845,10 +1885,12 @@ bool cv::gimpl::GStreamingExecutor::pull(cv::GOptRunArgsP &&outs)
             wait_shutdown();
             return false;
         case Cmd::index_of<Result>(): {
+            release_budgets(cmd);
             sync_data(cv::util::get<Result>(cmd), outs);
             return true;
         }
         case Cmd::index_of<Exception>(): {
+            release_budgets(cmd);
             std::rethrow_exception(cv::util::get<Exception>(cmd).eptr);
             return true;
         }
@@ -1900,6 +1942,7 @@ bool cv::gimpl::GStreamingExecutor::try_pull(cv::GRunArgsP &&outs)
     }
 
     GAPI_Assert(cv::util::holds_alternative<Result>(cmd));
+    release_budgets(cmd);
     cv::GRunArgs &this_result = cv::util::get<Result>(cmd).args;
     sync_data(this_result, outs);
     return true;
@@ -1933,3 +1976,49 @@ bool cv::gimpl::GStreamingExecutor::running() const
 {
     return (state == State::RUNNING);
 }
+
+void cv::gimpl::GStreamingExecutor::release_budgets(const Cmd &cmd)
+{
+    if (!m_max_in_flight.has_value())
+        return;
+
+    // A frame leaves the pipeline when its main path result is pulled.
+    // If there's no main path, any (desynchronized) result releases it.
+    if (cv::util::holds_alternative<Result>(cmd))
+    {
+        const auto &flags = cv::util::get<Result>(cmd).flags;
+        const bool has_main_path = m_sink_sync.end() !=
+            std::find(m_sink_sync.begin(), m_sink_sync.end(), -1);
+        bool is_main_path_result = !has_main_path;
+        for (std::size_t i = 0; i < flags.size() && !is_main_path_result; i++)
+        {
+            is_main_path_result = flags[i] && m_sink_sync[i] == -1;
+        }
+        if (!is_main_path_result)
+            return;
+    }
+
+    for (auto &&b : m_budgets)
+    {
+        if (b) b->release();
+    }
+}
+
+cv::gapi::streaming::latency_stats cv::gimpl::GStreamingExecutor::latencyStats() const
+{
+    cv::gapi::streaming::latency_stats stats;
+    if (!m_max_in_flight.has_value())
+        return stats;
+
+    stats.emitted.resize(m_budgets.size(), 0u);
+    stats.dropped.resize(m_budgets.size(), 0u);
+    for (std::size_t i = 0; i < m_budgets.size(); i++)
+    {
+        if (m_budgets[i])
+        {
+            stats.emitted[i] = m_budgets[i]->emitted();
+            stats.dropped[i] = m_budgets[i]->dropped();
+        }
+    }
+    return stats;
+}
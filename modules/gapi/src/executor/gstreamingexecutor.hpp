@@ -12,6 +12,7 @@
                                 // on concurrent_bounded_queue
 #endif
 
+#include <atomic> // atomic
 #include <thread> // thread
 #include <vector>
 #include <unordered_map>
@@ -24,6 +25,7 @@ template<typename T> using QueueClass = tbb::concurrent_bounded_queue<T>;
 template<typename T> using QueueClass = cv::gapi::own::concurrent_bounded_queue<T>;
 #endif // TBB
 #include "executor/last_value.hpp"
+#include "executor/lockfree_queue.hpp"
 
 #include "executor/gabstractstreamingexecutor.hpp"
 
@@ -70,16 +72,24 @@ public:
 };
 
 // A regular queue implementation
+// Bounded queues can be lock-free (see cv::gapi::streaming::queue_kind),
+// the unbounded ones are always blocking
 class SyncQueue final: public Q {
     QueueClass<Cmd> m_q;    // FIXME: OWN or WRAP??
+    cv::gapi::own::lockfree_bounded_queue<Cmd> m_lf_q;
+    bool m_lock_free = false;
 
 public:
-    virtual void push(const Cmd &cmd) override { m_q.push(cmd); }
-    virtual void pop(Cmd &cmd)        override { m_q.pop(cmd);  }
-    virtual bool try_pop(Cmd &cmd)    override { return m_q.try_pop(cmd); }
-    virtual void clear()              override { m_q.clear(); }
-
-    void set_capacity(std::size_t c) { m_q.set_capacity(c);}
+    virtual void push(const Cmd &cmd) override { if (m_lock_free) m_lf_q.push(cmd); else m_q.push(cmd); }
+    virtual void pop(Cmd &cmd)        override { if (m_lock_free) m_lf_q.pop(cmd);  else m_q.pop(cmd);  }
+    virtual bool try_pop(Cmd &cmd)    override { return m_lock_free ? m_lf_q.try_pop(cmd) : m_q.try_pop(cmd); }
+    virtual void clear()              override { if (m_lock_free) m_lf_q.clear(); else m_q.clear(); }
+
+    void set_capacity(std::size_t c, bool lock_free = false) {
+        if (lock_free) m_lf_q.set_capacity(c);
+        else           m_q.set_capacity(c);
+        m_lock_free = lock_free;
+    }
 };
 
 // Desynchronized "queue" implementation
@@ -96,6 +106,45 @@ public:
     virtual void clear()              override { m_v.clear(); }
 };
 
+// Frames budget of a video source in the latency-bounded mode
+// (see cv::gapi::streaming::latency_bound). The emitter acquires the
+// budget for every frame it pushes to the pipeline and drops the frame
+// if there's no budget left. The budget is released when the frame's
+// result is pulled from the pipeline.
+class FrameBudget {
+    const std::size_t m_max_in_flight;
+    std::atomic<std::size_t> m_in_flight;
+    std::atomic<std::size_t> m_emitted;
+    std::atomic<std::size_t> m_dropped;
+
+public:
+    explicit FrameBudget(std::size_t max_in_flight)
+        : m_max_in_flight(max_in_flight), m_in_flight(0u), m_emitted(0u), m_dropped(0u) {
+    }
+
+    // Called by the emitter thread only, returns false if the frame must be dropped
+    bool acquire() {
+        if (m_in_flight.load() >= m_max_in_flight) {
+            ++m_dropped;
+            return false;
+        }
+        ++m_in_flight;
+        ++m_emitted;
+        return true;
+    }
+
+    void release() {
+        // NB: Errors thrown by the source itself reach the output too,
+        // but they don't hold a budget - don't go below zero
+        std::size_t n = m_in_flight.load();
+        while (n != 0u && !m_in_flight.compare_exchange_weak(n, n - 1u)) {
+        }
+    }
+
+    std::size_t emitted() const { return m_emitted.load(); }
+    std::size_t dropped() const { return m_dropped.load(); }
+};
+
 } // namespace stream
 
 // FIXME: Currently all GExecutor comments apply also
@@ -170,6 +219,11 @@ protected:
 
     std::vector<stream::Q*>          m_sink_queues;
 
+    // Latency-bounded mode: frame budgets of video sources,
+    // indexed as the graph inputs (null for the constant ones)
+    util::optional<std::size_t>                      m_max_in_flight;
+    std::vector<std::shared_ptr<stream::FrameBudget>> m_budgets;
+
     // desync path tags for outputs. -1 means that output
     // doesn't belong to a desync path
     std::vector<int>                 m_sink_sync;
@@ -186,6 +240,7 @@ protected:
 
 
     void wait_shutdown();
+    void release_budgets(const stream::Cmd &cmd);
 
     cv::GTypesInfo out_info;
 
@@ -201,6 +256,7 @@ public:
     bool try_pull(cv::GRunArgsP &&outs) override;
     void stop() override;
     bool running() const override;
+    cv::gapi::streaming::latency_stats latencyStats() const override;
 };
 
 } // namespace gimpl
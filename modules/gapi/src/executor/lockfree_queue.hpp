@@ -0,0 +1,230 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_GAPI_EXECUTOR_LOCKFREE_QUEUE_HPP
+#define OPENCV_GAPI_EXECUTOR_LOCKFREE_QUEUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include <opencv2/gapi/own/assert.hpp>
+
+namespace cv {
+namespace gapi {
+namespace own {
+
+// This class implements the same interface as concurrent_bounded_queue
+// (see conc_queue.hpp) with a bounded ring buffer which allows multiple
+// producers and multiple consumers to push and pop without locks.
+//
+// Every cell of the ring has a sequence number which tells whether the
+// cell is ready to be written or read at the current position, so
+// producers and consumers only compete on their own position counters.
+//
+// Blocking operations spin for a while and then park the thread on a
+// condition variable. The mutex is touched only if somebody is parked.
+//
+// The capacity must be specified before use.
+template<class T>
+class lockfree_bounded_queue {
+    struct Cell {
+        std::atomic<std::size_t> seq;
+        T data;
+    };
+
+    // Number of attempts before the waiting thread is put to sleep
+    enum { SPIN_COUNT = 256 };
+
+    std::unique_ptr<Cell[]> m_cells;
+    std::size_t m_capacity;
+
+    std::atomic<std::size_t> m_push_pos;
+    char m_pad[64]; // keeps producers' and consumers' positions in different cache lines
+    std::atomic<std::size_t> m_pop_pos;
+
+    std::atomic<int> m_push_waiters;
+    std::atomic<int> m_pop_waiters;
+    std::mutex m_mutex;
+    std::condition_variable m_cond_empty;
+    std::condition_variable m_cond_full;
+
+    bool unsafe_try_push(const T &t);
+    bool unsafe_try_pop(T &t);
+
+    template<typename F>
+    void wait(std::atomic<int> &waiters, std::condition_variable &cond, F &&try_op);
+    void wake(std::atomic<int> &waiters, std::condition_variable &cond);
+
+public:
+    lockfree_bounded_queue()
+        : m_capacity(0u), m_push_pos(0u), m_pop_pos(0u)
+        , m_push_waiters(0), m_pop_waiters(0) {}
+    lockfree_bounded_queue(const lockfree_bounded_queue<T> &cc)
+        : lockfree_bounded_queue() {
+        // Not thread-safe - as the copy of concurrent_bounded_queue
+        if (cc.m_capacity) {
+            set_capacity(cc.m_capacity);
+            for (std::size_t pos = cc.m_pop_pos; pos != cc.m_push_pos; ++pos) {
+                unsafe_try_push(cc.m_cells[pos % cc.m_capacity].data);
+            }
+        }
+    }
+    lockfree_bounded_queue(lockfree_bounded_queue<T> &&cc)
+        : m_cells(std::move(cc.m_cells)), m_capacity(cc.m_capacity)
+        , m_push_pos(cc.m_push_pos.load()), m_pop_pos(cc.m_pop_pos.load())
+        , m_push_waiters(0), m_pop_waiters(0) {
+        // Not thread-safe - as the move of concurrent_bounded_queue
+        cc.m_capacity = 0u;
+        cc.m_push_pos = 0u;
+        cc.m_pop_pos  = 0u;
+    }
+
+    void push(const T &t);
+    void pop(T &t);
+    bool try_pop(T &t);
+
+    void set_capacity(std::size_t capacity);
+
+    // Not thread-safe - as in TBB
+    void clear();
+};
+
+// Internal: occupy the cell at the current push position, fails if the queue is full
+template<typename T>
+bool lockfree_bounded_queue<T>::unsafe_try_push(const T &t) {
+    GAPI_Assert(m_capacity != 0u && "Capacity must be specified");
+    std::size_t pos = m_push_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell &cell = m_cells[pos % m_capacity];
+        const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            if (m_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.data = t;
+                cell.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // the cell still holds the value pushed one lap ago
+            return false;
+        } else {
+            pos = m_push_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Internal: take the cell at the current pop position, fails if the queue is empty
+template<typename T>
+bool lockfree_bounded_queue<T>::unsafe_try_pop(T &t) {
+    GAPI_Assert(m_capacity != 0u && "Capacity must be specified");
+    std::size_t pos = m_pop_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell &cell = m_cells[pos % m_capacity];
+        const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (m_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                t = std::move(cell.data);
+                cell.data = T{}; // don't hold the resources of the popped value
+                cell.seq.store(pos + m_capacity, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // nothing has been pushed to the cell yet
+            return false;
+        } else {
+            pos = m_pop_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Internal: spin until the operation succeeds, then park the thread
+template<typename T>
+template<typename F>
+void lockfree_bounded_queue<T>::wait(std::atomic<int> &waiters,
+                                     std::condition_variable &cond,
+                                     F &&try_op) {
+    for (int i = 0; i < SPIN_COUNT; i++) {
+        if (try_op()) return;
+        std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // The other side checks the counter after its operation, so either
+    // it sees this waiter or the next attempt sees the operation
+    waiters.fetch_add(1);
+    while (!try_op()) {
+        cond.wait(lock);
+    }
+    waiters.fetch_sub(1);
+}
+
+// Internal: wake up threads parked on the other side, if any
+template<typename T>
+void lockfree_bounded_queue<T>::wake(std::atomic<int> &waiters,
+                                     std::condition_variable &cond) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) > 0) {
+        // Taking the lock guarantees the waiter is either before its
+        // last attempt or already sleeping on the condition variable
+        { std::lock_guard<std::mutex> lock(m_mutex); }
+        cond.notify_all();
+    }
+}
+
+// Push an element to the queue. Blocking if there's no space left
+template<typename T>
+void lockfree_bounded_queue<T>::push(const T &t) {
+    wait(m_push_waiters, m_cond_full, [&](){ return unsafe_try_push(t); });
+    wake(m_pop_waiters, m_cond_empty);
+}
+
+// Pop an element from the queue. Blocking if there's no items
+template<typename T>
+void lockfree_bounded_queue<T>::pop(T &t) {
+    wait(m_pop_waiters, m_cond_empty, [&](){ return unsafe_try_pop(t); });
+    wake(m_push_waiters, m_cond_full);
+}
+
+// Try pop an element from the queue. Returns false if queue is empty
+template<typename T>
+bool lockfree_bounded_queue<T>::try_pop(T &t) {
+    if (!unsafe_try_pop(t)) {
+        return false;
+    }
+    wake(m_push_waiters, m_cond_full);
+    return true;
+}
+
+// Specify the upper limit to the queue. Must be called after
+// queue construction but before any real use, any other case is UB
+template<typename T>
+void lockfree_bounded_queue<T>::set_capacity(std::size_t capacity) {
+    GAPI_Assert(m_capacity == 0u);
+    GAPI_Assert(capacity != 0u);
+    m_cells.reset(new Cell[capacity]);
+    for (std::size_t i = 0; i < capacity; i++) {
+        m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    m_capacity = capacity;
+}
+
+// Clear the queue. Similar to the TBB version, this method is not
+// thread-safe.
+template<typename T>
+void lockfree_bounded_queue<T>::clear() {
+    for (std::size_t i = 0; i < m_capacity; i++) {
+        m_cells[i].seq.store(i, std::memory_order_relaxed);
+        m_cells[i].data = T{};
+    }
+    m_push_pos = 0u;
+    m_pop_pos  = 0u;
+}
+
+}}} // namespace cv::gapi::own
+
+#endif //  OPENCV_GAPI_EXECUTOR_LOCKFREE_QUEUE_HPP
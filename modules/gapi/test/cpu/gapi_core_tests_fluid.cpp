@@ -271,7 +271,7 @@ INSTANTIATE_TEST_CASE_P(SqrtFluid, SqrtTest,
                                 Values(CORE_FLUID)));
 
 INSTANTIATE_TEST_CASE_P(ThresholdTestFluid, ThresholdTest,
-                        Combine(Values(CV_8UC3, CV_8UC1, CV_16UC1, CV_16SC1),
+                        Combine(Values(CV_8UC3, CV_8UC1, CV_16UC1, CV_16SC1, CV_32FC1),
                                 ValuesIn(in_sizes),
                                 Values(-1),
                                 Values(CORE_FLUID),
@@ -38,6 +38,29 @@ INSTANTIATE_TEST_CASE_P(ResizeTestFxFyFluid, ResizeTestFxFy,
                                 Values(0.5, 1, 2),
                                 Values(0.5, 1, 2)));
 
+INSTANTIATE_TEST_CASE_P(ResizeNearestTestFluid, ResizeTest,
+                        Combine(Values(CV_8UC1, CV_8UC3, CV_16UC1, CV_16SC1, CV_32FC1),
+                                Values(cv::Size(1280, 720),
+                                       cv::Size(30, 30)),
+                                Values(-1),
+                                Values(IMGPROC_FLUID),
+                                Values(AbsExact().to_compare_obj()),
+                                Values(cv::INTER_NEAREST),
+                                Values(cv::Size(1280, 720),
+                                       cv::Size(640, 480),
+                                       cv::Size(30, 30))));
+
+INSTANTIATE_TEST_CASE_P(ResizeNearestTestFxFyFluid, ResizeTestFxFy,
+                        Combine(Values(CV_8UC1, CV_8UC3, CV_32FC1),
+                                Values(cv::Size(1280, 720),
+                                       cv::Size(30, 30)),
+                                Values(-1),
+                                Values(IMGPROC_FLUID),
+                                Values(AbsExact().to_compare_obj()),
+                                Values(cv::INTER_NEAREST),
+                                Values(0.5, 1, 2),
+                                Values(0.5, 1, 2)));
+
 INSTANTIATE_TEST_CASE_P(RGB2GrayTestFluid, RGB2GrayTest,
                         Combine(Values(CV_8UC3),
                                 Values(cv::Size(1280, 720)),
@@ -66,6 +89,28 @@ INSTANTIATE_TEST_CASE_P(YUV2RGBTestFluid, YUV2RGBTest,
                                 Values(IMGPROC_FLUID),
                                 Values(ToleranceColor(1e-3).to_compare_obj())));
 
+INSTANTIATE_TEST_CASE_P(BGR2YUVTestFluid, BGR2YUVTest,
+                        Combine(Values(CV_8UC3),
+                                Values(cv::Size(1280, 720)),
+                                Values(CV_8UC3),
+                                Values(IMGPROC_FLUID),
+                                Values(ToleranceColor(1e-3).to_compare_obj())));
+
+INSTANTIATE_TEST_CASE_P(YUV2BGRTestFluid, YUV2BGRTest,
+                        Combine(Values(CV_8UC3),
+                                Values(cv::Size(1280, 720)),
+                                Values(CV_8UC3),
+                                Values(IMGPROC_FLUID),
+                                Values(ToleranceColor(1e-3).to_compare_obj())));
+
+INSTANTIATE_TEST_CASE_P(BGR2RGBTestFluid, BGR2RGBTest,
+                        Combine(Values(CV_8UC3),
+                                Values(cv::Size(1280, 720),
+                                       cv::Size(30, 30)),
+                                Values(CV_8UC3),
+                                Values(IMGPROC_FLUID),
+                                Values(AbsExact().to_compare_obj())));
+
 INSTANTIATE_TEST_CASE_P(RGB2LabTestFluid, RGB2LabTest,
                         Combine(Values(CV_8UC3),
                                 Values(cv::Size(1280, 720)),
@@ -286,6 +286,84 @@ INSTANTIATE_TEST_CASE_P(FluidTiledParallel8x10, TiledComputation,
                             tilesets_8x10(),
                             Values(serial_for, cv_parallel_for))
 );
+
+namespace {
+    cv::GFluidParallelBands parallelBands(int num_bands, int min_band_height){
+        cv::GFluidParallelBands bands;
+        bands.num_bands       = num_bands;
+        bands.min_band_height = min_band_height;
+        return bands;
+    }
+}
+
+struct BandedComputation : public TestWithParam <std::tuple<ComputationPair*, cv::Size, int>> {};
+TEST_P(BandedComputation, Test)
+{
+    ComputationPair*        cp;
+    cv::Size                img_sz;
+    int                     num_bands = 0;
+    auto                    mat_type  =  CV_8UC1;
+
+    std::tie(cp, img_sz, num_bands) = GetParam();
+
+    cv::Mat in_mat       =      randomMat(img_sz, mat_type);
+    cv::Mat out_mat_gapi = cv::Mat::zeros(img_sz, mat_type);
+    cv::Mat out_mat_ocv  = cv::Mat::zeros(img_sz, mat_type);
+
+    cp->run_with_gapi(in_mat, cv::compile_args(parallelBands(num_bands, 2)), out_mat_gapi);
+    cp->run_with_ocv (in_mat, {cv::Rect{}}, out_mat_ocv);
+
+    EXPECT_EQ(0, cvtest::norm(out_mat_gapi, out_mat_ocv, NORM_INF));
+}
+
+INSTANTIATE_TEST_CASE_P(FluidParallelBands, BandedComputation,
+                        Combine(
+                            single_arg_computations(),
+                            Values(cv::Size(8, 10), cv::Size(20, 15), cv::Size(320, 240)),
+                            Values(0, 1, 3, 4))
+);
+
+TEST(FluidParallelBands, SplitAndReshape)
+{
+    auto mat_type = CV_8UC1;
+
+    cv::GMat in;
+    cv::GMat out = TBlur3x3::on(in, BORDER_REPLICATE, {});
+    cv::GComputation c(cv::GIn(in), cv::GOut(out));
+
+    std::size_t items_count = 0;
+    auto pfor = [&items_count](std::size_t count, std::function<void(std::size_t)> f){
+        items_count = count;
+        for (std::size_t i = 0; i < count; ++i){
+            f(i);
+        }
+    };
+    auto args = cv::compile_args(fluidTestPackage, parallelBands(4, 2), GFluidParallelFor{pfor});
+
+    for (auto img_sz : {cv::Size{8, 40}, cv::Size{8, 5}, cv::Size{16, 64}})
+    {
+        cv::Mat in_mat = randomMat(img_sz, mat_type);
+        cv::Mat out_mat_gapi, out_mat_ocv;
+
+        // The second and the third runs reshape the compiled graph
+        c.apply(cv::gin(in_mat), cv::gout(out_mat_gapi), cv::GCompileArgs(args));
+        cv::blur(in_mat, out_mat_ocv, {3, 3}, {-1, -1}, BORDER_REPLICATE);
+
+        EXPECT_EQ(img_sz.height / 2 < 4 ? 2u : 4u, items_count);
+        EXPECT_EQ(0, cvtest::norm(out_mat_gapi, out_mat_ocv, NORM_INF));
+    }
+}
+
+TEST(FluidParallelBands, CantBeCombinedWithRois)
+{
+    cv::GMat in;
+    cv::GMat out = TAddCSimple::on(in, 1);
+    cv::GComputation c(cv::GIn(in), cv::GOut(out));
+
+    cv::Mat in_mat = randomMat(cv::Size{8, 20});
+    auto rois = cv::GFluidOutputRois{{cv::Rect{0, 0, 8, 10}}};
+    EXPECT_ANY_THROW(c.compile(cv::descr_of(in_mat), cv::compile_args(fluidTestPackage, rois, parallelBands(2, 2))));
+}
 } // namespace opencv_test
 
 //define custom printer for "parallel_for" test parameter
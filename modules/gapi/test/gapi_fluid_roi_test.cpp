@@ -194,4 +194,48 @@ INSTANTIATE_TEST_CASE_P(FluidRoi, TwoBlursRoiTest,
                                 testing::Bool(), // Read from input directly or place a copy node at start
                                 Values(cv::Rect{0,0,320,240}, cv::Rect{0,64,320,128}, cv::Rect{0,128,320,112})));
 
+// Widths around the vector lengths check both the scalar loop and the overlapped SIMD tail
+struct ThresholdFloatRoiTest : public TestWithParam <std::tuple<int, int, int, cv::Rect>> {};
+TEST_P(ThresholdFloatRoiTest, Test)
+{
+    int type = -1, width = 0, tt = -1;
+    cv::Rect roi;
+    std::tie(type, width, tt, roi) = GetParam();
+
+    cv::Size sz_in = { width, 24 };
+    cv::Mat in_mat(sz_in, type);
+    cv::randu(in_mat, cv::Scalar::all(-100.0), cv::Scalar::all(100.0));
+    in_mat.row(0).setTo(cv::Scalar::all(12.5)); // equal to the threshold
+
+    const cv::Scalar thresh(12.5), maxval(42.25);
+
+    cv::GMat in;
+    cv::GScalar th, mv;
+    cv::GMat out = cv::gapi::threshold(in, th, mv, tt);
+    cv::GComputation c(GIn(in, th, mv), GOut(out));
+
+    // ROIs are given in rows, they take the whole width of the image
+    if (roi == cv::Rect{}) roi = cv::Rect{0,0,sz_in.width,sz_in.height};
+    roi.width = sz_in.width;
+
+    Mat out_mat_gapi = Mat::zeros(sz_in, type);
+    auto cc = c.compile(descr_of(in_mat), descr_of(thresh), descr_of(maxval),
+                        cv::compile_args(cv::gapi::core::fluid::kernels(), GFluidOutputRois{{roi}}));
+    cc(gin(in_mat, thresh, maxval), gout(out_mat_gapi));
+
+    cv::Mat out_mat_ocv = Mat::zeros(sz_in, type);
+    cv::Mat out_roi_ocv = out_mat_ocv(roi);
+    cv::threshold(in_mat(roi), out_roi_ocv, thresh[0], maxval[0], tt);
+
+    EXPECT_EQ(0, cvtest::norm(out_mat_ocv, out_mat_gapi, NORM_INF));
+}
+
+INSTANTIATE_TEST_CASE_P(FluidRoi, ThresholdFloatRoiTest,
+                        Combine(Values(CV_32FC1, CV_32FC3),
+                                Values(1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33, 67),
+                                Values(cv::THRESH_BINARY, cv::THRESH_BINARY_INV,
+                                       cv::THRESH_TRUNC,
+                                       cv::THRESH_TOZERO, cv::THRESH_TOZERO_INV),
+                                Values(cv::Rect{}, cv::Rect{0,0,0,10}, cv::Rect{0,7,0,9}, cv::Rect{0,20,0,4})));
+
 } // namespace opencv_test
@@ -0,0 +1,199 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+
+#include "../test_precomp.hpp"
+
+#include <opencv2/gapi/cpu/core.hpp>
+#include <opencv2/gapi/cpu/imgproc.hpp>
+
+#include "compiler/gmodel.hpp"
+#include "compiler/gcompiler.hpp"
+#include "compiler/passes/buffer_reuse.hpp"
+
+namespace opencv_test {
+
+namespace {
+
+// In-place execution is allowed for all the kernels unless it is disabled
+cv::gimpl::BufferReuse reuseBuffersOf(cv::GComputation &c, const cv::GMatDesc &in_desc,
+                                      bool inplace_kernels = true)
+{
+    cv::gimpl::GCompiler compiler(c, {cv::GMetaArg(in_desc)},
+                                  cv::compile_args(cv::gapi::combine(cv::gapi::core::cpu::kernels(),
+                                                                     cv::gapi::imgproc::cpu::kernels())));
+    cv::gimpl::GCompiler::GPtr graph = compiler.generateGraph();
+    compiler.runPasses(*graph);
+
+    // All the operations are CPU ones, so it is the single Island
+    cv::gimpl::GModel::ConstGraph gm(*graph);
+    std::vector<ade::NodeHandle> ops;
+    for (const auto &nh : gm.metadata().get<ade::passes::TopologicalSortData>().nodes())
+    {
+        if (gm.metadata(nh).get<cv::gimpl::NodeType>().t == cv::gimpl::NodeType::OP)
+        {
+            ops.push_back(nh);
+        }
+    }
+    if (!inplace_kernels)
+    {
+        return cv::gimpl::passes::reuseBuffers(*graph, ops);
+    }
+    return cv::gimpl::passes::reuseBuffers(*graph, ops, [](const ade::NodeHandle &) { return true; });
+}
+
+// Writes its output before reading inputs, so it doesn't support in-place execution
+GAPI_OCV_KERNEL(NonInplaceAdd, cv::gapi::core::GAdd)
+{
+    static void run(const cv::Mat &a, const cv::Mat &b, int dtype, cv::Mat &out)
+    {
+        GAPI_Assert(dtype == -1);
+        out.setTo(cv::Scalar::all(0));
+        cv::add(out, a, out);
+        cv::add(out, b, out);
+    }
+};
+
+} // anonymous namespace
+
+TEST(BufferReuse, InplaceChainUsesSingleBuffer)
+{
+    cv::GMat in;
+    cv::GMat out = in;
+    for (int i = 0; i < 10; i++)
+    {
+        out = cv::gapi::bitwise_not(out);
+    }
+    cv::GComputation c(in, out);
+
+    const auto reuse = reuseBuffersOf(c, cv::GMatDesc{CV_8U, 1, cv::Size(32, 32)});
+    EXPECT_EQ(9u, reuse.buffer_of.size()); // the last one is the graph output
+    EXPECT_EQ(1u, reuse.buffers.size());
+}
+
+TEST(BufferReuse, InplaceIsOptIn)
+{
+    cv::GMat in;
+    cv::GMat out = in;
+    for (int i = 0; i < 10; i++)
+    {
+        out = cv::gapi::bitwise_not(out);
+    }
+    cv::GComputation c(in, out);
+
+    // without confirmation of the backend in-place operations are regular ones
+    const auto reuse = reuseBuffersOf(c, cv::GMatDesc{CV_8U, 1, cv::Size(32, 32)}, false);
+    EXPECT_EQ(9u, reuse.buffer_of.size());
+    EXPECT_EQ(2u, reuse.buffers.size());
+}
+
+TEST(BufferReuse, ChainUsesTwoBuffers)
+{
+    cv::GMat in;
+    cv::GMat out = in;
+    for (int i = 0; i < 10; i++)
+    {
+        out = cv::gapi::blur(out, cv::Size(3, 3));
+    }
+    cv::GComputation c(in, out);
+
+    const auto reuse = reuseBuffersOf(c, cv::GMatDesc{CV_8U, 1, cv::Size(32, 32)});
+    EXPECT_EQ(9u, reuse.buffer_of.size());
+    EXPECT_EQ(2u, reuse.buffers.size());
+}
+
+TEST(BufferReuse, LongLivedObjectKeepsBuffer)
+{
+    cv::GMat in;
+    cv::GMat a = cv::gapi::bitwise_not(in);
+    cv::GMat b = cv::gapi::blur(a, cv::Size(3, 3));
+    cv::GMat c = cv::gapi::blur(b, cv::Size(3, 3));
+    cv::GMat d = cv::gapi::blur(c, cv::Size(3, 3));
+    cv::GMat out = cv::gapi::add(a, d);
+    cv::GComputation comp(in, out);
+
+    const auto reuse = reuseBuffersOf(comp, cv::GMatDesc{CV_8U, 1, cv::Size(32, 32)});
+    ASSERT_EQ(4u, reuse.buffer_of.size());
+    // `a` lives until the end, b and d may share memory
+    EXPECT_EQ(3u, reuse.buffers.size());
+}
+
+TEST(BufferReuse, DifferentFormatsDontShare)
+{
+    cv::GMat in;
+    cv::GMat a = cv::gapi::bitwise_not(in);
+    cv::GMat b = cv::gapi::resize(a, cv::Size(16, 16));
+    cv::GMat c = cv::gapi::bitwise_not(b);
+    cv::GMat d = cv::gapi::resize(c, cv::Size(32, 32));
+    cv::GMat out = cv::gapi::bitwise_not(d);
+    cv::GComputation comp(in, out);
+
+    const auto reuse = reuseBuffersOf(comp, cv::GMatDesc{CV_8U, 1, cv::Size(32, 32)});
+    ASSERT_EQ(4u, reuse.buffer_of.size());
+    ASSERT_EQ(2u, reuse.buffers.size());
+    EXPECT_EQ(cv::Size(32, 32), reuse.buffers[0].size);
+    EXPECT_EQ(cv::Size(16, 16), reuse.buffers[1].size);
+}
+
+TEST(BufferReuse, Accuracy)
+{
+    cv::Mat in_mat(cv::Size(64, 48), CV_8UC3);
+    cv::randu(in_mat, cv::Scalar::all(0), cv::Scalar::all(255));
+
+    // Mix of in-place and regular operations with branches
+    cv::GMat in;
+    cv::GMat rgb   = cv::gapi::BGR2RGB(in);
+    cv::GMat yuv   = cv::gapi::RGB2YUV(rgb);
+    cv::GMat blr   = cv::gapi::blur(yuv, cv::Size(3, 3));
+    cv::GMat inv   = cv::gapi::bitwise_not(blr);
+    cv::GMat sum   = cv::gapi::add(inv, rgb);
+    cv::GMat diff  = cv::gapi::absDiff(sum, blr);
+    cv::GMat bgr   = cv::gapi::YUV2RGB(diff);
+    cv::GMat out   = cv::gapi::addC(bgr, cv::Scalar::all(3));
+    cv::GComputation c(in, out);
+
+    cv::Mat out_mat;
+    c.apply(in_mat, out_mat, cv::compile_args(cv::gapi::combine(cv::gapi::core::cpu::kernels(),
+                                                                cv::gapi::imgproc::cpu::kernels())));
+
+    cv::Mat ref_rgb, ref_yuv, ref_blr, ref_inv, ref_sum, ref_diff, ref_bgr, ref_out;
+    cv::cvtColor(in_mat, ref_rgb, cv::COLOR_BGR2RGB);
+    cv::cvtColor(ref_rgb, ref_yuv, cv::COLOR_RGB2YUV);
+    cv::blur(ref_yuv, ref_blr, cv::Size(3, 3));
+    cv::bitwise_not(ref_blr, ref_inv);
+    cv::add(ref_inv, ref_rgb, ref_sum);
+    cv::absdiff(ref_sum, ref_blr, ref_diff);
+    cv::cvtColor(ref_diff, ref_bgr, cv::COLOR_YUV2RGB);
+    cv::add(ref_bgr, cv::Scalar::all(3), ref_out);
+
+    EXPECT_EQ(0, cvtest::norm(ref_out, out_mat, NORM_INF));
+}
+
+TEST(BufferReuse, UserKernelIsNotInplace)
+{
+    cv::Mat in_mat(cv::Size(64, 48), CV_8UC1);
+    cv::randu(in_mat, cv::Scalar::all(0), cv::Scalar::all(100));
+
+    // The builtin kernel of add() would take the buffer of `a`, the user one can't
+    cv::GMat in;
+    cv::GMat a   = cv::gapi::bitwise_not(in);
+    cv::GMat b   = cv::gapi::addC(in, cv::Scalar::all(7));
+    cv::GMat sum = cv::gapi::add(a, b);
+    cv::GMat out = cv::gapi::bitwise_not(sum);
+    cv::GComputation c(in, out);
+
+    cv::Mat out_mat;
+    c.apply(in_mat, out_mat, cv::compile_args(cv::gapi::combine(cv::gapi::core::cpu::kernels(),
+                                                                cv::gapi::kernels<NonInplaceAdd>())));
+
+    cv::Mat ref_a, ref_b, ref_sum, ref_out;
+    cv::bitwise_not(in_mat, ref_a);
+    cv::add(in_mat, cv::Scalar::all(7), ref_b);
+    cv::add(ref_a, ref_b, ref_sum);
+    cv::bitwise_not(ref_sum, ref_out);
+
+    EXPECT_EQ(0, cvtest::norm(ref_out, out_mat, NORM_INF));
+}
+
+} // namespace opencv_test
@@ -0,0 +1,219 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../test_precomp.hpp"
+
+#include <unordered_set>
+#include <thread>
+
+#include "executor/lockfree_queue.hpp"
+
+namespace opencv_test
+{
+using namespace cv::gapi;
+
+TEST(LockFreeQueue, PushPop)
+{
+    own::lockfree_bounded_queue<int> q;
+    q.set_capacity(100u);
+    for (int i = 0; i < 100; i++)
+    {
+        q.push(i);
+    }
+
+    for (int i = 0; i < 100; i++)
+    {
+        int x;
+        q.pop(x);
+        EXPECT_EQ(i, x);
+    }
+}
+
+TEST(LockFreeQueue, TryPop)
+{
+    own::lockfree_bounded_queue<int> q;
+    q.set_capacity(1u);
+    int x = 0;
+    EXPECT_FALSE(q.try_pop(x));
+
+    q.push(1);
+    EXPECT_TRUE(q.try_pop(x));
+    EXPECT_EQ(1, x);
+}
+
+TEST(LockFreeQueue, Clear)
+{
+    own::lockfree_bounded_queue<int> q;
+    q.set_capacity(10u);
+    for (int i = 0; i < 10; i++)
+    {
+        q.push(i);
+    }
+
+    q.clear();
+    int x = 0;
+    EXPECT_FALSE(q.try_pop(x));
+
+    // The queue is usable after clear()
+    q.push(42);
+    EXPECT_TRUE(q.try_pop(x));
+    EXPECT_EQ(42, x);
+}
+
+TEST(LockFreeQueue, WrapAround)
+{
+    own::lockfree_bounded_queue<int> q;
+    q.set_capacity(3u);
+    for (int i = 0; i < 100; i++)
+    {
+        q.push(i);
+        q.push(i + 1000);
+        int x = 0;
+        q.pop(x);
+        EXPECT_EQ(i, x);
+        q.pop(x);
+        EXPECT_EQ(i + 1000, x);
+    }
+}
+
+TEST(LockFreeQueue, PushBlocksWhenFull)
+{
+    own::lockfree_bounded_queue<int> q;
+    q.set_capacity(2u);
+    q.push(0);
+    q.push(1);
+
+    std::thread writer([&q](){ q.push(2); });
+    for (int i = 0; i < 3; i++)
+    {
+        int x = -1;
+        q.pop(x);
+        EXPECT_EQ(i, x);
+    }
+    writer.join();
+}
+
+TEST(LockFreeQueue, Copy)
+{
+    own::lockfree_bounded_queue<int> q;
+    q.set_capacity(4u);
+    q.push(1);
+    q.push(2);
+
+    own::lockfree_bounded_queue<int> c(q);
+    int x = 0;
+    c.pop(x);
+    EXPECT_EQ(1, x);
+    c.pop(x);
+    EXPECT_EQ(2, x);
+    EXPECT_FALSE(c.try_pop(x));
+
+    // The original queue is not affected
+    q.pop(x);
+    EXPECT_EQ(1, x);
+}
+
+// See ConcQueue_ test for the detailed description of this scenario
+namespace
+{
+using StressParam = std::tuple<int           // Num writer threads
+                              ,int           // Num elements per writer
+                              ,int           // Num reader threads
+                              ,std::size_t>; // Queue capacity
+constexpr int STOP_SIGN = -1;
+constexpr int BASE      = 1000;
+}
+struct LockFreeQueue_: public ::testing::TestWithParam<StressParam>
+{
+    using Q = own::lockfree_bounded_queue<int>;
+    using S = std::unordered_set<int>;
+
+    static void writer(int base, int writes, Q& q)
+    {
+        for (int i = 0; i < writes; i++)
+        {
+            q.push(base + i);
+        }
+        q.push(STOP_SIGN);
+    }
+
+    static void reader(Q& q, S& s)
+    {
+        int x = 0;
+        while (true)
+        {
+            q.pop(x);
+            if (x == STOP_SIGN) return;
+            s.insert(x);
+        }
+    }
+};
+
+TEST_P(LockFreeQueue_, Test)
+{
+    int num_writers = 0;
+    int num_writes  = 0;
+    int num_readers = 0;
+    std::size_t capacity = 0u;
+    std::tie(num_writers, num_writes, num_readers, capacity) = GetParam();
+
+    CV_Assert(num_writers <   20);
+    CV_Assert(num_writes  < BASE);
+    CV_Assert(static_cast<int>(capacity) > (num_writers - num_readers));
+
+    Q q;
+    q.set_capacity(capacity);
+
+    std::vector<S> storage(num_readers);
+    std::vector<std::thread> readers;
+    for (S& s : storage)
+    {
+        readers.emplace_back(reader, std::ref(q), std::ref(s));
+    }
+
+    S reference;
+    std::vector<std::thread> writers;
+    for (int w = 0; w < num_writers; w++)
+    {
+        writers.emplace_back(writer, w*BASE, num_writes, std::ref(q));
+        for (int r = 0; r < num_writes; r++)
+        {
+            reference.insert(w*BASE + r);
+        }
+    }
+
+    S remnants;
+    if (num_writers > num_readers)
+    {
+        int extra = num_writers - num_readers;
+        while (extra)
+        {
+            int x = 0;
+            q.pop(x);
+            if (x == STOP_SIGN) extra--;
+            else remnants.insert(x);
+        }
+    }
+
+    if (num_readers > num_writers)
+    {
+        int extra = num_readers - num_writers;
+        while (extra--) q.push(STOP_SIGN);
+    }
+
+    for (auto &t : readers) t.join();
+    for (auto &t : writers) t.join();
+
+    S result(remnants.begin(), remnants.end());
+    for (const auto &s : storage) result.insert(s.begin(), s.end());
+
+    EXPECT_EQ(reference, result);
+}
+
+INSTANTIATE_TEST_CASE_P(LockFreeQueueStress, LockFreeQueue_,
+                        Combine(  Values(1, 2, 4, 8, 16)     // writers
+                                , Values(1, 32, 96, 256)     // writes
+                                , Values(1, 2, 10)           // readers
+                                , Values(17u, 32u)));        // capacity
+} // namespace opencv_test
@@ -2681,4 +2681,152 @@ TEST(GAPI_Streaming_Exception, SourceThrowEverySecondFrame) {
     EXPECT_EQ(num_frames, curr_frame - 1);
 }
 
+namespace {
+class CountingSource : public cv::gapi::wip::IStreamSource {
+public:
+    explicit CountingSource(const int num_frames)
+        : m_num_frames(num_frames), m_curr_frame_id(0) {
+    }
+
+    bool pull(cv::gapi::wip::Data& d) override {
+        if (m_curr_frame_id == m_num_frames) {
+            return false;
+        }
+        d = cv::Mat(4, 4, CV_8UC1, cv::Scalar(m_curr_frame_id++ % 256));
+        return true;
+    }
+
+    cv::GMetaArg descr_of() const override {
+        return cv::GMetaArg{cv::GMatDesc{CV_8U, 1, cv::Size(4, 4)}};
+    }
+
+private:
+    int m_num_frames;
+    int m_curr_frame_id;
+};
+} // anonymous namespace
+
+TEST(GAPI_Streaming, LockFreeQueues) {
+    constexpr int num_frames = 200;
+    constexpr int num_steps  = 4;
+
+    // Every step is a separate island, so data goes through the queues on every edge
+    cv::GMat in;
+    cv::GMat out = in;
+    for (int i = 0; i < num_steps; i++) {
+        cv::GMat step_in = out;
+        out = cv::gapi::addC(step_in, cv::Scalar(1));
+        cv::gapi::island("step" + std::to_string(i), cv::GIn(step_in), cv::GOut(out));
+    }
+
+    auto pipeline = cv::GComputation(in, out).compileStreaming(
+        cv::compile_args(cv::gapi::core::cpu::kernels(),
+                         cv::gapi::streaming::queue_capacity{2u},
+                         cv::gapi::streaming::queue_kind::lock_free));
+    pipeline.setSource(std::make_shared<CountingSource>(num_frames));
+    pipeline.start();
+
+    cv::Mat out_mat;
+    int frames = 0;
+    while (pipeline.pull(cv::gout(out_mat))) {
+        const cv::Mat ref(4, 4, CV_8UC1, cv::Scalar(frames % 256 + num_steps));
+        EXPECT_EQ(0., cv::norm(ref, out_mat, cv::NORM_INF));
+        frames++;
+    }
+    EXPECT_EQ(num_frames, frames);
+}
+
+TEST(GAPI_Streaming, LatencyBoundDropsFrames) {
+    constexpr int num_frames = 100;
+
+    // The source is much faster than the pipeline
+    cv::GMat in;
+    cv::GMat out = Delay::on(in, 5);
+    auto pipeline = cv::GComputation(in, out).compileStreaming(
+        cv::compile_args(cv::gapi::kernels<OCVDelay>(),
+                         cv::gapi::streaming::latency_bound{1u}));
+    pipeline.setSource(std::make_shared<CountingSource>(num_frames));
+    pipeline.start();
+
+    cv::Mat out_mat;
+    std::size_t frames = 0u;
+    int last_value = -1;
+    while (pipeline.pull(cv::gout(out_mat))) {
+        // Frames may be dropped but never reordered
+        const int value = out_mat.at<uchar>(0, 0);
+        EXPECT_LT(last_value, value);
+        last_value = value;
+        frames++;
+    }
+
+    const auto stats = pipeline.latencyStats();
+    ASSERT_EQ(1u, stats.emitted.size());
+    ASSERT_EQ(1u, stats.dropped.size());
+    EXPECT_EQ(frames, stats.emitted[0]);
+    EXPECT_EQ(static_cast<std::size_t>(num_frames), stats.emitted[0] + stats.dropped[0]);
+    EXPECT_LT(0u, stats.dropped[0]);
+}
+
+TEST(GAPI_Streaming, LatencyBoundWithConstInput) {
+    constexpr int num_frames = 50;
+
+    cv::GMat in;
+    cv::GScalar s;
+    cv::GMat out = cv::gapi::addC(Delay::on(in, 1), s);
+    auto pipeline = cv::GComputation(cv::GIn(in, s), cv::GOut(out)).compileStreaming(
+        cv::compile_args(cv::gapi::combine(cv::gapi::kernels<OCVDelay>(),
+                                           cv::gapi::core::cpu::kernels()),
+                         cv::gapi::streaming::latency_bound{2u}));
+    pipeline.setSource(cv::gin(cv::gapi::wip::make_src<CountingSource>(num_frames),
+                               cv::Scalar(1)));
+    pipeline.start();
+
+    cv::Mat out_mat;
+    std::size_t frames = 0u;
+    while (pipeline.pull(cv::gout(out_mat))) {
+        frames++;
+    }
+
+    const auto stats = pipeline.latencyStats();
+    ASSERT_EQ(2u, stats.emitted.size());
+    EXPECT_EQ(frames, stats.emitted[0]);
+    EXPECT_EQ(static_cast<std::size_t>(num_frames), stats.emitted[0] + stats.dropped[0]);
+    // Constant inputs are never dropped
+    EXPECT_EQ(0u, stats.emitted[1]);
+    EXPECT_EQ(0u, stats.dropped[1]);
+}
+
+TEST(GAPI_Streaming, NoLatencyStatsByDefault) {
+    cv::GMat in;
+    auto pipeline = cv::GComputation(in, cv::gapi::copy(in)).compileStreaming();
+    pipeline.setSource(std::make_shared<CountingSource>(10));
+    pipeline.start();
+
+    cv::Mat out_mat;
+    int frames = 0;
+    while (pipeline.pull(cv::gout(out_mat))) {
+        frames++;
+    }
+    EXPECT_EQ(10, frames);
+    EXPECT_TRUE(pipeline.latencyStats().emitted.empty());
+    EXPECT_TRUE(pipeline.latencyStats().dropped.empty());
+}
+
+TEST(GAPI_Streaming, LatencyBoundCantBeUsedWithSyncDrop) {
+    cv::GMat in1, in2;
+    cv::GComputation comp(cv::GIn(in1, in2), cv::GOut(cv::gapi::add(in1, in2)));
+    EXPECT_ANY_THROW(comp.compileStreaming(
+        cv::compile_args(cv::gapi::core::cpu::kernels(),
+                         cv::gapi::streaming::sync_policy::drop,
+                         cv::gapi::streaming::latency_bound{1u})));
+}
+
+TEST(GAPI_Streaming, LatencyBoundRejectsZeroFrames) {
+    cv::GMat in;
+    cv::GComputation comp(cv::GIn(in), cv::GOut(cv::gapi::bitwise_not(in)));
+    EXPECT_THROW(comp.compileStreaming(
+        cv::compile_args(cv::gapi::core::cpu::kernels(),
+                         cv::gapi::streaming::latency_bound{0u})), std::logic_error);
+}
+
 } // namespace opencv_test